@@ -0,0 +1,714 @@
+/**
+ *      @file  bench.cpp
+ *     @brief  program mierzący wydajność weryfikacji izomorfizmu
+ *
+ * Detailed description starts here.
+ *
+ * Przegląd rodzin grafów (\ref GraphFamily), liczby wierzchołków, gęstości
+ * i rodzaju pary (izomorficzna lub nie). Każdy przypadek to kilka instancji
+ * o stałych
+ * ziarnach poprzedzonych rozgrzewką; wynikiem jest mediana i 95. percentyl
+ * czasu w formacie CSV lub JSON. Wynik można porównać z zapisanym
+ * wcześniej plikiem CSV (linia bazowa) i wykryć regresje wydajności.
+ *
+ *=====================================================================================
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "graph.hpp"
+#include "frozenGraph.hpp"
+#include "isoEngine.hpp"
+#include "searchLimits.hpp"
+#include "canonicalForm.hpp"
+#include "utils.hpp"
+#include "randomEngine.hpp"
+#include "graphFamilies.hpp"
+
+/**
+ * @brief różnica median (w sekundach) poniżej której nie zgłaszamy regresji
+ * - szum pomiaru bardzo krótkich przebiegów
+ */
+#define BENCH_NOISE_FLOOR 1e-4
+
+using namespace std;
+
+typedef Graph::label_t label_t;
+
+/**
+ * @brief ustawienia przeglądu
+ */
+struct BenchOptions
+{
+    BenchOptions(): engine(ENGINE_BACKTRACK), threads(1), repeat(7),
+        warmup(2), seed(12345), timeout(2.0), format("csv"),
+        tolerance(0.2)
+    {
+        families.push_back(FAMILY_RANDOM);
+        families.push_back(FAMILY_REGULAR);
+        families.push_back(FAMILY_GRID);
+        families.push_back(FAMILY_CFI);
+        pairs.push_back(true);
+        pairs.push_back(false);
+        sizes.push_back(50);
+        sizes.push_back(100);
+        sizes.push_back(200);
+        densities.push_back(0.05);
+        densities.push_back(0.2);
+    };
+
+    /**
+     * @brief rodziny grafów
+     */
+    vector<GraphFamily> families;
+
+    /**
+     * @brief rodzaje par: izomorficzne (true) i nieizomorficzne (false)
+     */
+    vector<bool> pairs;
+
+    /**
+     * @brief liczby wierzchołków
+     */
+    vector<unsigned int> sizes;
+
+    /**
+     * @brief gęstości (tylko rodziny random i regular)
+     */
+    vector<double> densities;
+
+    /**
+     * @brief silnik weryfikacji
+     */
+    IsoEngine engine;
+
+    /**
+     * @brief liczba wątków silnika bt
+     */
+    unsigned int threads;
+
+    /**
+     * @brief liczba mierzonych instancji na przypadek
+     */
+    unsigned int repeat;
+
+    /**
+     * @brief liczba niemierzonych przebiegów rozgrzewających
+     */
+    unsigned int warmup;
+
+    /**
+     * @brief ziarno bazowe
+     */
+    unsigned int seed;
+
+    /**
+     * @brief limit czasu jednej weryfikacji w sekundach (0 - bez limitu);
+     * przerwana weryfikacja liczy się do statystyk z czasem limitu
+     */
+    double timeout;
+
+    /**
+     * @brief format wyjścia: csv lub json
+     */
+    string format;
+
+    /**
+     * @brief plik wyjściowy (pusty - standardowe wyjście)
+     */
+    string output;
+
+    /**
+     * @brief plik CSV z linią bazową (pusty - bez porównania)
+     */
+    string baseline;
+
+    /**
+     * @brief dopuszczalny względny wzrost mediany względem linii bazowej
+     */
+    double tolerance;
+};
+
+/**
+ * @brief wynik jednego przypadku przeglądu
+ */
+struct BenchResult
+{
+    string family;
+    unsigned int size;
+    double density;
+    unsigned int vertices;
+    unsigned int edges;
+    bool expected;
+    vector<double> times;
+    vector<unsigned long long> nodes;
+    unsigned int timeouts;
+    unsigned int wrong;
+    double median;
+    double p95;
+};
+
+/**
+ * @brief instancja: para grafów i oczekiwany wynik
+ */
+struct BenchPair
+{
+    FrozenGraph fX;
+    FrozenGraph fY;
+    bool isomorphic;
+};
+
+/**
+ * @brief wypisz wiadomość pomocniczą
+ */
+void benchHelp()
+{
+    cerr << "BENCH [--FLAGA=WARTOŚĆ ...]" << endl
+        << "    --families=random,regular,grid,cfi   rodziny grafów (także srg," << endl
+        << "                                         miyazaki, tournament)" << endl
+        << "    --pairs=iso,noniso                   rodzaje par" << endl
+        << "    --sizes=50,100,200                   liczby wierzchołków" << endl
+        << "    --densities=0.05,0.2                 gęstości (random, regular)" << endl
+        << "    --engine=<bt|vf2pp>                  silnik weryfikacji" << endl
+        << "    --threads=<N>                        wątki silnika bt" << endl
+        << "    --repeat=<N>                         mierzone instancje na przypadek" << endl
+        << "    --warmup=<N>                         przebiegi rozgrzewające" << endl
+        << "    --seed=<N>                           ziarno bazowe" << endl
+        << "    --timeout=<sekundy>                  limit jednej weryfikacji" << endl
+        << "    --format=<csv|json>                  format wyniku" << endl
+        << "    --output=<plik>                      plik wyniku (domyślnie stdout)" << endl
+        << "    --baseline=<plik csv>                porównaj z linią bazową" << endl
+        << "    --tolerance=<ułamek>                 dopuszczalny wzrost mediany" << endl;
+}
+
+/**
+ * @brief generator liczb losowych dla przypadku i instancji
+ *
+ * Ziarno zależy od ziarna bazowego, parametrów przypadku i numeru instancji,
+ * a nie od kolejności przypadków - zmiana zakresu przeglądu nie zmienia
+ * pozostałych instancji.
+ *
+ * @param seed ziarno bazowe
+ * @param family rodzina
+ * @param size liczba wierzchołków
+ * @param density gęstość
+ * @param isomorphic rodzaj pary
+ * @param instance numer instancji
+ *
+ * @return generator
+ */
+RandomEngine caseGenerator(unsigned int seed, const string &family,
+        unsigned int size, double density, bool isomorphic,
+        unsigned int instance)
+{
+    vector<unsigned int> words(1, seed);
+    words.insert(words.end(), family.begin(), family.end());
+    words.push_back(size);
+    words.push_back((unsigned int) (density * 1e6 + 0.5));
+    words.push_back(isomorphic ? 1 : 0);
+    words.push_back(instance);
+    return RandomEngine(CanonicalForm::hashWords(words));
+}
+
+/**
+ * @brief wygeneruj instancję
+ *
+ * @param family rodzina
+ * @param size liczba wierzchołków
+ * @param density gęstość
+ * @param isomorphic rodzaj pary
+ * @param gen generator
+ * @param pair wynik
+ *
+ * @return czy rodzina ma pary tego rodzaju
+ */
+bool generatePair(GraphFamily family, unsigned int size, double density,
+        bool isomorphic, RandomEngine &gen, BenchPair &pair)
+{
+    pair.isomorphic = isomorphic;
+    if (family == FAMILY_RANDOM && isomorphic) {
+        // bez list sąsiedztwa - pozwala mierzyć bardzo duże grafy
+        pair.fX = FrozenGraph::generateRandom(size, density, gen);
+        pair.fY = pair.fX.randomIsomorphic(gen);
+        return true;
+    }
+
+    Graph gX, gY;
+    if (!generateFamilyPair(family, size, density, isomorphic, gen, gX, gY)) {
+        return false;
+    }
+    pair.fX.freeze(gX);
+    pair.fY.freeze(gY);
+    return true;
+}
+
+/**
+ * @brief zmierz jedną weryfikację
+ *
+ * @param pair instancja
+ * @param options ustawienia
+ * @param result wynik przypadku (uzupełniany gdy measured)
+ * @param measured czy zapisać pomiar
+ */
+void runPair(const BenchPair &pair, const BenchOptions &options,
+        BenchResult &result, bool measured)
+{
+    using std::chrono::steady_clock;
+
+    SearchLimits limits;
+    if (options.timeout > 0.0) {
+        limits.setTimeout(options.timeout);
+    }
+
+    IsomorphismAlgo::iso_map f;
+    SearchStats stats;
+    steady_clock::time_point start = steady_clock::now();
+    IsoResult iso = isIsomorphic(pair.fX, pair.fY, options.engine, limits, f, stats,
+            options.threads);
+    double seconds = elapsedSeconds(start);
+
+    if (!measured) {
+        return;
+    }
+    result.times.push_back(seconds);
+    result.nodes.push_back(stats.nodes);
+    if (iso == ISO_UNKNOWN) {
+        ++result.timeouts;
+    }
+    else if ((iso == ISO_ISOMORPHIC) != pair.isomorphic) {
+        ++result.wrong;
+    }
+}
+
+/**
+ * @brief percentyl metodą najbliższej pozycji
+ *
+ * @param sorted posortowane wartości
+ * @param p percentyl z przedziału (0, 1]
+ *
+ * @return wartość percentyla
+ */
+double percentile(const vector<double> &sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = (size_t) ceil(p * sorted.size());
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+ * @brief mediana
+ *
+ * @param sorted posortowane wartości
+ *
+ * @return mediana
+ */
+double median(const vector<double> &sorted)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t mid = sorted.size() / 2;
+    if (sorted.size() % 2 == 0) {
+        return (sorted[mid - 1] + sorted[mid]) / 2.0;
+    }
+    return sorted[mid];
+}
+
+/**
+ * @brief wykonaj przypadek: rozgrzewka i mierzone instancje
+ *
+ * @param family rodzina
+ * @param size liczba wierzchołków
+ * @param density gęstość
+ * @param isomorphic rodzaj pary
+ * @param options ustawienia
+ * @param result wynik przypadku
+ *
+ * @return czy udało się wygenerować instancje
+ */
+bool runCase(GraphFamily family, unsigned int size, double density,
+        bool isomorphic, const BenchOptions &options, BenchResult &result)
+{
+    result.family = familyName(family);
+    result.size = size;
+    result.density = density;
+    result.expected = isomorphic;
+    result.timeouts = 0;
+    result.wrong = 0;
+
+    BenchPair pair;
+    for(unsigned int w = 0; w < options.warmup; ++w) {
+        RandomEngine gen = caseGenerator(options.seed, result.family, size,
+                density, isomorphic, 0);
+        if (!generatePair(family, size, density, isomorphic, gen, pair)) {
+            return false;
+        }
+        runPair(pair, options, result, false);
+    }
+
+    for(unsigned int r = 0; r < options.repeat; ++r) {
+        RandomEngine gen = caseGenerator(options.seed, result.family, size,
+                density, isomorphic, r);
+        if (!generatePair(family, size, density, isomorphic, gen, pair)) {
+            return false;
+        }
+        runPair(pair, options, result, true);
+        result.vertices = pair.fX.getVertexCount();
+        result.edges = pair.fX.getEdgeCount();
+    }
+
+    vector<double> sorted(result.times);
+    sort(sorted.begin(), sorted.end());
+    result.median = median(sorted);
+    result.p95 = percentile(sorted, 0.95);
+    return true;
+}
+
+/**
+ * @brief klucz przypadku do porównania z linią bazową
+ *
+ * @param family rodzina
+ * @param size liczba wierzchołków
+ * @param density gęstość
+ * @param expected rodzaj pary (iso lub noniso)
+ *
+ * @return klucz
+ */
+string caseKey(const string &family, unsigned int size, double density,
+        const string &expected)
+{
+    stringstream ss;
+    ss << family << "/" << size << "/" << density << "/" << expected;
+    return ss.str();
+}
+
+/**
+ * @brief zapisz wyniki w formacie CSV
+ *
+ * @param out strumień
+ * @param results wyniki
+ * @param options ustawienia
+ */
+void writeCsv(ostream &out, const vector<BenchResult> &results,
+        const BenchOptions &options)
+{
+    out << "family,size,density,vertices,edges,expected,engine,threads,runs,"
+        "median_s,p95_s,min_s,max_s,median_nodes,timeouts,wrong" << endl;
+    for(size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &r = results[i];
+        vector<unsigned long long> nodes(r.nodes);
+        sort(nodes.begin(), nodes.end());
+        out << r.family << "," << r.size << "," << r.density << ","
+            << r.vertices << "," << r.edges << ","
+            << (r.expected ? "iso" : "noniso") << ","
+            << engineName(options.engine) << "," << options.threads << ","
+            << r.times.size() << "," << r.median << "," << r.p95 << ","
+            << *min_element(r.times.begin(), r.times.end()) << ","
+            << *max_element(r.times.begin(), r.times.end()) << ","
+            << nodes[nodes.size() / 2] << "," << r.timeouts << "," << r.wrong
+            << endl;
+    }
+}
+
+/**
+ * @brief zapisz wyniki w formacie JSON
+ *
+ * @param out strumień
+ * @param results wyniki
+ * @param options ustawienia
+ */
+void writeJson(ostream &out, const vector<BenchResult> &results,
+        const BenchOptions &options)
+{
+    out << "{" << endl;
+    out << "  \"seed\": " << options.seed << "," << endl;
+    out << "  \"engine\": \"" << engineName(options.engine) << "\"," << endl;
+    out << "  \"threads\": " << options.threads << "," << endl;
+    out << "  \"warmup\": " << options.warmup << "," << endl;
+    out << "  \"results\": [" << endl;
+    for(size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &r = results[i];
+        out << "    {\"family\": \"" << r.family << "\", \"size\": " << r.size
+            << ", \"density\": " << r.density
+            << ", \"vertices\": " << r.vertices << ", \"edges\": " << r.edges
+            << ", \"expected\": \"" << (r.expected ? "iso" : "noniso") << "\""
+            << ", \"median_s\": " << r.median << ", \"p95_s\": " << r.p95
+            << ", \"timeouts\": " << r.timeouts << ", \"wrong\": " << r.wrong
+            << ", \"times_s\": [";
+        for(size_t t = 0; t < r.times.size(); ++t) {
+            out << (t ? ", " : "") << r.times[t];
+        }
+        out << "], \"nodes\": [";
+        for(size_t t = 0; t < r.nodes.size(); ++t) {
+            out << (t ? ", " : "") << r.nodes[t];
+        }
+        out << "]}" << (i + 1 < results.size() ? "," : "") << endl;
+    }
+    out << "  ]" << endl;
+    out << "}" << endl;
+}
+
+/**
+ * @brief porównaj mediany z linią bazową (CSV z tego programu)
+ *
+ * @param results wyniki
+ * @param options ustawienia
+ *
+ * @return liczba regresji
+ */
+unsigned int compareBaseline(const vector<BenchResult> &results,
+        const BenchOptions &options)
+{
+    ifstream file(options.baseline.c_str());
+    if (!file.is_open()) {
+        cerr << "BŁĄD: nie udało się otworzyć linii bazowej `"
+            << options.baseline << "'" << endl;
+        exit(1);
+    }
+
+    map<string, double> base;
+    string line;
+    getline(file, line);
+    while (getline(file, line)) {
+        vector<string> cols = split(line, ',');
+        if (cols.size() < 10) {
+            continue;
+        }
+        base[caseKey(cols[0], atoi(cols[1].c_str()), atof(cols[2].c_str()),
+                    cols[5])] = atof(cols[9].c_str());
+    }
+
+    unsigned int regressions = 0;
+    for(size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &r = results[i];
+        string key = caseKey(r.family, r.size, r.density,
+                r.expected ? "iso" : "noniso");
+        map<string, double>::const_iterator it = base.find(key);
+        if (it == base.end()) {
+            cerr << "  " << key << ": brak w linii bazowej" << endl;
+            continue;
+        }
+        double change = it->second > 0.0 ? r.median / it->second - 1.0 : 0.0;
+        bool regression = r.median > it->second * (1.0 + options.tolerance) &&
+            r.median - it->second > BENCH_NOISE_FLOOR;
+        cerr << "  " << key << ": " << it->second << " -> " << r.median
+            << " (" << (change >= 0 ? "+" : "") << change * 100.0 << "%)"
+            << (regression ? "  REGRESJA" : "") << endl;
+        if (regression) {
+            ++regressions;
+        }
+    }
+    return regressions;
+}
+
+/**
+ * @brief zamień listę rozdzieloną przecinkami na wartości
+ *
+ * @param value lista
+ * @param out wynik
+ * @param flag nazwa flagi dla komunikatu błędu
+ */
+template<typename T>
+void parseList(const string &value, vector<T> &out, const string &flag)
+{
+    out.clear();
+    vector<string> items = split(value, ',');
+    for(size_t i = 0; i < items.size(); ++i) {
+        istringstream iss(items[i]);
+        T item;
+        if (!(iss >> item) || !iss.eof()) {
+            cerr << "BŁĄD: zła wartość `" << items[i] << "' <- FLAGA `--"
+                << flag << "'" << endl;
+            exit(1);
+        }
+        out.push_back(item);
+    }
+}
+
+/**
+ * @brief interpretuj flagę `--nazwa=wartość'
+ *
+ * @param flag flaga
+ * @param options ustawienia
+ */
+void parseBenchFlag(const string &flag, BenchOptions &options)
+{
+    string::size_type eq = flag.find('=');
+    if (flag.compare(0, 2, "--") != 0 || eq == string::npos) {
+        cerr << "BŁĄD: nieznana flaga `" << flag << "'" << endl << endl;
+        benchHelp();
+        exit(1);
+    }
+    string name = flag.substr(2, eq - 2);
+    string value = flag.substr(eq + 1);
+
+    if (name == "families") {
+        vector<string> names;
+        parseList(value, names, name);
+        options.families.resize(names.size());
+        for(size_t i = 0; i < names.size(); ++i) {
+            if (!parseFamily(names[i], options.families[i])) {
+                cerr << "BŁĄD: nieznana rodzina `" << names[i] << "'" << endl;
+                exit(1);
+            }
+        }
+    }
+    else if (name == "pairs") {
+        vector<string> names;
+        parseList(value, names, name);
+        options.pairs.clear();
+        for(size_t i = 0; i < names.size(); ++i) {
+            if (names[i] != "iso" && names[i] != "noniso") {
+                cerr << "BŁĄD: nieznany rodzaj pary `" << names[i] << "'"
+                    << endl;
+                exit(1);
+            }
+            options.pairs.push_back(names[i] == "iso");
+        }
+    }
+    else if (name == "sizes") {
+        parseList(value, options.sizes, name);
+    }
+    else if (name == "densities") {
+        parseList(value, options.densities, name);
+    }
+    else if (name == "engine") {
+        if (!parseEngine(value, options.engine)) {
+            cerr << "BŁĄD: nieznany silnik `" << value << "'" << endl;
+            exit(1);
+        }
+    }
+    else if (name == "threads" || name == "repeat" || name == "warmup" ||
+            name == "seed") {
+        vector<unsigned int> number;
+        parseList(value, number, name);
+        if (number.size() != 1) {
+            cerr << "BŁĄD: oczekiwano jednej liczby <- FLAGA `--" << name << "'"
+                << endl;
+            exit(1);
+        }
+        if (name == "threads") options.threads = number[0];
+        if (name == "repeat") options.repeat = max(1u, number[0]);
+        if (name == "warmup") options.warmup = number[0];
+        if (name == "seed") options.seed = number[0];
+    }
+    else if (name == "timeout") {
+        options.timeout = atof(value.c_str());
+    }
+    else if (name == "tolerance") {
+        options.tolerance = atof(value.c_str());
+    }
+    else if (name == "format") {
+        if (value != "csv" && value != "json") {
+            cerr << "BŁĄD: nieznany format `" << value << "'" << endl;
+            exit(1);
+        }
+        options.format = value;
+    }
+    else if (name == "output") {
+        options.output = value;
+    }
+    else if (name == "baseline") {
+        options.baseline = value;
+    }
+    else {
+        cerr << "BŁĄD: nieznana flaga `" << flag << "'" << endl << endl;
+        benchHelp();
+        exit(1);
+    }
+}
+
+/**
+ * @brief main
+ *
+ * Zwraca 0, 1 gdy któraś weryfikacja dała zły wynik, 2 gdy wykryto
+ * regresję względem linii bazowej.
+ *
+ * @param argc liczba zmiennych
+ * @param argv[] tablica argumentów
+ *
+ * @return kod wyjścia
+ */
+int main(int argc, const char *argv[])
+{
+    BenchOptions options;
+    for(int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        if (arg == "--help" || arg == "-h") {
+            benchHelp();
+            return 0;
+        }
+        parseBenchFlag(arg, options);
+    }
+
+    vector<BenchResult> results;
+    unsigned int wrong = 0;
+    for(size_t f = 0; f < options.families.size(); ++f) {
+        GraphFamily family = options.families[f];
+        vector<double> densities(options.densities);
+        if (!familyUsesDensity(family)) {
+            densities.assign(1, 0.0);
+        }
+        for(size_t p = 0; p < options.pairs.size(); ++p) {
+            const char *kind = options.pairs[p] ? "iso" : "noniso";
+            for(size_t s = 0; s < options.sizes.size(); ++s) {
+                for(size_t d = 0; d < densities.size(); ++d) {
+                    cerr << "bench " << familyName(family) << " " << kind
+                        << " n=" << options.sizes[s] << " d=" << densities[d]
+                        << "..." << endl;
+                    BenchResult result;
+                    if (!runCase(family, options.sizes[s], densities[d],
+                                options.pairs[p], options, result)) {
+                        cerr << "  pominięto - rodzina nie ma takich par"
+                            << endl;
+                        continue;
+                    }
+                    results.push_back(result);
+                    wrong += result.wrong;
+                }
+            }
+        }
+    }
+
+    ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output.c_str());
+        if (!file.is_open()) {
+            cerr << "BŁĄD: nie udało się otworzyć pliku `" << options.output
+                << "'" << endl;
+            return 1;
+        }
+    }
+    ostream &out = options.output.empty() ? cout : file;
+    if (options.format == "json") {
+        writeJson(out, results, options);
+    }
+    else {
+        writeCsv(out, results, options);
+    }
+
+    if (wrong > 0) {
+        cerr << "BŁĄD: " << wrong << " weryfikacji dało zły wynik" << endl;
+        return 1;
+    }
+    if (!options.baseline.empty()) {
+        cerr << "Porównanie z linią bazową (tolerancja "
+            << options.tolerance * 100.0 << "%):" << endl;
+        if (compareBaseline(results, options) > 0) {
+            return 2;
+        }
+    }
+    return 0;
+}
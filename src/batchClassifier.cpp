@@ -0,0 +1,104 @@
+/**
+ *      @file  batchClassifier.cpp
+ *     @brief  implementacja metod klasy BatchClassifier
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include "batchClassifier.hpp"
+
+typedef FrozenGraph::idx_t idx_t;
+
+BatchClassifier::BatchClassifier(IsoEngine _engine):
+    engine(_engine), comparisons(0)
+{
+
+}
+
+unsigned int BatchClassifier::addGraph(const std::string &name, const Graph &g)
+{
+    unsigned int id = this->graphs.size();
+
+    this->graphs.push_back(FrozenGraph(g));
+    this->names.push_back(name);
+
+    std::vector<unsigned int> invariant;
+    computeInvariant(this->graphs.back(), invariant);
+    this->buckets[CanonicalForm::hashWords(invariant)].push_back(id);
+
+    return id;
+}
+
+void BatchClassifier::classify()
+{
+    using std::vector;
+    using std::sort;
+
+    this->classes.clear();
+    this->comparisons = 0;
+
+    IsomorphismAlgo::iso_map f;
+    // jeden solver na wszystkie porównania - tablice przydzielane raz
+    IsoSolver solver;
+
+    for(bucket_map_t::const_iterator bit = this->buckets.begin();
+            bit != this->buckets.end(); ++bit) {
+        const vector<unsigned int> &members = bit->second;
+        size_t first_class = this->classes.size();
+
+        for(size_t m = 0; m < members.size(); ++m) {
+            unsigned int g = members[m];
+            bool found = false;
+
+            for(size_t c = first_class; c < this->classes.size() && !found; ++c) {
+                // porównanie z reprezentantem klasy z tego samego kubełka
+                ++this->comparisons;
+                const FrozenGraph &rep = this->graphs[this->classes[c].front()];
+                bool iso = (this->engine == ENGINE_BACKTRACK) ?
+                    solver.solve(rep, this->graphs[g]) :
+                    isIsomorphic(rep, this->graphs[g], this->engine, f);
+                if (iso) {
+                    this->classes[c].push_back(g);
+                    found = true;
+                }
+            }
+
+            if (!found) {
+                this->classes.push_back(iso_class_t(1, g));
+            }
+        }
+    }
+
+    // numery w kubełkach są rosnące, więc wystarczy uporządkować klasy
+    // według pierwszego grafu
+    sort(this->classes.begin(), this->classes.end());
+}
+
+void BatchClassifier::computeInvariant(const FrozenGraph &g,
+        std::vector<unsigned int> &invariant)
+{
+    using std::sort;
+
+    unsigned int n = g.getSize();
+
+    invariant.clear();
+    invariant.push_back(n);
+    invariant.push_back(g.getEdgeCount());
+
+    ColourRefinement::colouring_t colours(n);
+    for(idx_t v = 0; v < n; ++v) {
+        colours[v] = g.getInvariant(v);
+    }
+    size_t hist = invariant.size();
+    invariant.insert(invariant.end(), colours.begin(), colours.end());
+    sort(invariant.begin() + hist, invariant.end());
+
+    unsigned int colour_count = ColourRefinement::refine(g, colours);
+    size_t sizes = invariant.size();
+    invariant.resize(sizes + colour_count, 0);
+    for(idx_t v = 0; v < n; ++v) {
+        ++invariant[sizes + colours[v]];
+    }
+}
@@ -0,0 +1,165 @@
+/**
+ *      @file  batchClassifier.hpp
+ *     @brief  plik nagłówkowy klasy BatchClassifier
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy BatchClassifier - podziału wielu grafów na klasy
+ * izomorfizmu
+ *
+ *=====================================================================================
+ */
+
+#ifndef BATCHCLASSIFIER_HPP
+#define BATCHCLASSIFIER_HPP
+
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+
+#include "graph.hpp"
+#include "frozenGraph.hpp"
+#include "isomorphismAlgo.hpp"
+#include "isoEngine.hpp"
+#include "isoSolver.hpp"
+#include "colourRefinement.hpp"
+#include "canonicalForm.hpp"
+
+/**
+ * @brief klasa dzieli zbiór grafów na klasy izomorfizmu
+ *
+ * Dla każdego dodanego grafu wyznaczany jest od razu tani niezmiennik:
+ * * liczba wierzchołków i krawędzi,
+ * * posortowany ciąg 'stopni' (invariant) - histogram jak w
+ *   \ref IsomorphismAlgo::meetsRequirements,
+ * * liczności kolorów stabilnych (\ref ColourRefinement::refine) - numeracja
+ *   kolorów nie zależy od numeracji wierzchołków, więc grafy izomorficzne
+ *   mają równe ciągi liczności.
+ *
+ * Skrót niezmiennika wyznacza kubełek. Grafy z różnych kubełków na pewno nie
+ * są izomorficzne, więc silnik weryfikacji izomorfizmu uruchamiany jest tylko
+ * w obrębie kubełka - graf porównywany jest z reprezentantami klas już
+ * znalezionych w jego kubełku.
+ */
+class BatchClassifier
+{
+    public:
+        /**
+         * @brief klasa izomorfizmu - numery grafów w kolejności dodania
+         */
+        typedef std::vector<unsigned int> iso_class_t;
+
+        /**
+         * @brief stwórz pusty klasyfikator
+         *
+         * @param _engine silnik weryfikacji izomorfizmu w kubełkach
+         */
+        explicit BatchClassifier(IsoEngine _engine = ENGINE_BACKTRACK);
+
+        /**
+         * @brief dodaj graf do zbioru
+         *
+         * Graf jest zamrażany, a jego niezmiennik wyznaczany od razu, więc
+         * obiekt \p g nie musi istnieć dalej.
+         *
+         * @param name nazwa grafu (np. nazwa pliku)
+         * @param g graf
+         *
+         * @return numer grafu
+         */
+        unsigned int addGraph(const std::string &name, const Graph &g);
+
+        /**
+         * @brief podziel dodane grafy na klasy izomorfizmu
+         */
+        void classify();
+
+        /**
+         * @brief zwraca klasy izomorfizmu
+         *
+         * Klasy uporządkowane są według pierwszego grafu, a grafy w klasie
+         * według kolejności dodania.
+         *
+         * @return referencja na klasy izomorfizmu
+         */
+        const std::vector<iso_class_t> &getClasses() const {return this->classes;};
+
+        /**
+         * @brief zwraca nazwę grafu
+         *
+         * @param g numer grafu
+         *
+         * @return nazwa grafu
+         */
+        const std::string &getName(unsigned int g) const {return this->names[g];};
+
+        /**
+         * @brief liczba dodanych grafów
+         *
+         * @return liczba grafów
+         */
+        unsigned int getGraphCount() const {return this->graphs.size();};
+
+        /**
+         * @brief liczba niepustych kubełków
+         *
+         * @return liczba kubełków
+         */
+        unsigned int getBucketCount() const {return this->buckets.size();};
+
+        /**
+         * @brief liczba wywołań silnika weryfikacji izomorfizmu
+         *
+         * @return liczba porównań
+         */
+        unsigned int getComparisonCount() const {return this->comparisons;};
+
+    private:
+        /**
+         * @brief kubełki: skrót niezmiennika -> numery grafów
+         */
+        typedef std::map<uint64_t, std::vector<unsigned int> > bucket_map_t;
+
+        /**
+         * @brief silnik weryfikacji izomorfizmu
+         */
+        IsoEngine engine;
+
+        /**
+         * @brief zamrożone grafy
+         */
+        std::vector<FrozenGraph> graphs;
+
+        /**
+         * @brief nazwy grafów
+         */
+        std::vector<std::string> names;
+
+        /**
+         * @brief kubełki grafów o równych skrótach niezmiennika
+         */
+        bucket_map_t buckets;
+
+        /**
+         * @brief znalezione klasy izomorfizmu
+         */
+        std::vector<iso_class_t> classes;
+
+        /**
+         * @brief liczba wywołań silnika
+         */
+        unsigned int comparisons;
+
+        /**
+         * @brief wyznacz tani niezmiennik grafu
+         *
+         * @param g zamrożony graf
+         * @param invariant ciąg słów niezmiennika
+         */
+        static void computeInvariant(const FrozenGraph &g,
+                std::vector<unsigned int> &invariant);
+};
+
+#endif /* end of include guard: BATCHCLASSIFIER_HPP */
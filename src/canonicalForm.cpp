@@ -0,0 +1,308 @@
+/**
+ *      @file  canonicalForm.cpp
+ *     @brief  implementacja metod klasy CanonicalForm
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include "canonicalForm.hpp"
+
+typedef FrozenGraph::idx_t idx_t;
+typedef FrozenGraph::adj_iterator adj_iterator;
+typedef ColourRefinement::colouring_t colouring_t;
+
+CanonicalForm::CanonicalForm(const Graph &_graph):
+    frozen(_graph), graph(frozen), leaf_count(0), automorphism_count(0)
+{
+
+}
+
+CanonicalForm::CanonicalForm(const FrozenGraph &_graph):
+    graph(_graph), leaf_count(0), automorphism_count(0)
+{
+
+}
+
+void CanonicalForm::canonize()
+{
+    unsigned int n = this->graph.getSize();
+
+    this->path.clear();
+    this->best_path.clear();
+    this->best_cert.clear();
+    this->best_inv.clear();
+    this->automorphisms.clear();
+    this->group_orbit.resize(n);
+    for(idx_t v = 0; v < n; ++v) {
+        this->group_orbit[v] = v;
+    }
+    this->ordering.clear();
+    this->leaf_count = 0;
+    this->automorphism_count = 0;
+
+    if (n == 0) {
+        this->leafCertificate(colouring_t(), this->best_cert);
+        return;
+    }
+
+    colouring_t colours(n);
+    for(idx_t v = 0; v < n; ++v) {
+        colours[v] = this->graph.getInvariant(v);
+    }
+    this->levels.resize(1);
+    unsigned int colour_count = ColourRefinement::refine(this->graph, colours,
+            this->levels[0]);
+
+    this->search(colours, colour_count);
+
+    this->ordering.resize(n);
+    for(unsigned int i = 0; i < n; ++i) {
+        this->ordering[i] = this->graph.getLabel(this->best_inv[i]);
+    }
+}
+
+unsigned int CanonicalForm::search(const colouring_t &colours,
+        unsigned int colour_count)
+{
+    using std::vector;
+
+    unsigned int n = this->graph.getSize();
+    unsigned int depth = this->path.size();
+
+    if (colour_count == n) {
+        return this->processLeaf(colours);
+    }
+
+    // pierwsza klasa o więcej niż jednym wierzchołku - wybór niezależny
+    // od numeracji wierzchołków, bo kolory są kanoniczne
+    vector<unsigned int> cell_size(colour_count, 0);
+    for(idx_t v = 0; v < n; ++v) {
+        ++cell_size[colours[v]];
+    }
+    unsigned int target = 0;
+    while (cell_size[target] < 2) {
+        ++target;
+    }
+
+    vector<idx_t> cell;
+    cell.reserve(cell_size[target]);
+    for(idx_t v = 0; v < n; ++v) {
+        if (colours[v] == target) {
+            cell.push_back(v);
+        }
+    }
+
+    vector<idx_t> explored;
+    vector<idx_t> orbit;
+    size_t orbits_for = 0;
+    colouring_t child(n);
+    if (this->levels.size() < depth + 2) {
+        this->levels.resize(depth + 2);
+    }
+
+    for(size_t c = 0; c < cell.size(); ++c) {
+        idx_t v = cell[c];
+
+        if (!explored.empty()) {
+            if (orbit.empty() || orbits_for != this->automorphisms.size()) {
+                this->computeOrbits(orbit);
+                orbits_for = this->automorphisms.size();
+            }
+            bool skip = false;
+            for(size_t e = 0; e < explored.size() && !skip; ++e) {
+                skip = (orbit[explored[e]] == orbit[v]);
+            }
+            if (skip) {
+                continue;
+            }
+        }
+
+        // indywidualizacja: v dostaje własną klasę, a podział rodzica jest
+        // uszczegóławiany tylko od niej
+        this->levels[depth + 1] = this->levels[depth];
+        unsigned int child_count = ColourRefinement::individualize(this->graph,
+                v, child, this->levels[depth + 1]);
+
+        this->path.push_back(v);
+        unsigned int jump = this->search(child, child_count);
+        this->path.pop_back();
+
+        explored.push_back(v);
+        if (jump < depth) {
+            return jump;
+        }
+    }
+    return depth;
+}
+
+unsigned int CanonicalForm::processLeaf(const colouring_t &colours)
+{
+    unsigned int n = this->graph.getSize();
+    unsigned int depth = this->path.size();
+
+    ++this->leaf_count;
+    this->leafCertificate(colours, this->leaf_cert);
+
+    if (this->best_cert.empty() || this->leaf_cert < this->best_cert) {
+        this->best_cert.swap(this->leaf_cert);
+        this->best_path = this->path;
+        this->best_inv.resize(n);
+        for(idx_t v = 0; v < n; ++v) {
+            this->best_inv[colours[v]] = v;
+        }
+        return depth;
+    }
+
+    if (this->leaf_cert != this->best_cert) {
+        return depth;
+    }
+
+    // ten sam graf - automorfizm przeprowadzający bieżący liść na najlepszy
+    permutation_t gamma(n);
+    bool identity = true;
+    for(idx_t v = 0; v < n; ++v) {
+        gamma[v] = this->best_inv[colours[v]];
+        identity = identity && (gamma[v] == v);
+    }
+    if (identity) {
+        return depth;
+    }
+    ++this->automorphism_count;
+    if (this->joinOrbits(gamma) ||
+            this->automorphisms.size() < CANON_MAX_AUTOMORPHISMS) {
+        this->automorphisms.push_back(gamma);
+    }
+
+    // gamma ustala wspólny początek ścieżek, więc poddrzewo w którym
+    // ścieżki się rozchodzą jest obrazem już przeszukanego
+    unsigned int common = 0;
+    while (common < this->path.size() && common < this->best_path.size() &&
+            this->path[common] == this->best_path[common]) {
+        ++common;
+    }
+    return common;
+}
+
+void CanonicalForm::leafCertificate(const colouring_t &colours,
+        certificate_t &cert) const
+{
+    unsigned int n = this->graph.getSize();
+
+    permutation_t inv(n);
+    for(idx_t v = 0; v < n; ++v) {
+        inv[colours[v]] = v;
+    }
+
+    cert.clear();
+    cert.reserve(2 + n + this->graph.getEdgeCount());
+    cert.push_back(n);
+    cert.push_back(this->graph.getEdgeCount());
+    for(unsigned int i = 0; i < n; ++i) {
+        cert.push_back(this->graph.adjEnd(inv[i]) - this->graph.adjBegin(inv[i]));
+    }
+    for(unsigned int i = 0; i < n; ++i) {
+        size_t row = cert.size();
+        for(adj_iterator it = this->graph.adjBegin(inv[i]);
+                it != this->graph.adjEnd(inv[i]); ++it) {
+            cert.push_back(colours[*it]);
+        }
+        std::sort(cert.begin() + row, cert.end());
+    }
+}
+
+void CanonicalForm::computeOrbits(std::vector<idx_t> &orbit) const
+{
+    unsigned int n = this->graph.getSize();
+
+    orbit.resize(n);
+    for(idx_t v = 0; v < n; ++v) {
+        orbit[v] = v;
+    }
+
+    for(size_t a = 0; a < this->automorphisms.size(); ++a) {
+        const permutation_t &gamma = this->automorphisms[a];
+
+        bool fixes = true;
+        for(size_t p = 0; p < this->path.size() && fixes; ++p) {
+            fixes = (gamma[this->path[p]] == this->path[p]);
+        }
+        if (!fixes) {
+            continue;
+        }
+
+        for(idx_t v = 0; v < n; ++v) {
+            // łączenie orbit v i gamma(v), reprezentant to najmniejszy indeks
+            idx_t ra = v;
+            while (orbit[ra] != ra) {
+                ra = orbit[ra];
+            }
+            idx_t rb = gamma[v];
+            while (orbit[rb] != rb) {
+                rb = orbit[rb];
+            }
+            if (ra < rb) {
+                orbit[rb] = ra;
+            }
+            else if (rb < ra) {
+                orbit[ra] = rb;
+            }
+        }
+    }
+
+    // rodzic ma zawsze mniejszy indeks, więc jedno przejście wystarcza
+    for(idx_t v = 0; v < n; ++v) {
+        orbit[v] = orbit[orbit[v]];
+    }
+}
+
+bool CanonicalForm::joinOrbits(const permutation_t &gamma)
+{
+    bool joined = false;
+    for(idx_t v = 0; v < gamma.size(); ++v) {
+        idx_t ra = v;
+        while (this->group_orbit[ra] != ra) {
+            ra = this->group_orbit[ra];
+        }
+        idx_t rb = gamma[v];
+        while (this->group_orbit[rb] != rb) {
+            rb = this->group_orbit[rb];
+        }
+        if (ra != rb) {
+            this->group_orbit[std::max(ra, rb)] = std::min(ra, rb);
+            joined = true;
+        }
+    }
+    return joined;
+}
+
+uint64_t CanonicalForm::hashWords(const std::vector<unsigned int> &words)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < words.size(); ++i) {
+        unsigned int word = words[i];
+        for(int b = 0; b < 4; ++b) {
+            hash ^= (word >> (8 * b)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+std::string CanonicalForm::getInfo() const
+{
+    using std::endl;
+    using std::stringstream;
+
+    stringstream ss;
+    ss << "Liczba liści:         " << this->leaf_count << endl;
+    ss << "Liczba automorfizmów: " << this->automorphism_count << endl;
+    ss << "Kolejność kanoniczna:";
+    for(size_t i = 0; i < this->ordering.size(); ++i) {
+        ss << " " << this->ordering[i];
+    }
+    ss << endl;
+
+    return ss.str();
+}
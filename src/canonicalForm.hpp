@@ -0,0 +1,280 @@
+/**
+ *      @file  canonicalForm.hpp
+ *     @brief  plik nagłówkowy klasy CanonicalForm
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy CanonicalForm - kanonicznego etykietowania grafu metodą
+ * indywidualizacji i uszczegóławiania
+ *
+ *=====================================================================================
+ */
+
+#ifndef CANONICALFORM_HPP
+#define CANONICALFORM_HPP
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "graph.hpp"
+#include "frozenGraph.hpp"
+#include "colourRefinement.hpp"
+
+/**
+ * @brief maksymalna liczba zapamiętywanych automorfizmów używanych do
+ * przycinania drzewa przeszukiwania
+ *
+ * Ponad ten limit zapamiętywane są tylko automorfizmy łączące orbity całej
+ * znalezionej dotąd grupy (co najwyżej n-1). Pominięcie automorfizmu osłabia
+ * tylko przycinanie, nie zmienia wyniku.
+ */
+#define CANON_MAX_AUTOMORPHISMS 256
+
+/**
+ * @brief klasa wyznacza kanoniczne etykietowanie grafu i jego certyfikat
+ *
+ * Algorytm w stylu nauty/bliss:
+ * * kolorowanie wierzchołków jest uszczegóławiane do stabilnego
+ *   (\ref ColourRefinement::refine),
+ * * jeżeli kolorowanie nie jest dyskretne, wybierana jest pierwsza (o
+ *   najmniejszym kolorze) klasa o więcej niż jednym wierzchołku i kolejno
+ *   indywidualizowany jest każdy jej wierzchołek; dziecko uszczegóławia
+ *   podział rodzica tylko od nowej klasy
+ *   (\ref ColourRefinement::individualize),
+ * * liście drzewa (kolorowania dyskretne) wyznaczają permutacje; kanoniczna
+ *   to ta, dla której certyfikat przenumerowanego grafu jest
+ *   leksykograficznie najmniejszy,
+ * * liście o certyfikacie równym najlepszemu dają automorfizmy, którymi
+ *   przycinane są poddrzewa: powrót do węzła rozwidlenia ścieżek oraz
+ *   pomijanie dzieci z jednej orbity stabilizatora ścieżki.
+ *
+ * Grafy są izomorficzne wtedy i tylko wtedy, gdy mają równe certyfikaty,
+ * więc deduplikacja N grafów to N kanonizacji zamiast N^2 porównań.
+ */
+class CanonicalForm
+{
+    public:
+        /**
+         * @brief certyfikat grafu: liczba wierzchołków, liczba krawędzi,
+         * stopnie wyjściowe i listy następników w numeracji kanonicznej
+         */
+        typedef std::vector<unsigned int> certificate_t;
+
+        /**
+         * @brief znaczniki wierzchołków w kolejności kanonicznej
+         */
+        typedef std::vector<Graph::label_t> ordering_t;
+
+        /**
+         * @brief konstruktor biorący referencję na graf
+         *
+         * @param _graph graf
+         */
+        explicit CanonicalForm(const Graph &_graph);
+
+        /**
+         * @brief konstruktor biorący referencję na zamrożony graf
+         *
+         * Graf nie jest kopiowany, musi istnieć przez cały czas życia
+         * obiektu.
+         *
+         * @param _graph zamrożony graf
+         */
+        explicit CanonicalForm(const FrozenGraph &_graph);
+
+        /**
+         * @brief wyznacz kanoniczne etykietowanie i certyfikat grafu
+         */
+        void canonize();
+
+        /**
+         * @brief zwraca znaczniki wierzchołków w kolejności kanonicznej
+         *
+         * @return referencja na ciąg znaczników, i-ty element to znacznik
+         * wierzchołka o numerze kanonicznym i
+         */
+        const ordering_t &getOrdering() const {return this->ordering;};
+
+        /**
+         * @brief zwraca certyfikat grafu
+         *
+         * @return referencja na certyfikat
+         */
+        const certificate_t &getCertificate() const {return this->best_cert;};
+
+        /**
+         * @brief skrót certyfikatu (FNV-1a)
+         *
+         * @return skrót certyfikatu
+         */
+        uint64_t getHash() const {return hashWords(this->best_cert);};
+
+        /**
+         * @brief skrót FNV-1a ciągu słów (certyfikatu lub innego
+         * niezmiennika grafu)
+         *
+         * @param words ciąg słów
+         *
+         * @return skrót
+         */
+        static uint64_t hashWords(const std::vector<unsigned int> &words);
+
+        /**
+         * @brief liczba odwiedzonych liści drzewa przeszukiwania
+         *
+         * @return liczba liści
+         */
+        unsigned int getLeafCount() const {return this->leaf_count;};
+
+        /**
+         * @brief liczba znalezionych automorfizmów (różnych od identyczności)
+         *
+         * @return liczba automorfizmów
+         */
+        unsigned int getAutomorphismCount() const {return this->automorphism_count;};
+
+        /**
+         * @brief informacje pomocnicze na temat obiektu klasy \ref CanonicalForm
+         *
+         * @return string z informacjami pomocniczymi
+         */
+        std::string getInfo() const;
+
+    private:
+        /**
+         * @brief gęsty indeks wierzchołka zamrożonego grafu
+         */
+        typedef FrozenGraph::idx_t idx_t;
+
+        /**
+         * @brief permutacja wierzchołków w gęstych indeksach
+         */
+        typedef std::vector<idx_t> permutation_t;
+
+        /**
+         * @brief zamrożona kopia grafu, gdy obiekt stworzono z \ref Graph
+         */
+        const FrozenGraph frozen;
+
+        /**
+         * @brief kanonizowany graf
+         */
+        const FrozenGraph &graph;
+
+        /**
+         * @brief ciąg wierzchołków indywidualizowanych na bieżącej ścieżce
+         */
+        std::vector<idx_t> path;
+
+        /**
+         * @brief ścieżka prowadząca do najlepszego liścia
+         */
+        std::vector<idx_t> best_path;
+
+        /**
+         * @brief certyfikat najlepszego liścia
+         */
+        certificate_t best_cert;
+
+        /**
+         * @brief odwrotność permutacji najlepszego liścia: numer kanoniczny ->
+         * wierzchołek
+         */
+        permutation_t best_inv;
+
+        /**
+         * @brief znalezione automorfizmy
+         */
+        std::vector<permutation_t> automorphisms;
+
+        /**
+         * @brief orbity grupy generowanej przez znalezione automorfizmy
+         * (las zbiorów rozłącznych, rodzic ma mniejszy indeks)
+         */
+        std::vector<idx_t> group_orbit;
+
+        /**
+         * @brief podziały stabilne węzłów bieżącej ścieżki - dziecko kopiuje
+         * podział rodzica i uszczegóławia go od indywidualizowanej klasy
+         */
+        std::vector<ColourRefinement::Workspace> levels;
+
+        /**
+         * @brief bufor na certyfikat bieżącego liścia
+         */
+        certificate_t leaf_cert;
+
+        /**
+         * @brief wynik - znaczniki w kolejności kanonicznej
+         */
+        ordering_t ordering;
+
+        /**
+         * @brief liczba odwiedzonych liści
+         */
+        unsigned int leaf_count;
+
+        /**
+         * @brief liczba znalezionych automorfizmów
+         */
+        unsigned int automorphism_count;
+
+        /**
+         * @brief przeszukaj poddrzewo węzła o danym kolorowaniu stabilnym
+         *
+         * Podział stabilny węzła leży w levels[głębokość].
+         *
+         * @param colours kolorowanie stabilne węzła
+         * @param colour_count liczba kolorów
+         *
+         * @return głębokość węzła, do którego należy wrócić (równa głębokości
+         * bieżącego węzła gdy nie ma powrotu)
+         */
+        unsigned int search(const ColourRefinement::colouring_t &colours,
+                unsigned int colour_count);
+
+        /**
+         * @brief przetwórz liść (kolorowanie dyskretne)
+         *
+         * @param colours kolorowanie dyskretne - numer kanoniczny wierzchołka
+         *
+         * @return głębokość węzła, do którego należy wrócić
+         */
+        unsigned int processLeaf(const ColourRefinement::colouring_t &colours);
+
+        /**
+         * @brief zapisz certyfikat grafu przenumerowanego kolorowaniem
+         * dyskretnym
+         *
+         * @param colours kolorowanie dyskretne
+         * @param cert certyfikat
+         */
+        void leafCertificate(const ColourRefinement::colouring_t &colours,
+                certificate_t &cert) const;
+
+        /**
+         * @brief wyznacz orbity automorfizmów ustalających punktowo
+         * bieżącą ścieżkę
+         *
+         * Dzieci węzła leżące na jednej orbicie mają izomorficzne poddrzewa,
+         * więc wystarczy przeszukać jedno z nich.
+         *
+         * @param orbit reprezentant orbity każdego wierzchołka
+         */
+        void computeOrbits(std::vector<idx_t> &orbit) const;
+
+        /**
+         * @brief dołącz automorfizm do orbit \ref CanonicalForm::group_orbit
+         *
+         * @param gamma automorfizm
+         *
+         * @return czy automorfizm połączył co najmniej dwie orbity
+         */
+        bool joinOrbits(const permutation_t &gamma);
+};
+
+#endif /* end of include guard: CANONICALFORM_HPP */
@@ -0,0 +1,437 @@
+/**
+ *      @file  colourRefinement.cpp
+ *     @brief  implementacja metod klasy ColourRefinement
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include "colourRefinement.hpp"
+
+unsigned int ColourRefinement::refine(const FrozenGraph &g, colouring_t &colours)
+{
+    Workspace work;
+    return refine(g, colours, work);
+}
+
+unsigned int ColourRefinement::refine(const FrozenGraph &g, colouring_t &colours,
+        Workspace &work)
+{
+    Part part;
+    part.graph = &g;
+    part.colours = &colours;
+
+    Mode mode;
+    mode.discrete_stop = true;
+    layout(&part, 1, work, mode);
+    run(&part, 1, work, mode);
+    return collect(&part, 1, work);
+}
+
+unsigned int ColourRefinement::individualize(const FrozenGraph &g,
+        FrozenGraph::idx_t v, colouring_t &colours, Workspace &work)
+{
+    using std::swap;
+
+    Part part;
+    part.graph = &g;
+    part.colours = &colours;
+
+    unsigned int c = work.cell[v];
+    unsigned int end = work.cell_end[c];
+    if (end - c > 1) {
+        // v na koniec klasy; reszta zachowuje numer klasy c
+        unsigned int last = end - 1;
+        unsigned int u = work.elements[last];
+        swap(work.elements[work.position[v]], work.elements[last]);
+        work.position[u] = work.position[v];
+        work.position[v] = last;
+
+        work.cell[v] = last;
+        work.cell_end[last] = end;
+        work.cell_end[c] = last;
+        ++work.cell_count;
+
+        // podział był stabilny względem klasy c, więc względem reszty
+        // wynika ze stabilności względem {v}
+        work.queue.assign(1, last);
+        work.queued[last] = 1;
+
+        Mode mode;
+        mode.discrete_stop = true;
+        run(&part, 1, work, mode);
+    }
+    return collect(&part, 1, work);
+}
+
+bool ColourRefinement::refineJoint(const FrozenGraph &gX, const FrozenGraph &gY,
+        colouring_t &coloursX, colouring_t &coloursY,
+        unsigned int &colour_count)
+{
+    Workspace work;
+    return refineJoint(gX, gY, coloursX, coloursY, colour_count, work);
+}
+
+bool ColourRefinement::refineJoint(const FrozenGraph &gX, const FrozenGraph &gY,
+        colouring_t &coloursX, colouring_t &coloursY,
+        unsigned int &colour_count, Workspace &work)
+{
+    colour_count = 0;
+    if (gX.getSize() != gY.getSize()) {
+        return false;
+    }
+
+    Part parts[2];
+    parts[0].graph = &gX;
+    parts[0].colours = &coloursX;
+    parts[1].graph = &gY;
+    parts[1].colours = &coloursY;
+
+    Mode mode;
+    if (!layout(parts, 2, work, mode) || !run(parts, 2, work, mode)) {
+        return false;
+    }
+    colour_count = collect(parts, 2, work);
+    return true;
+}
+
+unsigned int ColourRefinement::refineTraced(const FrozenGraph &g,
+        colouring_t &colours, Trace &trace)
+{
+    Part part;
+    part.graph = &g;
+    part.colours = &colours;
+
+    trace.vertex_count = g.getSize();
+    trace.initial.clear();
+    trace.splits.clear();
+    trace.pass_begin.assign(1, 0);
+
+    Workspace work;
+    Mode mode;
+    mode.record = &trace;
+    layout(&part, 1, work, mode);
+    run(&part, 1, work, mode);
+    trace.colour_count = collect(&part, 1, work);
+    return trace.colour_count;
+}
+
+bool ColourRefinement::refineByTrace(const Trace &trace, const FrozenGraph &g,
+        colouring_t &colours, unsigned int &colour_count, Workspace &work)
+{
+    colour_count = 0;
+    if (g.getSize() != trace.vertex_count) {
+        return false;
+    }
+
+    Part part;
+    part.graph = &g;
+    part.colours = &colours;
+
+    Mode mode;
+    mode.replay = &trace;
+    if (!layout(&part, 1, work, mode) || !run(&part, 1, work, mode) ||
+            mode.replay_pass + 1 != trace.pass_begin.size()) {
+        // graf potrzebował mniej przejść niż wzorzec
+        return false;
+    }
+    colour_count = collect(&part, 1, work);
+    return true;
+}
+
+bool ColourRefinement::layout(Part *parts, unsigned int part_count,
+        Workspace &work, Mode &mode)
+{
+    using std::vector;
+    using std::pair;
+    using std::make_pair;
+    using std::sort;
+
+    typedef FrozenGraph::idx_t idx_t;
+
+    // wierzchołki wszystkich grafów numerowane kolejno: base[p] + v
+    vector<unsigned int> &base = work.base;
+    base.assign(part_count + 1, 0);
+    for(unsigned int p = 0; p < part_count; ++p) {
+        base[p + 1] = base[p] + parts[p].graph->getSize();
+    }
+    unsigned int total = base[part_count];
+
+    // tablice zachowują pojemność między wywołaniami
+    work.elements.resize(total);
+    work.position.resize(total);
+    work.cell.resize(total);
+    work.cell_end.resize(total);
+    work.queued.assign(total, 0);
+    work.count.assign(total, 0);
+    work.queue.clear();
+    work.cell_count = 0;
+
+    // klasy początkowe w kolejności kolorów
+    vector<pair<pair<unsigned int, unsigned int>, unsigned int> > &order =
+        work.touched;
+    order.clear();
+    for(unsigned int p = 0; p < part_count; ++p) {
+        const colouring_t &c = *parts[p].colours;
+        for(idx_t v = 0; v < parts[p].graph->getSize(); ++v) {
+            order.push_back(make_pair(make_pair(c[v], 0u), base[p] + v));
+        }
+    }
+    sort(order.begin(), order.end());
+
+    size_t initial = 0;
+    for(unsigned int first = 0; first < total; ) {
+        unsigned int colour = order[first].first.first;
+        unsigned int last = first;
+        unsigned int in_x = 0;
+        for(; last < total && order[last].first.first == colour; ++last) {
+            unsigned int u = order[last].second;
+            work.elements[last] = u;
+            work.position[u] = last;
+            work.cell[u] = first;
+            if (u < base[1]) {
+                ++in_x;
+            }
+        }
+        unsigned int size = last - first;
+
+        if (part_count == 2 && 2 * in_x != size) {
+            return false;
+        }
+        if (mode.record != NULL) {
+            mode.record->initial.push_back(colour);
+            mode.record->initial.push_back(size);
+        }
+        if (mode.replay != NULL) {
+            const vector<unsigned int> &expected = mode.replay->initial;
+            if (initial + 2 > expected.size() ||
+                    expected[initial] != colour ||
+                    expected[initial + 1] != size) {
+                return false;
+            }
+            initial += 2;
+        }
+
+        work.cell_end[first] = last;
+        work.queued[first] = 1;
+        work.queue.push_back(first);
+        ++work.cell_count;
+        first = last;
+    }
+    order.clear();
+
+    return mode.replay == NULL || initial == mode.replay->initial.size();
+}
+
+bool ColourRefinement::run(Part *parts, unsigned int part_count,
+        Workspace &work, Mode &mode)
+{
+    unsigned int total = work.base[part_count];
+
+    bool equal = true;
+    size_t head = 0;
+    for(; head < work.queue.size(); ++head) {
+        if (mode.discrete_stop && work.cell_count == total) {
+            break;
+        }
+        if (work.budget != NULL && head % BUDGET_CHECK_INTERVAL == 0 &&
+                !work.budget->consume(0)) {
+            equal = false;
+            break;
+        }
+        unsigned int s = work.queue[head];
+        work.queued[s] = 0;
+        work.splitter.assign(work.elements.begin() + s,
+                work.elements.begin() + work.cell_end[s]);
+
+        if (!split(parts, part_count, work, true, mode) ||
+                !split(parts, part_count, work, false, mode)) {
+            equal = false;
+            break;
+        }
+    }
+
+    // przy przerwaniu w kolejce zostają klasy - następne wywołanie zaczyna
+    // od pustej
+    for(; head < work.queue.size(); ++head) {
+        work.queued[work.queue[head]] = 0;
+    }
+    work.queue.clear();
+    return equal;
+}
+
+bool ColourRefinement::split(Part *parts, unsigned int part_count,
+        Workspace &work, bool forward, Mode &mode)
+{
+    using std::vector;
+    using std::sort;
+    using std::swap;
+    using std::make_pair;
+
+    typedef FrozenGraph::adj_iterator adj_iterator;
+
+    const vector<unsigned int> &base = work.base;
+    vector<unsigned int> &elements = work.elements;
+    vector<unsigned int> &position = work.position;
+    vector<unsigned int> &cell = work.cell;
+    vector<unsigned int> &cell_end = work.cell_end;
+    vector<unsigned int> &count = work.count;
+    vector<std::pair<std::pair<unsigned int, unsigned int>,
+        unsigned int> > &touched = work.touched;
+
+    // liczba następników (forward) lub poprzedników w rozdzielaczu - dla
+    // następników przechodzimy po poprzednikach wierzchołków rozdzielacza
+    touched.clear();
+    for(size_t i = 0; i < work.splitter.size(); ++i) {
+        unsigned int w = work.splitter[i];
+        unsigned int p = (part_count == 2 && w >= base[1]) ? 1 : 0;
+        const FrozenGraph &g = *parts[p].graph;
+        unsigned int x = w - base[p];
+
+        adj_iterator first = forward ? g.predBegin(x) : g.adjBegin(x);
+        adj_iterator last = forward ? g.predEnd(x) : g.adjEnd(x);
+        for(adj_iterator it = first; it != last; ++it) {
+            unsigned int u = base[p] + *it;
+            if (count[u]++ == 0) {
+                touched.push_back(make_pair(make_pair(0u, 0u), u));
+            }
+        }
+    }
+    for(size_t i = 0; i < touched.size(); ++i) {
+        unsigned int u = touched[i].second;
+        touched[i].first = make_pair(cell[u], count[u]);
+        count[u] = 0;
+    }
+    sort(touched.begin(), touched.end());
+
+    const vector<unsigned int> *expected = NULL;
+    size_t next = 0, pass_end = 0;
+    if (mode.replay != NULL) {
+        if (mode.replay_pass + 1 >= mode.replay->pass_begin.size()) {
+            return false;
+        }
+        expected = &mode.replay->splits;
+        next = mode.replay->pass_begin[mode.replay_pass];
+        pass_end = mode.replay->pass_begin[mode.replay_pass + 1];
+        ++mode.replay_pass;
+    }
+
+    for(size_t a = 0; a < touched.size(); ) {
+        unsigned int c = touched[a].first.first;
+        size_t b = a;
+        while (b < touched.size() && touched[b].first.first == c) {
+            ++b;
+        }
+        unsigned int end = cell_end[c];
+
+        // dotknięte wierzchołki na koniec klasy, rosnąco według liczby
+        unsigned int pos = end;
+        for(size_t i = b; i-- > a; ) {
+            unsigned int u = touched[i].second;
+            --pos;
+            unsigned int w = elements[pos];
+            swap(elements[position[u]], elements[pos]);
+            position[w] = position[u];
+            position[u] = pos;
+        }
+
+        // części: niedotknięta [c, end - (b - a)) i grupy równych liczb
+        bool was_queued = work.queued[c];
+        unsigned int largest = c, largest_size = 0;
+        if (pos > c) {
+            largest_size = pos - c;
+        }
+        unsigned int fragments = (pos > c) ? 1 : 0;
+        unsigned int first_end = pos;
+        unsigned int start = pos;
+        for(size_t i = a; i < b; ) {
+            size_t j = i;
+            unsigned int in_x = 0;
+            while (j < b && touched[j].first.second == touched[i].first.second) {
+                if (touched[j].second < base[1]) {
+                    ++in_x;
+                }
+                ++j;
+            }
+            unsigned int size = j - i;
+
+            if (mode.record != NULL) {
+                mode.record->splits.push_back(c);
+                mode.record->splits.push_back(touched[i].first.second);
+                mode.record->splits.push_back(size);
+            }
+            if (expected != NULL) {
+                if (next + 3 > pass_end || (*expected)[next] != c ||
+                        (*expected)[next + 1] != touched[i].first.second ||
+                        (*expected)[next + 2] != size) {
+                    return false;
+                }
+                next += 3;
+            }
+            if (part_count == 2 && 2 * in_x != size) {
+                return false;
+            }
+
+            if (start == c) {
+                first_end = start + size;
+            }
+            else {
+                for(size_t k = i; k < j; ++k) {
+                    cell[touched[k].second] = start;
+                }
+                cell_end[start] = start + size;
+            }
+            if (size > largest_size) {
+                largest = start;
+                largest_size = size;
+            }
+            ++fragments;
+            start += size;
+            i = j;
+        }
+
+        if (fragments > 1) {
+            cell_end[c] = first_end;
+            work.cell_count += fragments - 1;
+
+            // do kolejki wszystkie nowe części, a jeśli c w niej nie było -
+            // wszystkie poza pierwszą największą
+            for(unsigned int f = c; f < end; f = cell_end[f]) {
+                if (work.queued[f] || (!was_queued && f == largest)) {
+                    continue;
+                }
+                work.queued[f] = 1;
+                work.queue.push_back(f);
+            }
+        }
+        a = b;
+    }
+
+    if (mode.record != NULL) {
+        mode.record->pass_begin.push_back(mode.record->splits.size());
+    }
+    return expected == NULL || next == pass_end;
+}
+
+unsigned int ColourRefinement::collect(Part *parts, unsigned int part_count,
+        Workspace &work)
+{
+    const std::vector<unsigned int> &base = work.base;
+    unsigned int total = base[part_count];
+
+    unsigned int colour = 0;
+    for(unsigned int p = 0; p < part_count; ++p) {
+        parts[p].colours->resize(parts[p].graph->getSize());
+    }
+    for(unsigned int i = 0; i < total; ) {
+        unsigned int end = work.cell_end[i];
+        for(; i < end; ++i) {
+            unsigned int u = work.elements[i];
+            unsigned int p = (part_count == 2 && u >= base[1]) ? 1 : 0;
+            (*parts[p].colours)[u - base[p]] = colour;
+        }
+        ++colour;
+    }
+    return colour;
+}
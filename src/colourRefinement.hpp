@@ -0,0 +1,398 @@
+/**
+ *      @file  colourRefinement.hpp
+ *     @brief  plik nagłówkowy klasy ColourRefinement
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy ColourRefinement - iteracyjnego uszczegóławiania
+ * kolorowania wierzchołków (1-WL, podział równomierny)
+ *
+ *=====================================================================================
+ */
+
+#ifndef COLOURREFINEMENT_HPP
+#define COLOURREFINEMENT_HPP
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "frozenGraph.hpp"
+#include "searchLimits.hpp"
+
+/**
+ * @brief klasa implementuje uszczegóławianie kolorów (colour refinement,
+ * algorytm Weisfeilera-Lehmana wymiaru 1) dla grafów skierowanych
+ *
+ * Kolory tworzą podział uporządkowany: wierzchołki leżą w tablicy klasami,
+ * a klasę identyfikuje pozycja jej początku. Klasa z kolejki (rozdzielacz)
+ * dzieli każdą klasę według liczby następników, a potem poprzedników
+ * leżących w rozdzielaczu; części dostają kolejne pozycje w kolejności
+ * rosnącej liczby. Do kolejki trafiają wszystkie części poza największą
+ * (podział względem niej wynika z pozostałych), więc wierzchołek wchodzi
+ * do rozdzielacza O(log n) razy, a całe uszczegóławianie kosztuje
+ * O((n + m) log^2 n) zamiast O(n) rund po O((n + m) log n).
+ *
+ * Wynik to najgrubszy podział równomierny (stabilny) drobniejszy od
+ * początkowego. Pozycje klas zależą tylko od rozmiarów części, nie od
+ * numeracji wierzchołków, więc kolory - numery klas w kolejności pozycji -
+ * są kanoniczne.
+ *
+ * Kolorowanie stabilne jest niezmiennikiem izomorfizmu: wierzchołek grafu X
+ * może przejść tylko na wierzchołek grafu Y o tym samym kolorze, a grafy
+ * o różnych histogramach kolorów nie są izomorficzne. Aby kolory obu grafów
+ * były porównywalne, oba grafy kolorowane są jednocześnie
+ * (\ref ColourRefinement::refineJoint).
+ */
+class ColourRefinement
+{
+    public:
+        /**
+         * @brief kolory wierzchołków indeksowane gęstym indeksem
+         */
+        typedef std::vector<unsigned int> colouring_t;
+
+        /**
+         * @brief podział uporządkowany i tablice robocze uszczegóławiania
+         *
+         * Przekazywane przez wywołującego, który weryfikuje wiele par grafów,
+         * aby kolejne wywołania korzystały z już przydzielonej pamięci. Po
+         * \ref ColourRefinement::refine zawiera podział stabilny grafu,
+         * od którego startuje \ref ColourRefinement::individualize.
+         */
+        struct Workspace
+        {
+            Workspace(): cell_count(0), budget(NULL) {};
+
+            /**
+             * @brief pierwsze numery wierzchołków kolejnych grafów
+             */
+            std::vector<unsigned int> base;
+
+            /**
+             * @brief wierzchołki w kolejności klas
+             */
+            std::vector<unsigned int> elements;
+
+            /**
+             * @brief pozycja wierzchołka w \ref Workspace::elements
+             */
+            std::vector<unsigned int> position;
+
+            /**
+             * @brief początek klasy wierzchołka
+             */
+            std::vector<unsigned int> cell;
+
+            /**
+             * @brief koniec klasy indeksowany jej początkiem
+             */
+            std::vector<unsigned int> cell_end;
+
+            /**
+             * @brief czy klasa (indeksowana początkiem) czeka w kolejce
+             */
+            std::vector<char> queued;
+
+            /**
+             * @brief kolejka rozdzielaczy (początki klas)
+             */
+            std::vector<unsigned int> queue;
+
+            /**
+             * @brief liczba sąsiadów wierzchołka w rozdzielaczu
+             */
+            std::vector<unsigned int> count;
+
+            /**
+             * @brief kopia rozdzielacza - dzielony może być on sam
+             */
+            std::vector<unsigned int> splitter;
+
+            /**
+             * @brief wierzchołki z sąsiadem w rozdzielaczu: (klasa, liczba,
+             * wierzchołek)
+             */
+            std::vector<std::pair<std::pair<unsigned int, unsigned int>,
+                unsigned int> > touched;
+
+            /**
+             * @brief liczba klas
+             */
+            unsigned int cell_count;
+
+            /**
+             * @brief limity sprawdzane co \ref BUDGET_CHECK_INTERVAL
+             * rozdzielaczy (NULL - bez limitów); po wyczerpaniu
+             * uszczegóławianie kończy się niepowodzeniem
+             */
+            SearchBudget *budget;
+        };
+
+        /**
+         * @brief zapis uszczegóławiania jednego grafu (wzorca), pozwalający
+         * pokolorować inny graf tak, jak zrobiłoby to
+         * \ref ColourRefinement::refineJoint
+         *
+         * Dla klas początkowych zapisywane są pary (kolor, liczność), a dla
+         * każdego przejścia rozdzielacza - trójki (klasa, liczba sąsiadów
+         * w rozdzielaczu, liczność) w kolejności klas i liczb. Graf, którego
+         * przejścia dają te same trójki, dzieli się dokładnie tak jak wzorzec,
+         * a przy kolorowaniu wspólnym każda część miałaby tyle samo
+         * wierzchołków obu grafów.
+         */
+        struct Trace
+        {
+            Trace(): vertex_count(0), colour_count(0) {};
+
+            /**
+             * @brief liczba wierzchołków wzorca
+             */
+            unsigned int vertex_count;
+
+            /**
+             * @brief liczba kolorów stabilnych wzorca
+             */
+            unsigned int colour_count;
+
+            /**
+             * @brief pary (kolor początkowy, liczność) klas początkowych
+             */
+            std::vector<unsigned int> initial;
+
+            /**
+             * @brief trójki wszystkich przejść
+             */
+            std::vector<unsigned int> splits;
+
+            /**
+             * @brief trójki przejścia k to splits[pass_begin[k]] ..
+             * splits[pass_begin[k + 1] - 1]
+             */
+            std::vector<size_t> pass_begin;
+        };
+
+        /**
+         * @brief uszczegółów kolorowanie jednego grafu do stabilnego
+         *
+         * @param g graf
+         * @param colours kolory początkowe (dowolne liczby), nadpisywane
+         * kolorami stabilnymi 0..k-1
+         *
+         * @return liczba kolorów k
+         */
+        static unsigned int refine(const FrozenGraph &g, colouring_t &colours);
+
+        /**
+         * @brief \ref ColourRefinement::refine zostawiające podział stabilny
+         * w tablicach roboczych
+         *
+         * @param g graf
+         * @param colours kolory początkowe, nadpisywane kolorami stabilnymi
+         * @param work tablice robocze
+         *
+         * @return liczba kolorów
+         */
+        static unsigned int refine(const FrozenGraph &g, colouring_t &colours,
+                Workspace &work);
+
+        /**
+         * @brief indywidualizuj wierzchołek i uszczegółów podział stabilny
+         *
+         * Wierzchołek \p v dostaje własną klasę za resztą swojej dawnej
+         * klasy, a rozdzielaczem jest tylko ta nowa klasa - koszt zależy od
+         * tego, co się zmieniło, a nie od rozmiaru grafu. Podział jest taki
+         * sam jak z \ref ColourRefinement::refine od kolorów, w których
+         * \p v ma kolor różny od reszty swojej klasy.
+         *
+         * @param g graf
+         * @param v indywidualizowany wierzchołek
+         * @param colours wynik - kolory stabilne
+         * @param work podział stabilny grafu \p g (z
+         * \ref ColourRefinement::refine lub poprzedniego wywołania),
+         * nadpisywany nowym
+         *
+         * @return liczba kolorów
+         */
+        static unsigned int individualize(const FrozenGraph &g,
+                FrozenGraph::idx_t v, colouring_t &colours, Workspace &work);
+
+        /**
+         * @brief uszczegółów jednocześnie kolorowania dwóch grafów
+         *
+         * Kolory obu grafów pochodzą z jednej palety. Przerywa przy
+         * pierwszym podziale, po którym któraś klasa ma różną liczbę
+         * wierzchołków obu grafów.
+         *
+         * @param gX graf X
+         * @param gY graf Y
+         * @param coloursX kolory początkowe wierzchołków grafu X
+         * @param coloursY kolory początkowe wierzchołków grafu Y
+         * @param colour_count liczba kolorów stabilnych
+         *
+         * @return czy histogramy kolorów obu grafów są równe
+         */
+        static bool refineJoint(const FrozenGraph &gX, const FrozenGraph &gY,
+                colouring_t &coloursX, colouring_t &coloursY,
+                unsigned int &colour_count);
+
+        /**
+         * @brief \ref ColourRefinement::refineJoint z tablicami roboczymi
+         * wywołującego
+         *
+         * @param gX graf X
+         * @param gY graf Y
+         * @param coloursX kolory początkowe wierzchołków grafu X
+         * @param coloursY kolory początkowe wierzchołków grafu Y
+         * @param colour_count liczba kolorów stabilnych
+         * @param work tablice robocze
+         *
+         * @return czy histogramy kolorów obu grafów są równe (false także
+         * po wyczerpaniu \ref Workspace::budget)
+         */
+        static bool refineJoint(const FrozenGraph &gX, const FrozenGraph &gY,
+                colouring_t &coloursX, colouring_t &coloursY,
+                unsigned int &colour_count, Workspace &work);
+
+        /**
+         * @brief uszczegółów kolorowanie wzorca i zapisz przebieg
+         *
+         * Kolory są takie same jak z \ref ColourRefinement::refine, ale
+         * kolejka jest przetwarzana do końca także po osiągnięciu podziału
+         * dyskretnego - tak jak przy kolorowaniu wspólnym.
+         *
+         * @param g graf wzorca
+         * @param colours kolory początkowe, nadpisywane kolorami stabilnymi
+         * @param trace zapis przebiegu
+         *
+         * @return liczba kolorów
+         */
+        static unsigned int refineTraced(const FrozenGraph &g,
+                colouring_t &colours, Trace &trace);
+
+        /**
+         * @brief pokoloruj graf według zapisu wzorca
+         *
+         * Wynik jest taki sam jak kolory grafu Y z
+         * \ref ColourRefinement::refineJoint dla pary (wzorzec, \p g),
+         * bez ponownego uszczegóławiania wzorca: graf jest dzielony sam,
+         * a każde przejście rozdzielacza porównywane z zapisem.
+         *
+         * @param trace zapis z \ref ColourRefinement::refineTraced
+         * @param g kolorowany graf
+         * @param colours kolory początkowe (jak dla wzorca), nadpisywane
+         * kolorami stabilnymi
+         * @param colour_count liczba kolorów stabilnych
+         * @param work tablice robocze
+         *
+         * @return czy klasy początkowe i każde przejście były zgodne ze
+         * wzorcem (false także po wyczerpaniu \ref Workspace::budget)
+         */
+        static bool refineByTrace(const Trace &trace, const FrozenGraph &g,
+                colouring_t &colours, unsigned int &colour_count,
+                Workspace &work);
+
+    private:
+        /**
+         * @brief jednocześnie kolorowane grafy wraz z ich kolorami
+         */
+        struct Part
+        {
+            /**
+             * @brief graf
+             */
+            const FrozenGraph *graph;
+
+            /**
+             * @brief kolory wierzchołków grafu
+             */
+            colouring_t *colours;
+        };
+
+        /**
+         * @brief tryb uszczegóławiania
+         */
+        struct Mode
+        {
+            Mode(): discrete_stop(false), record(NULL), replay(NULL),
+                replay_pass(0) {};
+
+            /**
+             * @brief czy zakończyć po osiągnięciu podziału dyskretnego
+             */
+            bool discrete_stop;
+
+            /**
+             * @brief zapis przebiegu (NULL - bez zapisu)
+             */
+            Trace *record;
+
+            /**
+             * @brief porównywany zapis (NULL - bez porównania)
+             */
+            const Trace *replay;
+
+            /**
+             * @brief numer następnego porównywanego przejścia
+             */
+            size_t replay_pass;
+        };
+
+        /**
+         * @brief ułóż podział początkowy według kolorów i wstaw wszystkie
+         * klasy do kolejki
+         *
+         * @param parts tablica grafów
+         * @param part_count liczba grafów (1 lub 2)
+         * @param work tablice robocze
+         * @param mode tryb
+         *
+         * @return czy klasy są zrównoważone (dwa grafy) i zgodne z zapisem
+         */
+        static bool layout(Part *parts, unsigned int part_count,
+                Workspace &work, Mode &mode);
+
+        /**
+         * @brief przetwarzaj kolejkę rozdzielaczy
+         *
+         * @param parts tablica grafów
+         * @param part_count liczba grafów
+         * @param work tablice robocze
+         * @param mode tryb
+         *
+         * @return czy wszystkie części były zrównoważone i zgodne z zapisem,
+         * a limity nie zostały wyczerpane
+         */
+        static bool run(Part *parts, unsigned int part_count,
+                Workspace &work, Mode &mode);
+
+        /**
+         * @brief podziel klasy według liczby sąsiadów w rozdzielaczu
+         *
+         * @param parts tablica grafów
+         * @param part_count liczba grafów
+         * @param work tablice robocze (rozdzielacz w
+         * \ref Workspace::splitter)
+         * @param forward true - liczba następników w rozdzielaczu, false -
+         * liczba poprzedników
+         * @param mode tryb
+         *
+         * @return czy części były zrównoważone i zgodne z zapisem
+         */
+        static bool split(Part *parts, unsigned int part_count,
+                Workspace &work, bool forward, Mode &mode);
+
+        /**
+         * @brief przepisz numery klas (w kolejności pozycji) jako kolory
+         *
+         * @param parts tablica grafów
+         * @param part_count liczba grafów
+         * @param work tablice robocze
+         *
+         * @return liczba kolorów
+         */
+        static unsigned int collect(Part *parts, unsigned int part_count,
+                Workspace &work);
+};
+
+#endif /* end of include guard: COLOURREFINEMENT_HPP */
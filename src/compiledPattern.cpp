@@ -0,0 +1,68 @@
+/**
+ *      @file  compiledPattern.cpp
+ *     @brief  implementacja metod klasy CompiledPattern
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <thread>
+
+#include "compiledPattern.hpp"
+#include "isomorphismAlgo.hpp"
+#include "isoSolver.hpp"
+
+CompiledPattern::CompiledPattern(const FrozenGraph &_graph):
+    graph(_graph)
+{
+    IsomorphismAlgo algo;
+    algo.bind(_graph, _graph);
+    algo.compile(*this);
+}
+
+void CompiledPattern::matchAll(const std::vector<const FrozenGraph *> &targets,
+        std::vector<IsoResult> &results, unsigned int threads,
+        const SearchLimits &limits) const
+{
+    using std::vector;
+    using std::thread;
+    using std::atomic;
+
+    results.assign(targets.size(), ISO_UNKNOWN);
+
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+    }
+    if (threads > targets.size()) {
+        threads = targets.size();
+    }
+
+    atomic<size_t> next(0);
+    if (threads <= 1) {
+        this->matchWorker(&targets, &results, &limits, &next);
+        return;
+    }
+
+    vector<thread> pool;
+    pool.reserve(threads);
+    for(unsigned int w = 0; w < threads; ++w) {
+        pool.push_back(thread(&CompiledPattern::matchWorker, this, &targets,
+                    &results, &limits, &next));
+    }
+    for(unsigned int w = 0; w < threads; ++w) {
+        pool[w].join();
+    }
+}
+
+void CompiledPattern::matchWorker(
+        const std::vector<const FrozenGraph *> *targets,
+        std::vector<IsoResult> *results, const SearchLimits *limits,
+        std::atomic<size_t> *next) const
+{
+    IsoSolver solver;
+    for(size_t t = next->fetch_add(1); t < targets->size();
+            t = next->fetch_add(1)) {
+        (*results)[t] = solver.solve(*this, *(*targets)[t], *limits);
+    }
+}
@@ -0,0 +1,139 @@
+/**
+ *      @file  compiledPattern.hpp
+ *     @brief  plik nagłówkowy klasy CompiledPattern
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy CompiledPattern - grafu wzorca z wyznaczonymi raz
+ * krokami przygotowawczymi algorytmu \ref IsomorphismAlgo, porównywanego
+ * z wieloma grafami
+ *
+ *=====================================================================================
+ */
+
+#ifndef COMPILEDPATTERN_HPP
+#define COMPILEDPATTERN_HPP
+
+#include <vector>
+#include <atomic>
+
+#include "frozenGraph.hpp"
+#include "colourRefinement.hpp"
+#include "searchLimits.hpp"
+
+/**
+ * @brief klasa przechowuje kroki przygotowawcze algorytmu
+ * \ref IsomorphismAlgo zależne tylko od grafu X
+ *
+ * Histogram 'stopni' (invariant), zapis uszczegóławiania kolorów
+ * (\ref ColourRefinement::Trace), kolory stabilne, numeracja DFS
+ * i posortowane krawędzie grafu X wyznaczane są raz, w konstruktorze.
+ * Weryfikacja z kolejnym grafem Y (\ref IsoSolver::solve ze wzorcem)
+ * liczy już tylko to, co zależy od Y: histogram 'stopni' i kolory Y
+ * według zapisu wzorca. Wynik i przekształcenie są takie same jak dla
+ * \ref IsomorphismAlgo na parze (X, Y).
+ *
+ * Po utworzeniu obiekt się nie zmienia, więc może być współdzielony przez
+ * wiele wątków (\ref CompiledPattern::matchAll).
+ */
+class CompiledPattern
+{
+    friend class IsomorphismAlgo;
+
+    public:
+        /**
+         * @brief skompiluj wzorzec
+         *
+         * Graf nie jest kopiowany, musi istnieć przez cały czas życia
+         * obiektu.
+         *
+         * @param _graph graf wzorca (X)
+         */
+        explicit CompiledPattern(const FrozenGraph &_graph);
+
+        /**
+         * @brief graf wzorca
+         *
+         * @return referencja na graf
+         */
+        const FrozenGraph &getGraph() const {return this->graph;};
+
+        /**
+         * @brief liczba kolorów stabilnych wzorca
+         *
+         * @return liczba kolorów
+         */
+        unsigned int getColourCount() const {return this->colour_size.size();};
+
+        /**
+         * @brief zweryfikuj izomorfizm wzorca z każdym z grafów
+         *
+         * Grafy rozdzielane są dynamicznie między wątki, każdy z własnym
+         * \ref IsoSolver. Limit węzłów i flaga przerwania dotyczą każdej
+         * weryfikacji osobno, termin - całej serii.
+         *
+         * @param targets grafy Y
+         * @param results wynik dla każdego grafu
+         * @param threads liczba wątków (0 - liczba rdzeni)
+         * @param limits limity przeszukiwania
+         */
+        void matchAll(const std::vector<const FrozenGraph *> &targets,
+                std::vector<IsoResult> &results, unsigned int threads = 1,
+                const SearchLimits &limits = SearchLimits()) const;
+
+    private:
+        /**
+         * @brief graf wzorca
+         */
+        const FrozenGraph &graph;
+
+        /**
+         * @brief posortowane 'stopnie' (invariant) wierzchołków wzorca
+         */
+        std::vector<unsigned int> inv_hist;
+
+        /**
+         * @brief zapis uszczegóławiania kolorów wzorca
+         */
+        ColourRefinement::Trace trace;
+
+        /**
+         * @brief stabilne kolory wierzchołków wzorca
+         */
+        ColourRefinement::colouring_t colours;
+
+        /**
+         * @brief liczba wierzchołków wzorca w każdym z kolorów
+         */
+        std::vector<unsigned int> colour_size;
+
+        /**
+         * @brief numer DFS każdego wierzchołka wzorca
+         */
+        std::vector<int> dfs_num;
+
+        /**
+         * @brief wierzchołki wzorca w kolejności numerów DFS
+         */
+        std::vector<FrozenGraph::idx_t> dfs_vec;
+
+        /**
+         * @brief krawędzie wzorca w kolejności przeszukiwania
+         */
+        std::vector<FrozenGraph::Edge> ordered_edges;
+
+        /**
+         * @brief wątek \ref CompiledPattern::matchAll - weryfikuj kolejne
+         * nieprzydzielone grafy
+         *
+         * @param targets grafy Y
+         * @param results wyniki
+         * @param limits limity przeszukiwania
+         * @param next numer następnego nieprzydzielonego grafu
+         */
+        void matchWorker(const std::vector<const FrozenGraph *> *targets,
+                std::vector<IsoResult> *results, const SearchLimits *limits,
+                std::atomic<size_t> *next) const;
+};
+
+#endif /* end of include guard: COMPILEDPATTERN_HPP */
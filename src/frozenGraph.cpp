@@ -0,0 +1,739 @@
+/**
+ *      @file  frozenGraph.cpp
+ *     @brief  implementacja metod klasy FrozenGraph
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <fstream>
+#include <cstring>
+
+#include "frozenGraph.hpp"
+
+typedef FrozenGraph::idx_t idx_t;
+typedef Graph::label_t label_t;
+
+namespace {
+
+/**
+ * @brief nagłówek pliku binarnego z grafem (24 bajty, bez wyrównania)
+ */
+struct BinaryHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t vertex_count;
+    uint32_t edge_count;
+};
+
+/**
+ * @brief sprawdź tablice CSR wczytane z pliku: przesunięcia rosną od 0
+ * do m, wiersze są ściśle rosnące i zawierają indeksy < n
+ */
+void checkCsr(const unsigned int *offsets, const idx_t *adj,
+        unsigned int n, unsigned int m)
+{
+    using std::invalid_argument;
+
+    if (offsets[0] != 0 || offsets[n] != m) {
+        throw invalid_argument("Uszkodzony plik binarny: złe przesunięcia CSR");
+    }
+    // całą tablicę przesunięć sprawdzamy przed pierwszym odczytem adj,
+    // inaczej wiersz kończący się za m czytałby poza danymi pliku
+    for(idx_t v = 0; v < n; ++v) {
+        if (offsets[v] > offsets[v + 1] || offsets[v + 1] > m) {
+            throw invalid_argument("Uszkodzony plik binarny: złe przesunięcia CSR");
+        }
+    }
+    for(idx_t v = 0; v < n; ++v) {
+        for(unsigned int i = offsets[v]; i < offsets[v + 1]; ++i) {
+            if (adj[i] >= n || (i > offsets[v] && adj[i - 1] >= adj[i])) {
+                throw invalid_argument("Uszkodzony plik binarny: zła lista sąsiedztwa");
+            }
+        }
+    }
+}
+
+/**
+ * @brief losowa liczba z przedziału [0, bound)
+ *
+ * Obciążenie reszty z dzielenia jest pomijalne - generator daje 64 bity,
+ * a bound < 2^32.
+ */
+idx_t randomBelow(RandomEngine &engine, idx_t bound)
+{
+    return engine() % bound;
+}
+
+/**
+ * @brief liczba prób do pierwszego sukcesu (bez niego) w ciągu prób
+ * Bernoulliego z prawdopodobieństwem p, 0 < p < 1
+ */
+uint64_t geometricSkip(RandomEngine &engine, double p)
+{
+    // 53 bity - liczba z przedziału [0, 1)
+    double r = (engine() >> 11) * (1.0 / 9007199254740992.0);
+    double skip = std::floor(std::log1p(-r) / std::log1p(-p));
+    return skip < 9.0e18 ? (uint64_t) skip : UINT64_MAX / 2;
+}
+
+}
+
+/* CONSTRUCTOR */
+FrozenGraph::FrozenGraph():
+    vertex_count(0), edge_count(0), inv_power(1), out_offsets(1, 0),
+    in_offsets(1, 0), row_words(0)
+{
+    this->bindArrays();
+}
+
+FrozenGraph::FrozenGraph(const Graph &g):
+    vertex_count(0), edge_count(0), inv_power(1), out_offsets(1, 0),
+    in_offsets(1, 0), row_words(0)
+{
+    this->freeze(g);
+}
+
+FrozenGraph::FrozenGraph(const FrozenGraph &other):
+    FrozenGraph()
+{
+    *this = other;
+}
+
+FrozenGraph &FrozenGraph::operator=(const FrozenGraph &other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    this->vertex_count = other.vertex_count;
+    this->edge_count = other.edge_count;
+    this->inv_power = other.inv_power;
+    this->labels = other.labels;
+    this->out_offsets = other.out_offsets;
+    this->out_adj = other.out_adj;
+    this->in_offsets = other.in_offsets;
+    this->in_adj = other.in_adj;
+    this->row_words = other.row_words;
+    this->out_bits = other.out_bits;
+    this->in_bits = other.in_bits;
+
+    this->mapping = other.mapping;
+    if (this->mapping) {
+        // odwzorowanie jest współdzielone, wskaźniki pozostają ważne
+        this->label_data = other.label_data;
+        this->out_offset_data = other.out_offset_data;
+        this->out_adj_data = other.out_adj_data;
+        this->in_offset_data = other.in_offset_data;
+        this->in_adj_data = other.in_adj_data;
+    }
+    else {
+        this->bindArrays();
+    }
+    return *this;
+}
+
+void FrozenGraph::bindArrays()
+{
+    this->label_data = this->labels.data();
+    this->out_offset_data = this->out_offsets.data();
+    this->out_adj_data = this->out_adj.data();
+    this->in_offset_data = this->in_offsets.data();
+    this->in_adj_data = this->in_adj.data();
+}
+
+void FrozenGraph::freeze(const Graph &g)
+{
+    using std::sort;
+    using std::vector;
+
+    typedef std::map<Graph::label_t, Vertex::idx_t> labelMap;
+
+    this->labels.clear();
+    this->labels.reserve(g.getVertexCount());
+
+    // indeks wierzchołka w Graph -> pozycja w porządku znaczników, żeby
+    // sąsiadów nie wyszukiwać w mapach
+    vector<idx_t> position(g.vertexes.empty() ? 0 :
+            g.vertexes.rbegin()->first + 1);
+    vector<const Vertex *> vertex;
+    vertex.reserve(g.getVertexCount());
+    for(labelMap::const_iterator it = g.label_idx_map.begin();
+            it != g.label_idx_map.end(); ++it) {
+        position[it->second] = this->labels.size();
+        this->labels.push_back(it->first);
+        vertex.push_back(&g.vertexes.at(it->second));
+    }
+
+    this->out_offsets.clear();
+    this->out_offsets.reserve(g.getVertexCount() + 1);
+    this->out_offsets.push_back(0);
+
+    this->out_adj.clear();
+    this->out_adj.reserve(g.getEdgeCount());
+
+    for(size_t v = 0; v < vertex.size(); ++v) {
+        size_t rowStart = this->out_adj.size();
+        for(Vertex::iterator it = vertex[v]->begin();
+                it != vertex[v]->end(); ++it) {
+            this->out_adj.push_back(position[*it]);
+        }
+        sort(this->out_adj.begin() + rowStart, this->out_adj.end());
+        this->out_offsets.push_back(this->out_adj.size());
+    }
+
+    this->finishBuild();
+}
+
+void FrozenGraph::finishBuild()
+{
+    this->mapping.reset();
+    this->vertex_count = this->labels.size();
+    this->edge_count = this->out_adj.size();
+    this->inv_power = pow(10, ceil(log10(this->vertex_count + 1)));
+
+    this->bindArrays();
+    this->buildPredecessors();
+    this->bindArrays();
+    this->buildBitMatrix();
+}
+
+void FrozenGraph::buildPredecessors()
+{
+    unsigned int n = this->vertex_count;
+
+    this->in_offsets.assign(n + 1, 0);
+    for(std::vector<idx_t>::const_iterator it = this->out_adj.begin();
+            it != this->out_adj.end(); ++it) {
+        ++this->in_offsets[(*it) + 1];
+    }
+    for(idx_t v = 0; v < n; ++v) {
+        this->in_offsets[v + 1] += this->in_offsets[v];
+    }
+
+    // wiersze są przechodzone rosnąco, więc listy poprzedników
+    // wychodzą od razu posortowane
+    std::vector<unsigned int> fill(this->in_offsets.begin(),
+            this->in_offsets.end() - 1);
+    this->in_adj.resize(this->out_adj.size());
+    for(idx_t v = 0; v < n; ++v) {
+        for(adj_iterator it = this->adjBegin(v); it != this->adjEnd(v); ++it) {
+            this->in_adj[fill[*it]++] = v;
+        }
+    }
+}
+
+void FrozenGraph::buildBitMatrix()
+{
+    unsigned long n = this->vertex_count;
+
+    this->row_words = (n + 63) / 64;
+    this->out_bits.clear();
+    this->in_bits.clear();
+
+    if (n == 0 || n > BITMATRIX_MAX_VERTICES ||
+            this->edge_count < BITMATRIX_MIN_DENSITY * n * n) {
+        return;
+    }
+
+    this->out_bits.assign(n * this->row_words, 0);
+    this->in_bits.assign(n * this->row_words, 0);
+
+    for(idx_t v = 0; v < n; ++v) {
+        for(adj_iterator it = this->adjBegin(v); it != this->adjEnd(v); ++it) {
+            setBit(&this->out_bits[v * this->row_words], *it);
+            setBit(&this->in_bits[(*it) * this->row_words], v);
+        }
+    }
+}
+
+unsigned int FrozenGraph::countCommon(const word_t *a, const word_t *b,
+        unsigned int words)
+{
+    unsigned int counter = 0;
+    for(unsigned int i = 0; i < words; ++i) {
+        counter += __builtin_popcountll(a[i] & b[i]);
+    }
+    return counter;
+}
+
+/* GETTERS */
+idx_t FrozenGraph::getIndex(label_t label) const
+{
+    using std::lower_bound;
+    using std::out_of_range;
+
+    const label_t *end = this->label_data + this->vertex_count;
+    const label_t *it = lower_bound(this->label_data, end, label);
+
+    if (it == end || (*it) != label) {
+        throw out_of_range("Brak wierzchołka o podanym znaczniku");
+    }
+    return it - this->label_data;
+}
+
+unsigned int FrozenGraph::getOut(idx_t v, const vertex_set_t &vset) const
+{
+    unsigned int counter = 0;
+    for(adj_iterator it = this->adjBegin(v); it != this->adjEnd(v); ++it) {
+        if (vset.count(*it)) {
+            ++counter;
+        }
+    }
+    return counter;
+}
+
+unsigned int FrozenGraph::getIn(idx_t v, const vertex_set_t &vset) const
+{
+    unsigned int counter = 0;
+    for(adj_iterator it = this->predBegin(v); it != this->predEnd(v); ++it) {
+        if (vset.count(*it)) {
+            ++counter;
+        }
+    }
+    return counter;
+}
+
+unsigned int FrozenGraph::getOut(idx_t v, const vertex_bits_t &vset) const
+{
+    if (this->hasBitMatrix()) {
+        return countCommon(&this->out_bits[v * this->row_words], vset.data(),
+                this->row_words);
+    }
+
+    unsigned int counter = 0;
+    for(adj_iterator it = this->adjBegin(v); it != this->adjEnd(v); ++it) {
+        if (testBit(vset.data(), *it)) {
+            ++counter;
+        }
+    }
+    return counter;
+}
+
+unsigned int FrozenGraph::getIn(idx_t v, const vertex_bits_t &vset) const
+{
+    if (this->hasBitMatrix()) {
+        return countCommon(&this->in_bits[v * this->row_words], vset.data(),
+                this->row_words);
+    }
+
+    unsigned int counter = 0;
+    for(adj_iterator it = this->predBegin(v); it != this->predEnd(v); ++it) {
+        if (testBit(vset.data(), *it)) {
+            ++counter;
+        }
+    }
+    return counter;
+}
+
+unsigned int FrozenGraph::getEdges(std::vector<Edge> &edges) const
+{
+    edges.reserve(edges.size() + this->edge_count);
+    for(idx_t v = 0; v < this->vertex_count; ++v) {
+        for(adj_iterator it = this->adjBegin(v); it != this->adjEnd(v); ++it) {
+            edges.push_back(Edge(v, *it));
+        }
+    }
+    return this->edge_count;
+}
+
+void FrozenGraph::getDFSPath(dfs_path &path, idx_t start, dfs_visited &visited) const
+{
+    dfs_path stack;
+
+    path.clear();
+    this->appendDFSPath(path, start, visited, stack);
+}
+
+void FrozenGraph::appendDFSPath(dfs_path &path, idx_t start,
+        dfs_visited &visited, dfs_path &stack) const
+{
+    if (visited[start]) {
+        return;
+    }
+
+    stack.push_back(start);
+    visited[start] = true;
+
+    while(!stack.empty()) {
+        idx_t parent = stack.back(); stack.pop_back();
+        path.push_back(parent);
+
+        for(adj_iterator it = this->adjBegin(parent);
+                it != this->adjEnd(parent); ++it) {
+            if (!visited[*it]) {
+                stack.push_back(*it);
+                visited[*it] = true;
+            }
+        }
+    }
+}
+
+std::string FrozenGraph::getInfo() const
+{
+    using std::string;
+    using std::endl;
+    using std::stringstream;
+
+    stringstream ss;
+
+    ss << "Vertexes:" << this->getVertexCount() << endl;
+    ss << "Edges   :" << this->getEdgeCount() << endl;
+    ss << string(80, '-') << endl;
+
+    for(idx_t v = 0; v < this->vertex_count; ++v) {
+        ss << "(" << this->getLabel(v) << ") -> ";
+        ss << "[" << v << "]";
+        ss << "{" << this->getOut(v) << "/" << this->getIn(v) << "}";
+        ss << "|";
+        for(adj_iterator it = this->adjBegin(v); it != this->adjEnd(v); ++it) {
+            ss << (*it) << ", ";
+        }
+        ss << "|" << endl;
+    }
+    ss << string(80, '-') << endl;
+    return ss.str();
+}
+
+/* CHECKERS */
+bool FrozenGraph::isNode(label_t label) const
+{
+    return std::binary_search(this->label_data,
+            this->label_data + this->vertex_count, label);
+}
+
+bool FrozenGraph::isConnection(idx_t v, idx_t w, const vertex_set_t &vset) const
+{
+    if (!vset.count(v)) {
+        return false;
+    } else if (!vset.count(w)) {
+        return false;
+    }
+    return this->isConnection(v, w);
+}
+
+/* GENERATORS */
+FrozenGraph FrozenGraph::generateRandom(unsigned int vertex_count,
+        double density, RandomEngine &engine)
+{
+    using std::vector;
+    using std::sort;
+    using std::invalid_argument;
+
+    if (vertex_count < 1) {
+        throw invalid_argument("Liczba wierzchołków musi być większa od 1");
+    }
+
+    if (density <= 0 || density > 1) {
+        throw invalid_argument("Gęstość musi należeć do przedziału (0, 1]");
+    }
+
+    unsigned int n = vertex_count;
+
+    // drzewo rozpinające: błądzenie losowe z usuwaniem pętli (Wilson),
+    // successor[v] to ostatni krok z v przed wejściem do drzewa
+    vector<idx_t> successor(n, NO_VERTEX);
+    vector<bool> in_tree(n, false);
+    in_tree[randomBelow(engine, n)] = true;
+    for(idx_t i = 0; i < n; ++i) {
+        idx_t v = i;
+        while (!in_tree[v]) {
+            successor[v] = randomBelow(engine, n);
+            v = successor[v];
+        }
+        for(v = i; !in_tree[v]; v = successor[v]) {
+            in_tree[v] = true;
+        }
+    }
+
+    // krawędzie drzewa w losowym kierunku, pogrupowane według źródła
+    vector<unsigned int> tree_offsets(n + 1, 0);
+    vector<idx_t> tree_source(n, NO_VERTEX);
+    for(idx_t v = 0; v < n; ++v) {
+        if (successor[v] != NO_VERTEX) {
+            tree_source[v] = (engine() >> 63) ? v : successor[v];
+            ++tree_offsets[tree_source[v] + 1];
+        }
+    }
+    for(idx_t v = 0; v < n; ++v) {
+        tree_offsets[v + 1] += tree_offsets[v];
+    }
+    vector<idx_t> tree_adj(tree_offsets[n]);
+    vector<unsigned int> fill(tree_offsets.begin(), tree_offsets.end() - 1);
+    for(idx_t v = 0; v < n; ++v) {
+        if (tree_source[v] != NO_VERTEX) {
+            idx_t w = (tree_source[v] == v) ? successor[v] : v;
+            tree_adj[fill[tree_source[v]]++] = w;
+        }
+    }
+
+    // prawdopodobieństwo krawędzi spoza drzewa: oczekiwana liczba
+    // wszystkich krawędzi to density * n * (n - 1)
+    uint64_t pairs = (uint64_t) n * (n - 1);
+    double target = density * pairs;
+    double p = 0.0;
+    if (pairs > n - 1) {
+        p = (target - (n - 1)) / (double) (pairs - (n - 1));
+    }
+    p = std::max(0.0, std::min(1.0, p));
+    bool dense = p > 0.5;
+    double q = dense ? 1.0 - p : p;
+
+    // kolejny wylosowany numer pary (v, w) w porządku wierszowym; pary
+    // w wierszu v numerowane są pominięciem w = v
+    uint64_t next = UINT64_MAX;
+    if (q > 0.0) {
+        next = geometricSkip(engine, q);
+    }
+
+    FrozenGraph g;
+    g.labels.resize(n);
+    for(idx_t v = 0; v < n; ++v) {
+        g.labels[v] = v + 1;
+    }
+    g.out_offsets.assign(1, 0);
+    g.out_offsets.reserve(n + 1);
+    g.out_adj.reserve((size_t) target + n);
+
+    vector<idx_t> row;
+    for(idx_t v = 0; v < n; ++v) {
+        uint64_t row_begin = (uint64_t) v * (n - 1);
+        uint64_t row_end = row_begin + (n - 1);
+
+        row.clear();
+        if (!dense) {
+            for(; next < row_end; next += 1 + geometricSkip(engine, q)) {
+                idx_t c = next - row_begin;
+                row.push_back(c < v ? c : c + 1);
+            }
+        }
+        else {
+            // wszystkie pary wiersza poza wylosowanymi do pominięcia
+            for(uint64_t i = row_begin; i < row_end; ++i) {
+                if (i == next) {
+                    next += 1 + (q > 0.0 ? geometricSkip(engine, q) : 0);
+                    continue;
+                }
+                idx_t c = i - row_begin;
+                row.push_back(c < v ? c : c + 1);
+            }
+        }
+
+        // scalenie z krawędziami drzewa, bez powtórzeń
+        idx_t *tree_begin = tree_adj.data() + tree_offsets[v];
+        idx_t *tree_end = tree_adj.data() + tree_offsets[v + 1];
+        sort(tree_begin, tree_end);
+        vector<idx_t>::const_iterator it = row.begin();
+        while (it != row.end() || tree_begin != tree_end) {
+            idx_t w;
+            if (tree_begin == tree_end ||
+                    (it != row.end() && *it < *tree_begin)) {
+                w = *(it++);
+            }
+            else {
+                w = *(tree_begin++);
+                if (it != row.end() && *it == w) {
+                    ++it;
+                }
+            }
+            g.out_adj.push_back(w);
+        }
+        g.out_offsets.push_back(g.out_adj.size());
+    }
+
+    g.finishBuild();
+    return g;
+}
+
+FrozenGraph FrozenGraph::randomIsomorphic(RandomEngine &engine) const
+{
+    using std::vector;
+    using std::sort;
+
+    unsigned int n = this->vertex_count;
+
+    // perm[v] - nowy indeks wierzchołka v
+    vector<idx_t> perm(n);
+    for(idx_t v = 0; v < n; ++v) {
+        perm[v] = v;
+    }
+    std::shuffle(perm.begin(), perm.end(), engine);
+    vector<idx_t> inverse(n);
+    for(idx_t v = 0; v < n; ++v) {
+        inverse[perm[v]] = v;
+    }
+
+    FrozenGraph g;
+    g.labels.assign(this->label_data, this->label_data + n);
+    g.out_offsets.assign(1, 0);
+    g.out_offsets.reserve(n + 1);
+    g.out_adj.reserve(this->edge_count);
+    for(idx_t u = 0; u < n; ++u) {
+        idx_t v = inverse[u];
+        size_t row_start = g.out_adj.size();
+        for(adj_iterator it = this->adjBegin(v); it != this->adjEnd(v); ++it) {
+            g.out_adj.push_back(perm[*it]);
+        }
+        sort(g.out_adj.begin() + row_start, g.out_adj.end());
+        g.out_offsets.push_back(g.out_adj.size());
+    }
+
+    g.finishBuild();
+    return g;
+}
+
+/* INPUT/OUTPUT */
+void FrozenGraph::saveBinary(const std::string &filename) const
+{
+    using std::ofstream;
+    using std::runtime_error;
+
+    BinaryHeader header;
+    memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+    header.version = BINARY_VERSION;
+    header.byte_order = BINARY_BYTE_ORDER;
+    header.vertex_count = this->vertex_count;
+    header.edge_count = this->edge_count;
+
+    ofstream file(filename.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        throw runtime_error("Nie udało się otworzyć pliku do zapisu");
+    }
+
+    size_t n = this->vertex_count, m = this->edge_count;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(this->label_data),
+            n * sizeof(label_t));
+    file.write(reinterpret_cast<const char *>(this->out_offset_data),
+            (n + 1) * sizeof(unsigned int));
+    file.write(reinterpret_cast<const char *>(this->out_adj_data),
+            m * sizeof(idx_t));
+    file.write(reinterpret_cast<const char *>(this->in_offset_data),
+            (n + 1) * sizeof(unsigned int));
+    file.write(reinterpret_cast<const char *>(this->in_adj_data),
+            m * sizeof(idx_t));
+    file.close();
+
+    if (file.fail()) {
+        throw runtime_error("Nie udało się zapisać pliku");
+    }
+}
+
+void FrozenGraph::loadBinary(const std::string &filename)
+{
+    std::shared_ptr<const MappedFile> file =
+        std::make_shared<const MappedFile>(filename);
+    this->loadBinaryData(file, file->getData(), file->getSize());
+}
+
+void FrozenGraph::loadBinary(std::vector<char> &&data)
+{
+    std::shared_ptr<const std::vector<char> > buffer =
+        std::make_shared<const std::vector<char> >(std::move(data));
+    this->loadBinaryData(buffer, buffer->data(), buffer->size());
+}
+
+void FrozenGraph::loadBinaryData(std::shared_ptr<const void> owner,
+        const char *data, size_t size)
+{
+    using std::vector;
+    using std::invalid_argument;
+
+    BinaryHeader header;
+    if (size < sizeof(header)) {
+        throw invalid_argument("Plik jest za krótki na nagłówek grafu binarnego");
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, BINARY_MAGIC, sizeof(header.magic)) != 0) {
+        throw invalid_argument("Plik nie jest grafem w formacie binarnym");
+    }
+    if (header.version != BINARY_VERSION) {
+        throw invalid_argument("Nieobsługiwana wersja formatu binarnego");
+    }
+    if (header.byte_order != BINARY_BYTE_ORDER) {
+        throw invalid_argument("Plik zapisano przy innej kolejności bajtów");
+    }
+
+    uint64_t n = header.vertex_count, m = header.edge_count;
+    uint64_t expected = sizeof(header) + sizeof(uint32_t) * (3 * n + 2 + 2 * m);
+    if (size != expected) {
+        throw invalid_argument("Rozmiar pliku binarnego nie zgadza się z nagłówkiem");
+    }
+
+    // tablice leżą kolejno za nagłówkiem, wyrównane do 4 bajtów
+    const uint32_t *words =
+        reinterpret_cast<const uint32_t *>(data + sizeof(header));
+    const label_t *labels_in = words;
+    const unsigned int *out_offsets_in = labels_in + n;
+    const idx_t *out_adj_in = out_offsets_in + n + 1;
+    const unsigned int *in_offsets_in = out_adj_in + m;
+    const idx_t *in_adj_in = in_offsets_in + n + 1;
+
+    for(idx_t v = 1; v < n; ++v) {
+        if (labels_in[v - 1] >= labels_in[v]) {
+            throw invalid_argument("Uszkodzony plik binarny: znaczniki nie są rosnące");
+        }
+    }
+    checkCsr(out_offsets_in, out_adj_in, n, m);
+    checkCsr(in_offsets_in, in_adj_in, n, m);
+
+    // poprzedniki muszą być dokładnie transpozycją następników
+    vector<unsigned int> fill(in_offsets_in, in_offsets_in + n);
+    for(idx_t v = 0; v < n; ++v) {
+        for(unsigned int i = out_offsets_in[v]; i < out_offsets_in[v + 1]; ++i) {
+            idx_t w = out_adj_in[i];
+            if (fill[w] >= in_offsets_in[w + 1] || in_adj_in[fill[w]++] != v) {
+                throw invalid_argument("Uszkodzony plik binarny: poprzedniki "
+                        "nie odpowiadają następnikom");
+            }
+        }
+    }
+
+    vector<label_t>().swap(this->labels);
+    vector<unsigned int>().swap(this->out_offsets);
+    vector<idx_t>().swap(this->out_adj);
+    vector<unsigned int>().swap(this->in_offsets);
+    vector<idx_t>().swap(this->in_adj);
+
+    this->mapping = owner;
+    this->label_data = labels_in;
+    this->out_offset_data = out_offsets_in;
+    this->out_adj_data = out_adj_in;
+    this->in_offset_data = in_offsets_in;
+    this->in_adj_data = in_adj_in;
+
+    this->vertex_count = n;
+    this->edge_count = m;
+    this->inv_power = pow(10, ceil(log10(this->vertex_count + 1)));
+    this->buildBitMatrix();
+}
+
+bool FrozenGraph::isBinaryFile(const std::string &filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    char magic[8];
+    if (!file.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+}
+
+/* STREAMS */
+std::ostream& operator<<(std::ostream &strm, const FrozenGraph &g)
+{
+    using std::endl;
+
+    typedef FrozenGraph::adj_iterator adj_iterator;
+
+    for(idx_t v = 0; v < g.getSize(); ++v) {
+        strm << g.getLabel(v) << ": ";
+        for(adj_iterator it = g.adjBegin(v); it != g.adjEnd(v); ++it) {
+            strm << (it == g.adjBegin(v) ? "" : ", ") << g.getLabel(*it);
+        }
+        strm << endl;
+    }
+    return strm;
+}
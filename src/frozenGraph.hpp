@@ -0,0 +1,692 @@
+/**
+ *      @file  frozenGraph.hpp
+ *     @brief  plik nagłówkowy klasy FrozenGraph
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy FrozenGraph - zamrożonej (tylko do odczytu) postaci
+ * grafu w reprezentacji CSR (compressed sparse row)
+ *
+ *=====================================================================================
+ */
+
+#ifndef FROZENGRAPH_HPP
+#define FROZENGRAPH_HPP
+
+#include <vector>
+#include <set>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#include "graph.hpp"
+#include "randomEngine.hpp"
+#include "mappedFile.hpp"
+
+/**
+ * @brief maksymalna liczba wierzchołków dla której budowana jest
+ * macierz sąsiedztwa w postaci bitowej
+ */
+#define BITMATRIX_MAX_VERTICES 4096
+
+/**
+ * @brief minimalna gęstość grafu dla której budowana jest macierz
+ * sąsiedztwa w postaci bitowej
+ *
+ * Poniżej tej gęstości macierz zajmuje wielokrotnie więcej pamięci niż
+ * listy CSR, a wyszukiwanie binarne w krótkich wierszach jest i tak tanie.
+ */
+#define BITMATRIX_MIN_DENSITY 0.01
+
+/**
+ * @brief wartość indeksu oznaczająca brak wierzchołka
+ */
+#define NO_VERTEX (~0u)
+
+/**
+ * @brief 8 bajtów na początku pliku binarnego z grafem
+ */
+#define BINARY_MAGIC "IZOMORFB"
+
+/**
+ * @brief wersja formatu binarnego; zmieniana przy każdej niezgodnej zmianie
+ * układu pliku
+ */
+#define BINARY_VERSION 1
+
+/**
+ * @brief znacznik kolejności bajtów zapisywany w nagłówku - plik zapisany
+ * na maszynie o innej kolejności bajtów jest odrzucany
+ */
+#define BINARY_BYTE_ORDER 0x01020304u
+
+/**
+ * @brief klasa implementuje zamrożony graf w reprezentacji CSR
+ *
+ * Klasa FrozenGraph to niemodyfikowalna kopia grafu \ref Graph, w której
+ * wierzchołki mają gęste indeksy 0..n-1, a listy sąsiedztwa są zapisane
+ * w dwóch ciągłych tablicach:
+ * * tablica przesunięć (offsets) - sąsiedzi wierzchołka v to
+ *   adj[offsets[v]] .. adj[offsets[v+1] - 1]
+ * * tablica sąsiadów (adj) - posortowane rosnąco indeksy sąsiadów
+ *
+ * Analogiczna para tablic przechowuje listy poprzedników (odwrotne listy
+ * sąsiedztwa), dzięki czemu wejściowość w podgrafie indukowanym kosztuje
+ * tyle co wejściowość wierzchołka, a nie rozmiar podzbioru.
+ *
+ * Indeks wierzchołka odpowiada pozycji jego znacznika w posortowanym
+ * rosnąco zbiorze znaczników grafu, dzięki czemu mapowanie znacznik -> indeks
+ * to wyszukiwanie binarne, a indeks -> znacznik to dostęp do tablicy.
+ *
+ * Reprezentacja ta jest wykorzystywana w gorącej ścieżce algorytmu
+ * \ref IsomorphismAlgo - wszystkie odczyty są dostępami do ciągłej pamięci
+ * zamiast przechodzenia po drzewach czerwono-czarnych.
+ *
+ * Dla gęstych grafów o co najwyżej \ref BITMATRIX_MAX_VERTICES wierzchołkach
+ * budowana jest dodatkowo macierz sąsiedztwa w postaci bitowej (wiersz słów
+ * 64-bitowych na wierzchołek) oraz jej transpozycja. Sprawdzenie krawędzi to
+ * wtedy test jednego bitu, a stopnie w podgrafie indukowanym zbiorem
+ * \ref FrozenGraph::vertex_bits_t to iloczyn bitowy i zliczanie jedynek.
+ *
+ * Tablice znaczników i list CSR są czytane przez wskaźniki, które wskazują
+ * albo na własne wektory obiektu, albo - po \ref FrozenGraph::loadBinary -
+ * wprost na plik odwzorowany w pamięć (bez kopiowania).
+ */
+class FrozenGraph
+{
+    public:
+        /**
+         * @brief gęsty indeks wierzchołka 0..n-1
+         */
+        typedef unsigned int idx_t;
+
+        /**
+         * @brief iterator po indeksach sąsiadów wierzchołka
+         */
+        typedef const idx_t *adj_iterator;
+
+        /**
+         * @brief krawędź skierowana opisana gęstymi indeksami wierzchołków
+         */
+        typedef Graph::Edge Edge;
+
+        /**
+         * @brief zbiór indeksów wierzchołków
+         */
+        typedef std::set<idx_t> vertex_set_t;
+
+        /**
+         * @brief ścieżka dfs po grafie (w indeksach)
+         */
+        typedef std::vector<idx_t> dfs_path;
+
+        /**
+         * @brief znaczniki wierzchołków odwiedzonych przy przechodzeniu
+         * grafu wgłąb, indeksowane gęstym indeksem
+         */
+        typedef std::vector<bool> dfs_visited;
+
+        /**
+         * @brief słowo macierzy bitowej
+         */
+        typedef uint64_t word_t;
+
+        /**
+         * @brief podzbiór wierzchołków zapisany bitowo, rozmiar
+         * \ref FrozenGraph::getWordCount słów
+         */
+        typedef std::vector<word_t> vertex_bits_t;
+
+    public:
+        /**
+         * @brief stwórz pusty zamrożony graf
+         */
+        FrozenGraph();
+
+        /**
+         * @brief zamroź graf
+         *
+         * @param g graf źródłowy
+         */
+        explicit FrozenGraph(const Graph &g);
+
+        /**
+         * @brief konstruktor kopiujący - wskaźniki na tablice kopii
+         * wskazują na jej własne wektory (lub na to samo odwzorowanie pliku)
+         *
+         * @param other kopiowany graf
+         */
+        FrozenGraph(const FrozenGraph &other);
+
+        FrozenGraph(FrozenGraph &&other) = default;
+
+        /**
+         * @brief przypisanie - jak w konstruktorze kopiującym
+         *
+         * @param other kopiowany graf
+         *
+         * @return referencja na ten graf
+         */
+        FrozenGraph &operator=(const FrozenGraph &other);
+
+        FrozenGraph &operator=(FrozenGraph &&other) = default;
+
+        /**
+         * @brief zastąp zawartość zamrożoną kopią grafu g
+         *
+         * @param g graf źródłowy
+         */
+        void freeze(const Graph &g);
+
+        /* INPUT/OUTPUT */
+        /**
+         * @brief zapisz graf w formacie binarnym
+         *
+         * Układ pliku (liczby 32-bitowe w kolejności bajtów maszyny):
+         * nagłówek (\ref BINARY_MAGIC, \ref BINARY_VERSION,
+         * \ref BINARY_BYTE_ORDER, n, m), znaczniki [n], przesunięcia
+         * następników [n+1], następniki [m], przesunięcia poprzedników [n+1],
+         * poprzedniki [m].
+         *
+         * @param filename nazwa pliku
+         */
+        void saveBinary(const std::string &filename) const;
+
+        /**
+         * @brief wczytaj graf zapisany przez \ref FrozenGraph::saveBinary
+         *
+         * Plik jest odwzorowywany w pamięć, a tablice CSR używane są na
+         * miejscu; kopiowana jest jedynie macierz bitowa (jeżeli graf jest
+         * mały i gęsty). Poprawność tablic sprawdzana jest jednym przebiegiem.
+         * Rzuca std::runtime_error, gdy pliku nie da się odczytać, lub
+         * std::invalid_argument, gdy nie jest poprawnym plikiem binarnym.
+         *
+         * @param filename nazwa pliku
+         */
+        void loadBinary(const std::string &filename);
+
+        /**
+         * @brief wczytaj graf binarny z bufora w pamięci (np. przesłany
+         * przez gniazdo); bufor jest przejmowany i tablice CSR używane są
+         * na miejscu, tak jak przy \ref FrozenGraph::loadBinary z pliku
+         *
+         * @param data zawartość pliku binarnego
+         */
+        void loadBinary(std::vector<char> &&data);
+
+        /**
+         * @brief czy plik zaczyna się od \ref BINARY_MAGIC
+         *
+         * @param filename nazwa pliku
+         *
+         * @return czy plik wygląda na plik binarny z grafem
+         */
+        static bool isBinaryFile(const std::string &filename);
+
+        /* GETTERS */
+        /**
+         * @brief zwróć liczbę wierzchołków w grafie
+         *
+         * @return liczba wierzchołków w grafie
+         */
+        unsigned int getVertexCount() const {return this->vertex_count;};
+
+        /**
+         * \copydoc FrozenGraph::getVertexCount
+         */
+        unsigned int getSize() const {return this->vertex_count;};
+
+        /**
+         * @brief zwróć liczbę krawędzi w grafie
+         *
+         * @return liczba krawędzi w grafie
+         */
+        unsigned int getEdgeCount() const {return this->edge_count;};
+
+        /**
+         * @brief zwróć znacznik wierzchołka o indeksie v
+         *
+         * @param v indeks wierzchołka
+         *
+         * @return znacznik wierzchołka
+         */
+        Graph::label_t getLabel(idx_t v) const {return this->label_data[v];};
+
+        /**
+         * @brief zwróć indeks wierzchołka o znaczniku label
+         *
+         * Wyszukiwanie binarne w posortowanej tablicy znaczników.
+         * Rzuca std::out_of_range gdy znacznika nie ma w grafie.
+         *
+         * @param label znacznik wierzchołka
+         *
+         * @return indeks wierzchołka
+         */
+        idx_t getIndex(Graph::label_t label) const;
+
+        /**
+         * @brief zwróć wyjściowość wierzchołka
+         *
+         * @param v indeks wierzchołka
+         *
+         * @return wyjściowość wierzchołka v
+         */
+        unsigned int getOut(idx_t v) const
+        {return this->out_offset_data[v + 1] - this->out_offset_data[v];};
+
+        /**
+         * @brief zwróć wejściowość wierzchołka
+         *
+         * @param v indeks wierzchołka
+         *
+         * @return wejściowość wierzchołka v
+         */
+        unsigned int getIn(idx_t v) const
+        {return this->in_offset_data[v + 1] - this->in_offset_data[v];};
+
+        /**
+         * @brief zwróć wyjściowość wierzchołka w podgrafie indukowanym
+         * zbiorem wierzchołków
+         *
+         * @param v indeks wierzchołka
+         * @param vset podzbiór wierzchołków grafu
+         *
+         * @return wyjściowość wierzchołka v w grafie indukowanym zbiorem vset
+         */
+        unsigned int getOut(idx_t v, const vertex_set_t &vset) const;
+
+        /**
+         * @brief zwróć wejściowość wierzchołka w podgrafie indukowanym
+         * zbiorem wierzchołków
+         *
+         * @param v indeks wierzchołka
+         * @param vset podzbiór wierzchołków grafu
+         *
+         * @return wejściowość wierzchołka v w grafie indukowanym zbiorem vset
+         */
+        unsigned int getIn(idx_t v, const vertex_set_t &vset) const;
+
+        /**
+         * \copydoc FrozenGraph::getOut(idx_t, const vertex_set_t &) const
+         */
+        unsigned int getOut(idx_t v, const vertex_bits_t &vset) const;
+
+        /**
+         * \copydoc FrozenGraph::getIn(idx_t, const vertex_set_t &) const
+         */
+        unsigned int getIn(idx_t v, const vertex_bits_t &vset) const;
+
+        /**
+         * @brief liczba słów potrzebna do zapisania podzbioru wierzchołków
+         *
+         * @return liczba słów \ref FrozenGraph::word_t
+         */
+        unsigned int getWordCount() const {return this->row_words;};
+
+        /**
+         * @brief zwróć 'stopień' (invariant) wierzchołka
+         *
+         * 10^t * wyjściowość + wejściowość
+         *
+         * @param v indeks wierzchołka
+         *
+         * @return 'stopień' wierzchołka v
+         */
+        unsigned int getInvariant(idx_t v) const
+        {return this->inv_power * this->getOut(v) + this->getIn(v);};
+
+        /**
+         * @brief zapełnij wektor krawędziami grafu
+         *
+         * Krawędzie są uporządkowane leksykograficznie.
+         *
+         * @param edges referencja na wektor krawędzi
+         *
+         * @return liczba umieszczonych krawędzi
+         */
+        unsigned int getEdges(std::vector<Edge> &edges) const;
+
+        /**
+         * @brief zapisz ścieżkę po przejściu grafu wgłąb (DFS)
+         *
+         * Kolejność odwiedzania jest taka sama jak w \ref Graph::getDFSPath.
+         *
+         * @param path referencja na ścieżkę
+         * @param start indeks wierzchołka startowego
+         * @param visited wierzchołki które należy uznać za wcześniej
+         * odwiedzone, po wywołaniu zawiera także wierzchołki ze ścieżki
+         */
+        void getDFSPath(dfs_path &path, idx_t start, dfs_visited &visited) const;
+
+        /**
+         * @brief \ref FrozenGraph::getDFSPath ze stosem wywołującego
+         *
+         * @param path referencja na ścieżkę (dopisywana na koniec)
+         * @param start indeks wierzchołka startowego
+         * @param visited wierzchołki które należy uznać za wcześniej
+         * odwiedzone, po wywołaniu zawiera także wierzchołki ze ścieżki
+         * @param stack stos przejścia (pusty po wywołaniu)
+         */
+        void appendDFSPath(dfs_path &path, idx_t start, dfs_visited &visited,
+                dfs_path &stack) const;
+
+        /**
+         * @brief informacje na temat grafu
+         *
+         * Metoda pomocnicza.
+         *
+         * @return string z informacjami o grafie
+         */
+        std::string getInfo() const;
+
+        /* GENERATORS */
+        /**
+         * @brief wygeneruj losowy, skierowany graf słabo spójny w czasie
+         * O(V + E)
+         *
+         * Najpierw losowane jest drzewo rozpinające (algorytm Wilsona,
+         * krawędzie o losowym kierunku), potem pozostałe krawędzie G(n, p)
+         * z takim p, żeby oczekiwana liczba krawędzi wynosiła
+         * density * n * (n - 1). Krawędzie losowane są przeskokami
+         * geometrycznymi po kolejnych parach (v, w), a dla p > 1/2 losowane
+         * są pary pominięte. Pary przychodzą posortowane, więc listy CSR
+         * powstają w jednym przebiegu. Znaczniki wierzchołków to 1..n.
+         *
+         * @param vertex_count liczba wierzchołków
+         * @param density gęstość grafu z przedziału (0, 1]
+         * @param engine generator liczb losowych
+         *
+         * @return zamrożony graf losowy
+         */
+        static FrozenGraph generateRandom(unsigned int vertex_count,
+                double density, RandomEngine &engine);
+
+        /**
+         * @brief losowy graf izomorficzny - te same znaczniki przypisane
+         * losowo permutowanym wierzchołkom
+         *
+         * @param engine generator liczb losowych
+         *
+         * @return zamrożony graf izomorficzny z tym grafem
+         */
+        FrozenGraph randomIsomorphic(RandomEngine &engine) const;
+
+        /* CHECKERS */
+        /**
+         * @brief sprawdź czy graf nie zawiera wierzchołków
+         *
+         * @return czy graf jest pusty
+         */
+        bool isEmpty() const {return this->vertex_count == 0;};
+
+        /**
+         * @brief czy zbudowano macierz sąsiedztwa w postaci bitowej
+         *
+         * @return czy graf ma macierz bitową
+         */
+        bool hasBitMatrix() const {return !this->out_bits.empty();};
+
+        /**
+         * @brief czy wierzchołek o danym znaczniku należy do grafu
+         *
+         * @param label znacznik wierzchołka
+         *
+         * @return czy graf zawiera wierzchołek label
+         */
+        bool isNode(Graph::label_t label) const;
+
+        /**
+         * @brief czy w grafie występuje krawędź v -> w
+         *
+         * Wyszukiwanie binarne w posortowanym wierszu v.
+         *
+         * @param v indeks wierzchołka źródłowego
+         * @param w indeks wierzchołka docelowego
+         *
+         * @return czy wstępuje połączenie
+         */
+        bool isConnection(idx_t v, idx_t w) const
+        {
+            if (this->hasBitMatrix()) {
+                return testBit(&this->out_bits[v * this->row_words], w);
+            }
+            return std::binary_search(this->adjBegin(v), this->adjEnd(v), w);
+        };
+
+        /**
+         * @brief czy w grafie indukowanym występuje krawędź v -> w
+         *
+         * @param v indeks wierzchołka źródłowego
+         * @param w indeks wierzchołka docelowego
+         * @param vset zbiór wierzchołków rozpinających
+         *
+         * @return czy wstępuje połączenie
+         */
+        bool isConnection(idx_t v, idx_t w, const vertex_set_t &vset) const;
+
+        /**
+         * \copydoc FrozenGraph::isConnection(idx_t, idx_t, const vertex_set_t &) const
+         */
+        bool isConnection(idx_t v, idx_t w, const vertex_bits_t &vset) const
+        {
+            return testBit(vset.data(), v) && testBit(vset.data(), w) &&
+                this->isConnection(v, w);
+        };
+
+        /* BITS */
+        /**
+         * @brief sprawdź bit v w ciągu słów
+         *
+         * @param bits ciąg słów
+         * @param v numer bitu
+         *
+         * @return czy bit jest ustawiony
+         */
+        static bool testBit(const word_t *bits, idx_t v)
+        {return (bits[v >> 6] >> (v & 63)) & 1;};
+
+        /**
+         * @brief ustaw bit v w ciągu słów
+         *
+         * @param bits ciąg słów
+         * @param v numer bitu
+         */
+        static void setBit(word_t *bits, idx_t v)
+        {bits[v >> 6] |= (word_t(1) << (v & 63));};
+
+        /**
+         * @brief wyzeruj bit v w ciągu słów
+         *
+         * @param bits ciąg słów
+         * @param v numer bitu
+         */
+        static void clearBit(word_t *bits, idx_t v)
+        {bits[v >> 6] &= ~(word_t(1) << (v & 63));};
+
+        /* ITERATE */
+        /**
+         * @brief iterator po sąsiadach wierzchołka
+         *
+         * @param v indeks wierzchołka źródłowego
+         *
+         * @return wskaźnik na pierwszego sąsiada wierzchołka v
+         */
+        adj_iterator adjBegin(idx_t v) const
+        {return this->out_adj_data + this->out_offset_data[v];};
+
+        /**
+         * @brief iterator po sąsiadach wierzchołka
+         *
+         * @param v indeks wierzchołka źródłowego
+         *
+         * @return wskaźnik za ostatnim sąsiadem wierzchołka v
+         */
+        adj_iterator adjEnd(idx_t v) const
+        {return this->out_adj_data + this->out_offset_data[v + 1];};
+
+        /**
+         * @brief iterator po poprzednikach wierzchołka
+         *
+         * @param v indeks wierzchołka docelowego
+         *
+         * @return wskaźnik na pierwszego poprzednika wierzchołka v
+         */
+        adj_iterator predBegin(idx_t v) const
+        {return this->in_adj_data + this->in_offset_data[v];};
+
+        /**
+         * @brief iterator po poprzednikach wierzchołka
+         *
+         * @param v indeks wierzchołka docelowego
+         *
+         * @return wskaźnik za ostatnim poprzednikiem wierzchołka v
+         */
+        adj_iterator predEnd(idx_t v) const
+        {return this->in_adj_data + this->in_offset_data[v + 1];};
+
+    private:
+        /**
+         * @brief liczba wierzchołków w grafie
+         */
+        unsigned int vertex_count;
+
+        /**
+         * @brief liczba krawędzi w grafie
+         */
+        unsigned int edge_count;
+
+        /**
+         * @brief potęga t używana przy liczeniu 'stopnia' wierzchołka
+         */
+        unsigned int inv_power;
+
+        /**
+         * @brief znaczniki wierzchołków, posortowane rosnąco (indeks -> znacznik)
+         */
+        std::vector<Graph::label_t> labels;
+
+        /**
+         * @brief tablica przesunięć CSR, rozmiar n+1
+         */
+        std::vector<unsigned int> out_offsets;
+
+        /**
+         * @brief tablica sąsiadów CSR, rozmiar m
+         */
+        std::vector<idx_t> out_adj;
+
+        /**
+         * @brief tablica przesunięć odwrotnych list CSR, rozmiar n+1
+         */
+        std::vector<unsigned int> in_offsets;
+
+        /**
+         * @brief tablica poprzedników CSR, rozmiar m
+         */
+        std::vector<idx_t> in_adj;
+
+        /**
+         * @brief znaczniki - \ref FrozenGraph::labels lub tablica w pliku
+         */
+        const Graph::label_t *label_data;
+
+        /**
+         * @brief przesunięcia następników - \ref FrozenGraph::out_offsets
+         * lub tablica w pliku
+         */
+        const unsigned int *out_offset_data;
+
+        /**
+         * @brief następniki - \ref FrozenGraph::out_adj lub tablica w pliku
+         */
+        const idx_t *out_adj_data;
+
+        /**
+         * @brief przesunięcia poprzedników - \ref FrozenGraph::in_offsets
+         * lub tablica w pliku
+         */
+        const unsigned int *in_offset_data;
+
+        /**
+         * @brief poprzedniki - \ref FrozenGraph::in_adj lub tablica w pliku
+         */
+        const idx_t *in_adj_data;
+
+        /**
+         * @brief właściciel pamięci, na którą wskazują tablice - plik
+         * odwzorowany w pamięć lub bufor (pusty - tablice w wektorach)
+         */
+        std::shared_ptr<const void> mapping;
+
+        /**
+         * @brief sprawdź zawartość pliku binarnego i ustaw tablice na jej
+         * miejscu
+         *
+         * @param owner właściciel pamięci \p data
+         * @param data początek zawartości (wyrównany do 4 bajtów)
+         * @param size rozmiar zawartości
+         */
+        void loadBinaryData(std::shared_ptr<const void> owner,
+                const char *data, size_t size);
+
+        /**
+         * @brief ustaw wskaźniki na tablice na własne wektory
+         */
+        void bindArrays();
+
+        /**
+         * @brief zbuduj odwrotne listy CSR na podstawie list następników
+         */
+        void buildPredecessors();
+
+        /**
+         * @brief uzupełnij liczniki, listy poprzedników i macierze bitowe
+         * po wypełnieniu znaczników i list następników
+         */
+        void finishBuild();
+
+        /**
+         * @brief liczba słów w wierszu macierzy bitowej
+         */
+        unsigned int row_words;
+
+        /**
+         * @brief macierz sąsiedztwa w postaci bitowej (wiersz v - następniki v),
+         * pusta gdy graf jest zbyt duży lub zbyt rzadki
+         */
+        vertex_bits_t out_bits;
+
+        /**
+         * @brief transpozycja \ref FrozenGraph::out_bits (wiersz v - poprzedniki v)
+         */
+        vertex_bits_t in_bits;
+
+        /**
+         * @brief zbuduj macierze bitowe jeżeli graf jest dostatecznie gęsty
+         */
+        void buildBitMatrix();
+
+        /**
+         * @brief liczba jedynek w iloczynie bitowym dwóch ciągów słów
+         *
+         * @param a pierwszy ciąg słów
+         * @param b drugi ciąg słów
+         * @param words długość ciągów
+         *
+         * @return liczba wspólnych bitów
+         */
+        static unsigned int countCommon(const word_t *a, const word_t *b,
+                unsigned int words);
+};
+
+/**
+ * @brief zapisz graf w formacie tekstowym \ref Graph (wiersze
+ * `znacznik: sąsiad, sąsiad, ...')
+ */
+std::ostream& operator<<(std::ostream &strm, const FrozenGraph &g);
+
+#endif /* end of include guard: FROZENGRAPH_HPP */
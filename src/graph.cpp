@@ -8,6 +8,10 @@
  */
 
 #include "graph.hpp"
+#include "frozenGraph.hpp"
+#include "graphBuilder.hpp"
+#include "graphParser.hpp"
+#include "mappedFile.hpp"
 
 typedef Vertex::idx_t idx_t;
 typedef Graph::label_t label_t;
@@ -87,10 +91,11 @@ unsigned int Graph::getIn(label_t label) const
 
 unsigned int Graph::getIn(label_t label, const vertex_set_t &vset) const
 {
-    unsigned int counter = 0;
+    const Vertex &ver = this->getVertexAt(label);
 
-    for(vertex_set_t::const_iterator it = vset.begin(); it != vset.end(); ++it) {
-        if(this->isConnection((*it), label)) {
+    unsigned int counter = 0;
+    for(Vertex::iterator it = ver.predBegin(); it != ver.predEnd(); ++it) {
+        if (vset.count(this->idx_label_map.at((*it)))) {
             ++counter;
         }
     }
@@ -175,6 +180,10 @@ void Graph::getDFSPath(
     }
 }
 
+FrozenGraph Graph::freeze() const
+{
+    return FrozenGraph(*this);
+}
 
 std::string Graph::getInfo() const
 {
@@ -275,13 +284,13 @@ void Graph::setVertex(label_t label, std::initializer_list<label_t> adj)
 void Graph::setVertex(label_t label, std::vector<label_t> adj)
 {
     typedef std::vector<label_t> labVec;
-    std::vector<label_t> vec;
 
-    this->addVertex(label);
+    GraphBuilder builder;
+    builder.addVertex(label);
     for(labVec::iterator it = adj.begin(); it != adj.end(); ++it) {
-        this->addVertex((*it));
-        this->addEdge(label, (*it));
+        builder.addEdge(label, (*it));
     }
+    builder.build(*this);
 }
 
 bool Graph::addEdge(label_t v, label_t w)
@@ -307,6 +316,7 @@ void Graph::clear()
     this->__first_free_idx = 0;
 
     this->vertexes.clear();
+    this->labels.clear();
     this->idx_label_map.clear();
     this->label_idx_map.clear();
 }
@@ -323,6 +333,16 @@ Graph::AdjIter Graph::adjEnd(label_t label) const
     return AdjIter(this->idx_label_map, this->getVertexAt(label).end());
 }
 
+Graph::AdjIter Graph::predBegin(label_t label) const
+{
+    return AdjIter(this->idx_label_map, this->getVertexAt(label).predBegin());
+}
+
+Graph::AdjIter Graph::predEnd(label_t label) const
+{
+    return AdjIter(this->idx_label_map, this->getVertexAt(label).predEnd());
+}
+
 
 
 
@@ -420,11 +440,19 @@ void Graph::saveToFile(const std::string &filename)
     file.close();
 }
 
-void Graph::loadFromFile(const std::string &filename)
+void Graph::loadFromFile(const std::string &filename, unsigned int threads)
 {
     using std::ifstream;
     using std::runtime_error;
 
+    if (threads != 1) {
+        MappedFile file(filename);
+        this->clear();
+        GraphParser::parseParallel(file.getData(),
+                file.getData() + file.getSize(), threads, *this);
+        return;
+    }
+
     ifstream file(filename);
 
     if (!file.is_open()) {
@@ -443,89 +471,314 @@ void Graph::loadFromFile(const std::string &filename)
 Graph Graph::generateRandom(
         unsigned int vertex_count, double density)
 {
+    return generateRandom(vertex_count, density, RandomEngine::clockSeed());
+}
+
+Graph Graph::generateRandom(
+        unsigned int vertex_count, double density, uint64_t seed)
+{
+    RandomEngine engine(seed);
+    return generateRandom(vertex_count, density, engine);
+}
+
+Graph Graph::generateRandom(
+        unsigned int vertex_count, double density, RandomEngine &gen)
+{
+    typedef FrozenGraph::idx_t frozen_idx_t;
+
+    // losowanie w reprezentacji CSR, przepisanie do list sąsiedztwa
+    FrozenGraph frozen = FrozenGraph::generateRandom(vertex_count, density, gen);
+
+    GraphBuilder builder;
+    builder.reserve(frozen.getEdgeCount());
+    for(frozen_idx_t v = 0; v < frozen.getSize(); ++v) {
+        builder.addVertex(frozen.getLabel(v));
+        for(FrozenGraph::adj_iterator it = frozen.adjBegin(v);
+                it != frozen.adjEnd(v); ++it) {
+            builder.addEdge(frozen.getLabel(v), frozen.getLabel(*it));
+        }
+    }
+
+    return builder.build();
+}
+
+Graph Graph::generateRegular(
+        unsigned int vertex_count, unsigned int degree, RandomEngine &engine)
+{
+    using std::vector;
     using std::invalid_argument;
 
-    typedef std::chrono::high_resolution_clock hclock;
-    typedef std::default_random_engine Generator;
-    typedef std::uniform_int_distribution<> Distribution;
+    if (degree >= vertex_count && !(degree == 0 && vertex_count == 0)) {
+        throw invalid_argument("Stopień grafu regularnego musi być mniejszy "
+                "od liczby wierzchołków");
+    }
 
-    typedef std::set<label_t> Set;
-    typedef std::map<label_t, label_t> Map;
+    Graph graph;
+    for(label_t v = 1; v <= vertex_count; ++v) {
+        graph.addVertex(v);
+    }
+
+    if (degree > (vertex_count - 1) / 2) {
+        // gęsty graf - dopełnienie rzadkiego
+        Graph sparse = generateRegular(vertex_count, vertex_count - 1 - degree,
+                engine);
+        GraphBuilder builder;
+        builder.reserve((size_t) vertex_count * degree);
+        for(label_t v = 1; v <= vertex_count; ++v) {
+            for(label_t w = 1; w <= vertex_count; ++w) {
+                if (v != w && !sparse.isConnection(v, w)) {
+                    builder.addEdge(v, w);
+                }
+            }
+        }
+        builder.build(graph);
+        return graph;
+    }
 
-    if (vertex_count < 1) {
-        throw invalid_argument("Liczba wierzchołków musi być większa od 1");
+    vector<unsigned int> perm(vertex_count);
+    for(unsigned int d = 0; d < degree; ++d) {
+        for(unsigned int v = 0; v < vertex_count; ++v) {
+            perm[v] = v;
+        }
+        std::shuffle(perm.begin(), perm.end(), engine);
+
+        // naprawa pętli i krawędzi z poprzednich permutacji: zamiana celu
+        // z celem losowego wierzchołka, jeżeli naprawia pozycję v (pozycja
+        // w może się zepsuć - zostanie naprawiona w kolejnym przebiegu)
+        bool repaired = false;
+        while (!repaired) {
+            repaired = true;
+            for(unsigned int v = 0; v < vertex_count; ++v) {
+                if (perm[v] != v && !graph.isConnection(v + 1, perm[v] + 1)) {
+                    continue;
+                }
+                repaired = false;
+                unsigned int w = engine() % vertex_count;
+                if (perm[w] != v && !graph.isConnection(v + 1, perm[w] + 1)) {
+                    std::swap(perm[v], perm[w]);
+                }
+            }
+        }
+        for(unsigned int v = 0; v < vertex_count; ++v) {
+            graph.addEdge(v + 1, perm[v] + 1);
+        }
     }
+    return graph;
+}
 
-    if (density <= 0 || density > 1) {
-        throw invalid_argument("Gęstość musi należeć do przedziału (0, 1]");
+Graph Graph::generateCirculant(
+        unsigned int vertex_count, const std::vector<unsigned int> &shifts)
+{
+    GraphBuilder builder;
+    builder.reserve((size_t) vertex_count * shifts.size());
+    for(unsigned int v = 0; v < vertex_count; ++v) {
+        builder.addVertex(v + 1);
+        for(size_t s = 0; s < shifts.size(); ++s) {
+            builder.addEdge(v + 1, (v + shifts[s]) % vertex_count + 1);
+        }
     }
+    return builder.build();
+}
 
-    label_t minLabel = 1;
-    label_t maxLabel = vertex_count;
+Graph Graph::generateTournament(unsigned int vertex_count, RandomEngine &engine)
+{
+    using std::vector;
 
-    Generator gen(hclock::now().time_since_epoch().count());
-    Distribution vertexDist(minLabel, maxLabel);
-    Distribution coin(0, 1);
+    if (vertex_count % 2 == 0) {
+        throw std::invalid_argument("Turniej regularny wymaga nieparzystej "
+                "liczby wierzchołków");
+    }
 
-    Set inTree;
-    Map successor;
+    vector<unsigned int> shifts;
+    for(unsigned int s = 1; s <= vertex_count / 2; ++s) {
+        shifts.push_back((engine() & 1) ? s : vertex_count - s);
+    }
+    return generateCirculant(vertex_count, shifts);
+}
 
-    label_t root = vertexDist(gen);
-    inTree.insert(root);
+Graph Graph::generateLatinSquare(unsigned int order, bool product)
+{
+    using std::vector;
 
-    Graph graph;
-    graph.addVertex(root);
-    for (label_t i = minLabel; i <= maxLabel; ++i) {
-        label_t ver = i;
-        graph.addVertex(ver);
-        while (!inTree.count(ver)) {
-            label_t next = vertexDist(gen);
-            Map::iterator it = successor.find(ver);
-            if (it != successor.end()) {
-                it->second = next;
-            } else {
-                successor[ver] = next;
+    if (product && order % 2 != 0) {
+        throw std::invalid_argument("Grupa Z_2 x Z_{n/2} wymaga parzystego "
+                "rzędu");
+    }
+
+    unsigned int half = order / 2;
+    vector<vector<label_t> > symbols(order);
+    GraphBuilder builder;
+    // wiersz, kolumna i symbol - po order sąsiadów
+    builder.reserve((size_t) order * order * 3 * order);
+    for(unsigned int r = 0; r < order; ++r) {
+        for(unsigned int c = 0; c < order; ++c) {
+            unsigned int symbol = (r + c) % order;
+            if (product) {
+                // element x to para (x / (n/2), x % (n/2))
+                symbol = ((r / half + c / half) % 2) * half +
+                    (r % half + c % half) % half;
+            }
+            builder.addVertex(r * order + c + 1);
+            symbols[symbol].push_back(r * order + c + 1);
+        }
+    }
+
+    // dwa różne pola kwadratu łacińskiego mają wspólny co najwyżej jeden
+    // z wiersza, kolumny i symbolu
+    for(unsigned int r = 0; r < order; ++r) {
+        for(unsigned int c = 0; c < order; ++c) {
+            label_t v = r * order + c + 1;
+            for(unsigned int k = 0; k < order; ++k) {
+                if (k != c) {
+                    builder.addEdge(v, r * order + k + 1);
+                }
+                if (k != r) {
+                    builder.addEdge(v, k * order + c + 1);
+                }
             }
-            ver = next;
         }
-        ver = i;
-        while (!inTree.count(ver)) {
-            inTree.insert(ver);
-            ver = successor[ver];
+    }
+    for(unsigned int s = 0; s < order; ++s) {
+        for(size_t i = 0; i < symbols[s].size(); ++i) {
+            for(size_t j = 0; j < symbols[s].size(); ++j) {
+                builder.addEdge(symbols[s][i], symbols[s][j]);
+            }
         }
     }
+    return builder.build();
+}
+
+Graph Graph::cfiOverBase(
+        const std::vector<std::pair<unsigned int, unsigned int> > &base,
+        unsigned int base_count, bool twisted)
+{
+    using std::vector;
+    using std::pair;
+    using std::make_pair;
 
+    // gadżet: pary a(slot, bit) dla 3 krawędzi i 4 wierzchołki środkowe
+    const unsigned int gadget = 10;
 
-    for(Map::iterator it = successor.begin();
-            it != successor.end(); ++it) {
-        if (coin(gen)) {
-            graph.addEdge(it->first, it->second);
-        } else {
-            graph.addEdge(it->second, it->first);
+    // pozycje (sloty) krawędzi w wierzchołkach końcowych
+    vector<unsigned int> used(base_count, 0);
+    vector<pair<unsigned int, unsigned int> > slots;
+    for(size_t e = 0; e < base.size(); ++e) {
+        slots.push_back(make_pair(used[base[e].first]++,
+                    used[base[e].second]++));
+    }
+
+    GraphBuilder builder;
+    for(label_t v = 1; v <= base_count * gadget; ++v) {
+        builder.addVertex(v);
+    }
+    for(unsigned int v = 0; v < base_count; ++v) {
+        label_t first = v * gadget + 1;
+        unsigned int middle = 0;
+        for(unsigned int subset = 0; subset < 8; ++subset) {
+            if (__builtin_popcount(subset) % 2 != 0) {
+                continue;
+            }
+            label_t mid = first + 6 + middle++;
+            for(unsigned int slot = 0; slot < 3; ++slot) {
+                label_t a = first + 2 * slot + ((subset >> slot) & 1);
+                builder.addEdge(mid, a);
+                builder.addEdge(a, mid);
+            }
+        }
+    }
+    for(size_t e = 0; e < base.size(); ++e) {
+        unsigned int twist = (twisted && e == 0) ? 1 : 0;
+        for(unsigned int bit = 0; bit < 2; ++bit) {
+            label_t a = base[e].first * gadget + 1 + 2 * slots[e].first + bit;
+            label_t b = base[e].second * gadget + 1 + 2 * slots[e].second +
+                (bit ^ twist);
+            builder.addEdge(a, b);
+            builder.addEdge(b, a);
         }
     }
+    return builder.build();
+}
 
-    long long counter = 0;
-    unsigned long edge_count = vertex_count * (vertex_count - 1) * density + 0.5;
+Graph Graph::generateCfi(unsigned int base_count, bool twisted)
+{
+    using std::vector;
+    using std::pair;
+    using std::make_pair;
 
-    while(graph.getEdgeCount() < edge_count) {
-        if ((counter++) > MAX_RANDOM_FAILS) {
-            break;
-        }
+    if (base_count < 4 || base_count % 2 != 0) {
+        throw std::invalid_argument("Drabina Möbiusa wymaga parzystej liczby "
+                "wierzchołków, co najmniej 4");
+    }
 
-        if (graph.addEdge(vertexDist(gen), vertexDist(gen))) {
-            counter = 0;
-        }
+    // cykl z cięciwami i -- i + m/2
+    vector<pair<unsigned int, unsigned int> > base;
+    for(unsigned int i = 0; i < base_count; ++i) {
+        base.push_back(make_pair(i, (i + 1) % base_count));
+    }
+    for(unsigned int i = 0; i < base_count / 2; ++i) {
+        base.push_back(make_pair(i, i + base_count / 2));
     }
+    return cfiOverBase(base, base_count, twisted);
+}
 
-    return graph;
+Graph Graph::generateMiyazaki(unsigned int base_count, bool twisted)
+{
+    using std::vector;
+    using std::pair;
+    using std::make_pair;
+
+    if (base_count < 6 || base_count % 2 != 0) {
+        throw std::invalid_argument("Drabina cykliczna wymaga parzystej "
+                "liczby wierzchołków, co najmniej 6");
+    }
+
+    // dwa cykle długości k połączone szczeblami i -- i + k
+    unsigned int k = base_count / 2;
+    vector<pair<unsigned int, unsigned int> > base;
+    for(unsigned int i = 0; i < k; ++i) {
+        base.push_back(make_pair(i, (i + 1) % k));
+        base.push_back(make_pair(k + i, k + (i + 1) % k));
+        base.push_back(make_pair(i, i + k));
+    }
+    return cfiOverBase(base, base_count, twisted);
+}
+
+Graph Graph::generateGrid(unsigned int rows, unsigned int cols)
+{
+    GraphBuilder builder;
+    for(label_t v = 1; v <= rows * cols; ++v) {
+        builder.addVertex(v);
+    }
+    for(unsigned int i = 0; i < rows; ++i) {
+        for(unsigned int j = 0; j < cols; ++j) {
+            label_t v = i * cols + j + 1;
+            if (j + 1 < cols) {
+                builder.addEdge(v, v + 1);
+                builder.addEdge(v + 1, v);
+            }
+            if (i + 1 < rows) {
+                builder.addEdge(v, v + cols);
+                builder.addEdge(v + cols, v);
+            }
+        }
+    }
+    return builder.build();
 }
 
 Graph &Graph::randomIsomorphic(const Graph &other)
+{
+    return this->randomIsomorphic(other, RandomEngine::clockSeed());
+}
+
+Graph &Graph::randomIsomorphic(const Graph &other, uint64_t seed)
+{
+    RandomEngine engine(seed);
+    return this->randomIsomorphic(other, engine);
+}
+
+Graph &Graph::randomIsomorphic(const Graph &other, RandomEngine &engine)
 {
     using std::vector;
-    typedef std::chrono::high_resolution_clock hclock;
-    typedef std::default_random_engine Generator;
 
     typedef std::map<idx_t, label_t> Map;
 
@@ -539,9 +792,7 @@ Graph &Graph::randomIsomorphic(const Graph &other)
         labels.push_back(it->second);
     }
 
-    unsigned seed = hclock::now().time_since_epoch().count();
-
-    std::shuffle(labels.begin(), labels.end(), Generator(seed));
+    std::shuffle(labels.begin(), labels.end(), engine);
 
     this->label_idx_map.clear();
 
@@ -577,25 +828,7 @@ std::ostream& operator<<(std::ostream &strm, const Graph &g)
 
 std::istream& operator>>(std::istream &strm, Graph &g)
 {
-    using std::string;
-    using std::stringstream;
-    using std::getline;
-    using std::invalid_argument;
-
-    string line;
-
-    unsigned counter = 1;
-    while(getline(strm, line)) {
-        string pure_line = line.substr(0, line.find(COM_SIGN));
-        if (pure_line == "") continue;
-        try {
-            g.loadVertex(pure_line);
-        } catch (invalid_argument &iae) {
-            stringstream ss;
-            ss << "Linia [" << counter << "]> " << iae.what();
-            throw invalid_argument(ss.str());
-        }
-        ++counter;
-    }
+    GraphParser parser;
+    parser.parse(strm, g);
     return strm;
 }
@@ -29,6 +29,7 @@
 
 #include "vertex.hpp"
 #include "utils.hpp"
+#include "randomEngine.hpp"
 
 
 
@@ -42,13 +43,7 @@
  */
 #define DELIMITER_CHAR ','
 
-/**
- * @brief maksymalna liczba losowań przy generowanie grafu losowego
- *
- * Liczba możliwych nieudanych prób przy losowaniu nowej krawędzi
- * do grafu losowego.
- */
-#define MAX_RANDOM_FAILS (1000*10)
+class FrozenGraph;
 
 /**
  * @brief klasa implementuje graf w reprezentacji listowej
@@ -188,8 +183,8 @@ class Graph
                 const AdjIter operator++(int) {AdjIter temp = *this; ++vit; return temp;};
                 const label_t &operator*() {return this->idx_label_map.at(*vit);}
                 const label_t *operator->() {return &this->idx_label_map.at(*vit);}
-                bool operator==(const AdjIter & rhs) { return (this->vit == rhs.vit && this->idx_label_map == rhs.idx_label_map);};
-                bool operator!=(const AdjIter & rhs) { return (this->vit != rhs.vit || this->idx_label_map != rhs.idx_label_map);};
+                bool operator==(const AdjIter & rhs) { return (this->vit == rhs.vit && &this->idx_label_map == &rhs.idx_label_map);};
+                bool operator!=(const AdjIter & rhs) { return (this->vit != rhs.vit || &this->idx_label_map != &rhs.idx_label_map);};
             private:
                 /**
                  * @brief mapa indeks -> znacznik
@@ -323,6 +318,9 @@ class Graph
          * wejściowość wierzchołka w podgrafie indukowanym zbiorem
          * wierzchołków
          *
+         * Przechodzi po liście poprzedników wierzchołka, koszt jest
+         * proporcjonalny do wejściowości, a nie do rozmiaru vset.
+         *
          * @param label znacznik wierzchołka
          * @param vset podzbiór wierzchołków grafu
          *
@@ -395,6 +393,16 @@ class Graph
          */
         void getDFSPath(dfs_path &path, label_t start, const dfs_visited &visited = dfs_visited()) const;
 
+        /**
+         * @brief zamroź graf do reprezentacji CSR
+         *
+         * Tworzy niemodyfikowalną kopię grafu \ref FrozenGraph z gęstymi
+         * indeksami wierzchołków i ciągłymi listami sąsiedztwa.
+         *
+         * @return zamrożona kopia grafu
+         */
+        FrozenGraph freeze() const;
+
         /**
          * @brief informacje na temat grafu
          *
@@ -528,6 +536,26 @@ class Graph
          */
         AdjIter adjEnd(label_t label) const;
 
+        /**
+         * @brief iterator poprzedników wierzchołka
+         *
+         * @param label znacznik wierzchołka docelowego
+         *
+         * @return iterator wskazujący na początek znaczników
+         * wierzchołków, z których wychodzi krawędź do wierzchołka label
+         */
+        AdjIter predBegin(label_t label) const;
+
+        /**
+         * @brief iterator poprzedników wierzchołka
+         *
+         * @param label znacznik wierzchołka docelowego
+         *
+         * @return iterator wskazujący na koniec znaczników
+         * wierzchołków, z których wychodzi krawędź do wierzchołka label
+         */
+        AdjIter predEnd(label_t label) const;
+
         /* INPUT/OUTPUT */
         /**
          * @brief zapisz wierzchołek do postaci stringa
@@ -555,14 +583,23 @@ class Graph
         /**
          * @brief wczytaj graf z pliku
          *
+         * Przy więcej niż jednym wątku plik jest odwzorowywany w pamięć
+         * i dzielony na fragmenty parsowane równolegle
+         * (\ref GraphParser::parseParallel); wynik i komunikaty błędów są
+         * takie same jak przy wczytywaniu jednowątkowym.
+         *
          * @param filename nazwa pliku
+         * @param threads liczba wątków parsera (0 - liczba rdzeni)
          */
-        void loadFromFile(const std::string &filename);
+        void loadFromFile(const std::string &filename,
+                unsigned int threads = 1);
 
         /* GENERATORS */
         /**
          * @brief wygeneruj losowy, skierowany graf spójny
          *
+         * Ziarno brane jest z zegara - wynik nie jest powtarzalny.
+         *
          * @param vertex_count liczba wierzchołków w grafie losowym
          * @param density gęstość grafu
          *
@@ -571,9 +608,143 @@ class Graph
          */
         static Graph generateRandom(unsigned int vertex_count, double density);
 
+        /**
+         * @brief wygeneruj losowy, skierowany graf spójny z danego ziarna
+         *
+         * @param vertex_count liczba wierzchołków w grafie losowym
+         * @param density gęstość grafu
+         * @param seed ziarno
+         *
+         * @return losowy, skierowany graf spójny, ten sam dla tego samego
+         * ziarna
+         */
+        static Graph generateRandom(unsigned int vertex_count, double density,
+                uint64_t seed);
+
+        /**
+         * @brief wygeneruj losowy, skierowany graf spójny generatorem
+         * podanym przez wywołującego
+         *
+         * Graf losowany jest przez \ref FrozenGraph::generateRandom
+         * (w czasie O(V + E)) i przepisywany do list sąsiedztwa.
+         *
+         * @param vertex_count liczba wierzchołków w grafie losowym
+         * @param density gęstość grafu
+         * @param engine generator liczb losowych
+         *
+         * @return losowy, skierowany graf spójny
+         */
+        static Graph generateRandom(unsigned int vertex_count, double density,
+                RandomEngine &engine);
+
+        /**
+         * @brief wygeneruj losowy graf d-regularny skierowany
+         *
+         * Krawędzie to suma d losowych permutacji bez punktów stałych
+         * i powtórzonych krawędzi, więc każdy wierzchołek ma stopień
+         * wejściowy i wyjściowy równy d. Dla d > (n - 1) / 2 losowane jest
+         * dopełnienie. Znaczniki wierzchołków to 1..n.
+         *
+         * @param vertex_count liczba wierzchołków n
+         * @param degree stopień d, 0 <= d < n
+         * @param engine generator liczb losowych
+         *
+         * @return graf regularny
+         */
+        static Graph generateRegular(unsigned int vertex_count,
+                unsigned int degree, RandomEngine &engine);
+
+        /**
+         * @brief wygeneruj cyrkulant: krawędzie v -> v + s (mod n)
+         *
+         * @param vertex_count liczba wierzchołków n
+         * @param shifts przesunięcia s z przedziału [1, n)
+         *
+         * @return graf o znacznikach 1..n
+         */
+        static Graph generateCirculant(unsigned int vertex_count,
+                const std::vector<unsigned int> &shifts);
+
+        /**
+         * @brief wygeneruj losowy turniej regularny (cyrkulantowy)
+         *
+         * Dla każdej pary przesunięć {s, n - s} losowane jest jedno, więc
+         * między każdą parą wierzchołków jest dokładnie jedna krawędź,
+         * a wszystkie stopnie wyjściowe to (n - 1) / 2.
+         *
+         * @param vertex_count liczba wierzchołków, nieparzysta
+         * @param engine generator liczb losowych
+         *
+         * @return turniej
+         */
+        static Graph generateTournament(unsigned int vertex_count,
+                RandomEngine &engine);
+
+        /**
+         * @brief wygeneruj graf kwadratu łacińskiego tabliczki działania
+         * grupy (graf silnie regularny)
+         *
+         * Wierzchołki to pola (r, c) kwadratu rzędu n, sąsiednie są pola
+         * z tego samego wiersza, kolumny lub symbolu. Graf jest
+         * srg(n^2, 3(n - 1), n, 6). Dla n > 4 grafy kwadratów grup
+         * nieizomorficznych są nieizomorficzne, więc dla n podzielnego
+         * przez 4 grupy Z_n i Z_2 x Z_{n/2} dają parę nieizomorficzną
+         * o tych samych parametrach.
+         *
+         * @param order rząd kwadratu n
+         * @param product czy użyć grupy Z_2 x Z_{n/2} zamiast Z_n
+         * (wymaga parzystego n)
+         *
+         * @return graf nieskierowany (krawędzie w obu kierunkach)
+         */
+        static Graph generateLatinSquare(unsigned int order, bool product);
+
+        /**
+         * @brief wygeneruj graf Cai-Fürer-Immermana nad drabiną Möbiusa
+         *
+         * Każdy wierzchołek 3-regularnego grafu bazowego zastępowany jest
+         * gadżetem: 4 wierzchołki środkowe (parzyste podzbiory krawędzi)
+         * i para a0, a1 dla każdej krawędzi. Krawędź bazowa łączy a0-a0
+         * i a1-a1 sąsiednich gadżetów, skręcona - a0-a1 i a1-a0. Graf
+         * skręcony i nieskręcony nie są izomorficzne, a rozdrabnianie
+         * kolorów ich nie rozróżnia.
+         *
+         * @param base_count liczba wierzchołków grafu bazowego (parzysta, >= 4)
+         * @param twisted czy skręcić jedną krawędź
+         *
+         * @return graf nieskierowany o 10 * base_count wierzchołkach
+         */
+        static Graph generateCfi(unsigned int base_count, bool twisted);
+
+        /**
+         * @brief wygeneruj graf w stylu Miyazakiego: gadżety CFI nad
+         * drabiną cykliczną (pryzmatem)
+         *
+         * Baza w postaci drabiny wymusza na algorytmach indywidualizacji
+         * i rozdrabniania wykładniczo wiele gałęzi.
+         *
+         * @param base_count liczba wierzchołków grafu bazowego (parzysta, >= 6)
+         * @param twisted czy skręcić jedną krawędź
+         *
+         * @return graf nieskierowany o 10 * base_count wierzchołkach
+         */
+        static Graph generateMiyazaki(unsigned int base_count, bool twisted);
+
+        /**
+         * @brief wygeneruj kratę, krawędzie w obu kierunkach między sąsiadami
+         *
+         * @param rows liczba wierszy
+         * @param cols liczba kolumn
+         *
+         * @return graf o rows * cols wierzchołkach
+         */
+        static Graph generateGrid(unsigned int rows, unsigned int cols);
+
         /**
          * @brief twórz losowy graf izomorficzny
          *
+         * Ziarno brane jest z zegara - wynik nie jest powtarzalny.
+         *
          * @param other graf który będzie izomorficzny z
          * nowym grafem
          *
@@ -581,9 +752,47 @@ class Graph
          */
         Graph &randomIsomorphic(const Graph &other);
 
+        /**
+         * @brief twórz losowy graf izomorficzny z danego ziarna
+         *
+         * @param other graf który będzie izomorficzny z nowym grafem
+         * @param seed ziarno
+         *
+         * @return referencja na graf izomorficzny do grafu other
+         */
+        Graph &randomIsomorphic(const Graph &other, uint64_t seed);
+
+        /**
+         * @brief twórz losowy graf izomorficzny generatorem podanym przez
+         * wywołującego
+         *
+         * @param other graf który będzie izomorficzny z nowym grafem
+         * @param engine generator liczb losowych
+         *
+         * @return referencja na graf izomorficzny do grafu other
+         */
+        Graph &randomIsomorphic(const Graph &other, RandomEngine &engine);
+
+    private:
+        /**
+         * @brief graf CFI nad 3-regularnym grafem bazowym
+         *
+         * @param base krawędzie grafu bazowego (wierzchołki 0..k-1)
+         * @param base_count liczba wierzchołków grafu bazowego k
+         * @param twisted czy skręcić pierwszą krawędź
+         *
+         * @return graf nieskierowany
+         */
+        static Graph cfiOverBase(
+                const std::vector<std::pair<unsigned int, unsigned int> > &base,
+                unsigned int base_count, bool twisted);
+
+    public:
         /* FRIENDS */
         friend std::ostream& operator<<(std::ostream &strm, const Graph &g);
         friend std::istream& operator>>(std::istream &strm, Graph &g);
+        friend class GraphBuilder;
+        friend class FrozenGraph;
 };
 
 std::ostream& operator<<(std::ostream &strm, const Graph &g);
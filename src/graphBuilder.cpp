@@ -0,0 +1,127 @@
+/**
+ *      @file  graphBuilder.cpp
+ *     @brief  implementacja metod klasy GraphBuilder
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "graphBuilder.hpp"
+
+typedef Vertex::idx_t idx_t;
+typedef GraphBuilder::label_t label_t;
+
+GraphBuilder::GraphBuilder()
+{}
+
+void GraphBuilder::reserve(size_t edge_count)
+{
+    this->edges.reserve(edge_count);
+}
+
+void GraphBuilder::addVertex(label_t label)
+{
+    this->vertices.push_back(label);
+}
+
+void GraphBuilder::addEdge(label_t source, label_t target)
+{
+    this->edges.push_back(edge_t(source, target));
+}
+
+void GraphBuilder::append(const GraphBuilder &other)
+{
+    this->vertices.insert(this->vertices.end(), other.vertices.begin(),
+            other.vertices.end());
+    this->edges.insert(this->edges.end(), other.edges.begin(),
+            other.edges.end());
+}
+
+void GraphBuilder::clear()
+{
+    this->vertices.clear();
+    this->edges.clear();
+}
+
+void GraphBuilder::build(Graph &graph)
+{
+    using std::vector;
+    using std::map;
+    using std::make_pair;
+    using std::lower_bound;
+
+    std::sort(this->edges.begin(), this->edges.end());
+    this->edges.erase(std::unique(this->edges.begin(), this->edges.end()),
+            this->edges.end());
+
+    // znaczniki: jawne wierzchołki i końce krawędzi (źródła są już
+    // posortowane, wystarczy pominąć powtórzenia)
+    vector<label_t> &labels = this->vertices;
+    for(size_t e = 0; e < this->edges.size(); ++e) {
+        if (e == 0 || this->edges[e].first != this->edges[e - 1].first) {
+            labels.push_back(this->edges[e].first);
+        }
+        labels.push_back(this->edges[e].second);
+    }
+    std::sort(labels.begin(), labels.end());
+    labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+
+    // wierzchołki w porządku znaczników; w pustym grafie indeksy są kolejne,
+    // więc wstawienia na koniec map nie wymagają wyszukiwania
+    vector<Vertex *> vertex(labels.size());
+    bool added = false;
+    for(size_t i = 0; i < labels.size(); ++i) {
+        size_t before = graph.label_idx_map.size();
+        map<label_t, idx_t>::iterator found = graph.label_idx_map.insert(
+                graph.label_idx_map.end(),
+                make_pair(labels[i], graph.__first_free_idx));
+        if (graph.label_idx_map.size() == before) {
+            vertex[i] = &graph.vertexes.at(found->second);
+            continue;
+        }
+
+        idx_t idx = graph.__first_free_idx;
+        graph.labels.insert(graph.labels.end(), labels[i]);
+        graph.idx_label_map.insert(graph.idx_label_map.end(),
+                make_pair(idx, labels[i]));
+        vertex[i] = &graph.vertexes.insert(graph.vertexes.end(),
+                make_pair(idx, Vertex(idx)))->second;
+        ++graph.vertex_count;
+        graph.findNextFreeIdx();
+        added = true;
+    }
+    if (added) {
+        graph.__inv_power = pow(10, ceil(log10(graph.vertex_count + 1)));
+    }
+
+    // krawędzie posortowane po źródle - pozycję źródła wystarczy przesuwać
+    size_t source = 0;
+    for(size_t e = 0; e < this->edges.size(); ++e) {
+        const edge_t &edge = this->edges[e];
+        if (edge.first == edge.second) {
+            continue;
+        }
+        while (labels[source] != edge.first) {
+            ++source;
+        }
+        size_t target = lower_bound(labels.begin(), labels.end(),
+                edge.second) - labels.begin();
+        if (vertex[source]->addAdjacent(*vertex[target])) {
+            ++graph.edge_count;
+        }
+    }
+
+    this->clear();
+}
+
+Graph GraphBuilder::build()
+{
+    Graph graph;
+    this->build(graph);
+    return graph;
+}
@@ -0,0 +1,110 @@
+/**
+ *      @file  graphBuilder.hpp
+ *     @brief  plik nagłówkowy klasy GraphBuilder
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy GraphBuilder - zbiorczego budowania grafu \ref Graph
+ * z surowych par (źródło, cel), bez sprawdzeń wykonywanych przez
+ * \ref Graph::addEdge dla każdej krawędzi
+ *
+ *=====================================================================================
+ */
+
+#ifndef GRAPHBUILDER_HPP
+#define GRAPHBUILDER_HPP
+
+#include <vector>
+#include <utility>
+
+#include "graph.hpp"
+
+/**
+ * @brief klasa zbiera wierzchołki i krawędzie i buduje z nich graf naraz
+ *
+ * Dodawanie to tylko dopisanie do tablicy. \ref GraphBuilder::build sortuje
+ * krawędzie i usuwa powtórzenia, nadaje wierzchołkom kolejne indeksy
+ * w porządku znaczników i wstawia sąsiedztwa w jednym przebiegu - razem
+ * O(E log E) zamiast kilku wyszukiwań w mapach na każdą krawędź.
+ * Wynik jest taki sam jak przy kolejnych wywołaniach \ref Graph::addVertex
+ * i \ref Graph::addEdge: pętle i powtórzone krawędzie są pomijane.
+ */
+class GraphBuilder
+{
+    public:
+        typedef Graph::label_t label_t;
+
+        /**
+         * @brief krawędź jako para znaczników (źródło, cel)
+         */
+        typedef std::pair<label_t, label_t> edge_t;
+
+        /**
+         * @brief stwórz pusty budowniczy
+         */
+        GraphBuilder();
+
+        /**
+         * @brief zarezerwuj miejsce na krawędzie
+         *
+         * @param edge_count spodziewana liczba krawędzi
+         */
+        void reserve(size_t edge_count);
+
+        /**
+         * @brief dodaj wierzchołek (także bez krawędzi)
+         *
+         * @param label znacznik wierzchołka
+         */
+        void addVertex(label_t label);
+
+        /**
+         * @brief dodaj krawędź; jej końce są dodawane jako wierzchołki
+         *
+         * @param source znacznik wierzchołka źródłowego
+         * @param target znacznik wierzchołka docelowego
+         */
+        void addEdge(label_t source, label_t target);
+
+        /**
+         * @brief dopisz wierzchołki i krawędzie innego budowniczego
+         *
+         * @param other budowniczy dopisywany na koniec
+         */
+        void append(const GraphBuilder &other);
+
+        /**
+         * @brief wyczyść zebrane wierzchołki i krawędzie
+         */
+        void clear();
+
+        /**
+         * @brief dodaj zebrane wierzchołki i krawędzie do grafu
+         *
+         * Graf nie musi być pusty - istniejące wierzchołki są zachowywane.
+         * Po zbudowaniu budowniczy jest pusty.
+         *
+         * @param graph uzupełniany graf
+         */
+        void build(Graph &graph);
+
+        /**
+         * @brief zbuduj nowy graf z zebranych wierzchołków i krawędzi
+         *
+         * @return graf
+         */
+        Graph build();
+
+    private:
+        /**
+         * @brief wierzchołki dodane jawnie
+         */
+        std::vector<label_t> vertices;
+
+        /**
+         * @brief krawędzie w kolejności dodania
+         */
+        std::vector<edge_t> edges;
+};
+
+#endif /* end of include guard: GRAPHBUILDER_HPP */
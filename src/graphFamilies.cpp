@@ -0,0 +1,263 @@
+/**
+ *      @file  graphFamilies.cpp
+ *     @brief  implementacja rodzin grafów testowych
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "graphFamilies.hpp"
+#include "canonicalForm.hpp"
+#include "graphBuilder.hpp"
+
+typedef Graph::label_t label_t;
+
+namespace
+{
+
+/**
+ * @brief certyfikat kanoniczny grafu
+ */
+CanonicalForm::certificate_t certificate(const Graph &graph)
+{
+    CanonicalForm form(graph);
+    form.canonize();
+    return form.getCertificate();
+}
+
+/**
+ * @brief najmniejsza liczba pierwsza nie mniejsza od n
+ */
+unsigned int nextPrime(unsigned int n)
+{
+    for(;; ++n) {
+        bool prime = n >= 2;
+        for(unsigned int d = 2; prime && d * d <= n; ++d) {
+            prime = n % d != 0;
+        }
+        if (prime) {
+            return n;
+        }
+    }
+}
+
+/**
+ * @brief losowy zbiór przesunięć turnieju cyrkulantowego na Z_n
+ * (posortowany)
+ */
+std::vector<unsigned int> tournamentShifts(unsigned int n, RandomEngine &engine)
+{
+    std::vector<unsigned int> shifts;
+    for(unsigned int s = 1; s <= n / 2; ++s) {
+        shifts.push_back((engine() & 1) ? s : n - s);
+    }
+    std::sort(shifts.begin(), shifts.end());
+    return shifts;
+}
+
+/**
+ * @brief czy T = aS (mod p) dla pewnego a - wtedy cyrkulanty są
+ * izomorficzne, dla p pierwszego także na odwrót
+ */
+bool multiplierEquivalent(const std::vector<unsigned int> &S,
+        const std::vector<unsigned int> &T, unsigned int p)
+{
+    std::vector<unsigned int> aS(S.size());
+    for(unsigned int a = 1; a < p; ++a) {
+        for(size_t i = 0; i < S.size(); ++i) {
+            aS[i] = (unsigned int) ((unsigned long long) a * S[i] % p);
+        }
+        std::sort(aS.begin(), aS.end());
+        if (aS == T) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief zamień końce dwóch losowych krawędzi a -> b, c -> d na
+ * a -> d, c -> b; stopnie wszystkich wierzchołków się nie zmieniają
+ *
+ * @return czy znaleziono parę krawędzi do zamiany
+ */
+bool swapEdges(const Graph &graph, RandomEngine &engine, Graph &result)
+{
+    using std::vector;
+
+    Graph::edge_set_t edge_set;
+    graph.getEdges(edge_set);
+    vector<Graph::Edge> edges(edge_set.begin(), edge_set.end());
+    if (edges.size() < 2) {
+        return false;
+    }
+
+    for(unsigned int attempt = 0; attempt < FAMILY_MAX_ATTEMPTS; ++attempt) {
+        size_t i = engine() % edges.size();
+        size_t j = engine() % edges.size();
+        label_t a = edges[i].source, b = edges[i].target;
+        label_t c = edges[j].source, d = edges[j].target;
+        if (a == c || b == d || a == d || c == b ||
+                graph.isConnection(a, d) || graph.isConnection(c, b)) {
+            continue;
+        }
+        edges[i].target = d;
+        edges[j].target = b;
+
+        GraphBuilder builder;
+        builder.reserve(edges.size());
+        for(Graph::iterator it = graph.begin(); it != graph.end(); ++it) {
+            builder.addVertex(*it);
+        }
+        for(size_t e = 0; e < edges.size(); ++e) {
+            builder.addEdge(edges[e].source, edges[e].target);
+        }
+        result = builder.build();
+        return true;
+    }
+    return false;
+}
+
+}
+
+bool parseFamily(const std::string &name, GraphFamily &family)
+{
+    for(int f = FAMILY_RANDOM; f <= FAMILY_TOURNAMENT; ++f) {
+        if (name == familyName((GraphFamily) f)) {
+            family = (GraphFamily) f;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string familyName(GraphFamily family)
+{
+    switch (family) {
+        case FAMILY_GRID:
+            return "grid";
+        case FAMILY_REGULAR:
+            return "regular";
+        case FAMILY_STRONGLY_REGULAR:
+            return "srg";
+        case FAMILY_CFI:
+            return "cfi";
+        case FAMILY_MIYAZAKI:
+            return "miyazaki";
+        case FAMILY_TOURNAMENT:
+            return "tournament";
+        case FAMILY_RANDOM:
+        default:
+            return "random";
+    }
+}
+
+bool familyUsesDensity(GraphFamily family)
+{
+    return family == FAMILY_RANDOM || family == FAMILY_REGULAR;
+}
+
+bool generateFamilyPair(GraphFamily family, unsigned int size, double density,
+        bool isomorphic, RandomEngine &engine, Graph &gX, Graph &gY)
+{
+    using std::max;
+    using std::min;
+    using std::vector;
+
+    Graph other;
+    switch (family) {
+        case FAMILY_GRID: {
+            if (!isomorphic) {
+                return false;
+            }
+            unsigned int rows = max(1u, (unsigned int) std::sqrt((double) size));
+            gX = Graph::generateGrid(rows, max(1u, size / rows));
+            break;
+        }
+        case FAMILY_REGULAR: {
+            unsigned int n = max(size, 3u);
+            unsigned int degree = (unsigned int) (density * (n - 1) + 0.5);
+            degree = max(1u, min(degree, n - 2));
+            gX = Graph::generateRegular(n, degree, engine);
+            if (isomorphic) {
+                break;
+            }
+            CanonicalForm::certificate_t cert = certificate(gX);
+            unsigned int attempt = 0;
+            do {
+                if (attempt++ == FAMILY_MAX_ATTEMPTS) {
+                    return false;
+                }
+                other = Graph::generateRegular(n, degree, engine);
+            } while (certificate(other) == cert);
+            break;
+        }
+        case FAMILY_STRONGLY_REGULAR: {
+            // rząd podzielny przez 4, żeby Z_n i Z_2 x Z_{n/2} były różne
+            unsigned int order = (unsigned int) (std::sqrt((double) size) / 4 + 0.5);
+            order = 4 * max(2u, order);
+            gX = Graph::generateLatinSquare(order, false);
+            if (!isomorphic) {
+                other = Graph::generateLatinSquare(order, true);
+            }
+            break;
+        }
+        case FAMILY_CFI:
+        case FAMILY_MIYAZAKI: {
+            unsigned int base = size / 10;
+            base = max(family == FAMILY_CFI ? 4u : 6u, base + base % 2);
+            if (family == FAMILY_CFI) {
+                gX = Graph::generateCfi(base, false);
+                other = Graph::generateCfi(base, !isomorphic);
+            }
+            else {
+                gX = Graph::generateMiyazaki(base, false);
+                other = Graph::generateMiyazaki(base, !isomorphic);
+            }
+            break;
+        }
+        case FAMILY_TOURNAMENT: {
+            unsigned int p = nextPrime(max(size, 7u));
+            if (isomorphic) {
+                gX = Graph::generateTournament(p, engine);
+                break;
+            }
+            for(unsigned int attempt = 0; ; ++attempt) {
+                if (attempt == FAMILY_MAX_ATTEMPTS) {
+                    return false;
+                }
+                vector<unsigned int> S = tournamentShifts(p, engine);
+                vector<unsigned int> T = tournamentShifts(p, engine);
+                if (!multiplierEquivalent(S, T, p)) {
+                    gX = Graph::generateCirculant(p, S);
+                    other = Graph::generateCirculant(p, T);
+                    break;
+                }
+            }
+            break;
+        }
+        case FAMILY_RANDOM:
+        default: {
+            gX = Graph::generateRandom(max(size, 1u), density, engine);
+            if (isomorphic) {
+                break;
+            }
+            CanonicalForm::certificate_t cert = certificate(gX);
+            unsigned int attempt = 0;
+            do {
+                if (attempt++ == FAMILY_MAX_ATTEMPTS ||
+                        !swapEdges(gX, engine, other)) {
+                    return false;
+                }
+            } while (certificate(other) == cert);
+            break;
+        }
+    }
+
+    gY.randomIsomorphic(other.isEmpty() ? gX : other, engine);
+    return true;
+}
@@ -0,0 +1,105 @@
+/**
+ *      @file  graphFamilies.hpp
+ *     @brief  rodziny grafów testowych i generowanie par instancji
+ *
+ * Detailed description starts here.
+ *
+ * Wspólny punkt wejścia do generatorów \ref Graph (losowe, kraty, regularne,
+ * silnie regularne, CFI, Miyazakiego, turnieje), wykorzystywany przez
+ * interfejs linii poleceń i program pomiarowy. Para nieizomorficzna ma
+ * zawsze te same niezmienniki stopni, a dla rodzin trudnych - także te
+ * same kolory stabilne.
+ *
+ *=====================================================================================
+ */
+
+#ifndef GRAPHFAMILIES_HPP
+#define GRAPHFAMILIES_HPP
+
+#include <string>
+
+#include "graph.hpp"
+#include "randomEngine.hpp"
+
+/**
+ * @brief ile razy losować parę nieizomorficzną, zanim generator się podda
+ */
+#define FAMILY_MAX_ATTEMPTS 32
+
+/**
+ * @brief rodziny grafów testowych
+ */
+enum GraphFamily
+{
+    FAMILY_RANDOM,          /**< losowy graf skierowany, spójny (\ref Graph::generateRandom) */
+    FAMILY_GRID,            /**< krata (\ref Graph::generateGrid) */
+    FAMILY_REGULAR,         /**< losowy graf d-regularny (\ref Graph::generateRegular) */
+    FAMILY_STRONGLY_REGULAR,/**< graf kwadratu łacińskiego (\ref Graph::generateLatinSquare) */
+    FAMILY_CFI,             /**< CFI nad drabiną Möbiusa (\ref Graph::generateCfi) */
+    FAMILY_MIYAZAKI,        /**< CFI nad drabiną cykliczną (\ref Graph::generateMiyazaki) */
+    FAMILY_TOURNAMENT       /**< turniej regularny (\ref Graph::generateTournament) */
+};
+
+/**
+ * @brief zamień nazwę rodziny na wartość \ref GraphFamily
+ *
+ * Rozpoznawane nazwy: `random', `grid', `regular', `srg', `cfi',
+ * `miyazaki', `tournament'.
+ *
+ * @param name nazwa rodziny
+ * @param family wynik
+ *
+ * @return czy nazwa jest poprawna
+ */
+bool parseFamily(const std::string &name, GraphFamily &family);
+
+/**
+ * @brief nazwa rodziny
+ *
+ * @param family rodzina
+ *
+ * @return nazwa rozpoznawana przez \ref parseFamily
+ */
+std::string familyName(GraphFamily family);
+
+/**
+ * @brief czy rodzina korzysta z parametru gęstości
+ *
+ * @param family rodzina
+ *
+ * @return czy gęstość ma znaczenie (rodziny random i regular)
+ */
+bool familyUsesDensity(GraphFamily family);
+
+/**
+ * @brief wygeneruj parę grafów z rodziny
+ *
+ * Liczba wierzchołków jest zaokrąglana do najbliższej, dla której rodzina
+ * istnieje (np. kwadrat rzędu podzielnego przez 4 dla srg, liczba pierwsza
+ * dla turniejów, wielokrotność 10 dla CFI). Graf Y pary izomorficznej to
+ * losowa permutacja grafu X. Para nieizomorficzna:
+ *  - random - Y powstaje z X przez zamianę końców dwóch krawędzi
+ *    (zachowuje stopnie wejściowe i wyjściowe),
+ *  - regular - dwa niezależne grafy o tym samym stopniu,
+ *  - srg - kwadraty łacińskie grup Z_n i Z_2 x Z_{n/2},
+ *  - cfi, miyazaki - wersja nieskręcona i skręcona,
+ *  - tournament - cyrkulanty Z_p o zbiorach S i T, gdzie T != aS dla
+ *    każdego a.
+ * Tam, gdzie konstrukcja nie gwarantuje nieizomorficzności (random,
+ * regular), jest ona sprawdzana certyfikatem \ref CanonicalForm.
+ *
+ * @param family rodzina
+ * @param size przybliżona liczba wierzchołków
+ * @param density gęstość (rodziny random i regular)
+ * @param isomorphic czy para ma być izomorficzna
+ * @param engine generator liczb losowych
+ * @param gX wynik - graf X
+ * @param gY wynik - graf Y (permutowany losowo)
+ *
+ * @return czy udało się wygenerować parę (rodzina grid nie ma par
+ * nieizomorficznych o tej samej liczbie wierzchołków i stopniach)
+ */
+bool generateFamilyPair(GraphFamily family, unsigned int size, double density,
+        bool isomorphic, RandomEngine &engine, Graph &gX, Graph &gY);
+
+#endif /* end of include guard: GRAPHFAMILIES_HPP */
@@ -0,0 +1,722 @@
+/**
+ *      @file  graphFormats.cpp
+ *     @brief  implementacja odczytu i zapisu formatów wymiany grafów
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "graphFormats.hpp"
+#include "graphBuilder.hpp"
+#include "graphParser.hpp"
+#include "frozenGraph.hpp"
+#include "mappedFile.hpp"
+
+typedef Graph::label_t label_t;
+typedef FrozenGraph::idx_t idx_t;
+
+namespace
+{
+
+/**
+ * @brief największy znacznik wierzchołka
+ */
+const unsigned long long LABEL_LIMIT = std::numeric_limits<label_t>::max();
+
+/**
+ * @brief największa pomijana waga (bez przepełnienia przy odczycie)
+ */
+const unsigned long long WEIGHT_LIMIT = 1000000000000000000ULL;
+
+/**
+ * @brief największa liczba wierzchołków w nagłówku DIMACS
+ *
+ * Wierzchołki 1..n powstają od razu, także izolowane, więc nagłówek
+ * kilkunastobajtowego pliku mógłby wymusić przydział dowolnej pamięci.
+ * Limit jest z zapasem większy od grafów z konkursów DIMACS (sieć dróg
+ * USA - 24 mln wierzchołków).
+ */
+const unsigned long long DIMACS_VERTEX_LIMIT = 1ULL << 26;
+
+/**
+ * @brief rzuć błąd wiersza w formacie operator>>
+ *
+ * @param line numer wiersza
+ * @param message opis błędu
+ */
+void fail(unsigned int line, const std::string &message)
+{
+    std::stringstream ss;
+    ss << "Linia [" << line << "]> " << message;
+    throw std::invalid_argument(ss.str());
+}
+
+/**
+ * @brief czy znak jest odstępem wewnątrz wiersza
+ */
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief pomiń odstępy
+ */
+inline const char *skipBlank(const char *it, const char *end)
+{
+    while (it != end && isBlank(*it)) {
+        ++it;
+    }
+    return it;
+}
+
+/**
+ * @brief wyznacz kolejny wiersz tekstu (bez znaku końca wiersza i `\\r')
+ *
+ * @param it bieżąca pozycja, przesuwana na początek następnego wiersza
+ * @param end koniec tekstu
+ * @param line_begin początek wiersza
+ * @param line_end koniec wiersza
+ *
+ * @return czy był jeszcze wiersz
+ */
+bool nextLine(const char *&it, const char *end, const char *&line_begin,
+        const char *&line_end)
+{
+    if (it == end) {
+        return false;
+    }
+    line_begin = it;
+    const char *newline = static_cast<const char *>(memchr(it, '\n', end - it));
+    line_end = (newline == NULL) ? end : newline;
+    it = (newline == NULL) ? end : newline + 1;
+    if (line_end != line_begin && line_end[-1] == '\r') {
+        --line_end;
+    }
+    return true;
+}
+
+/**
+ * @brief odczytaj liczbę naturalną rozdzieloną odstępami
+ *
+ * @param it bieżąca pozycja, przesuwana za liczbę
+ * @param end koniec wiersza
+ * @param line numer wiersza dla komunikatu błędu
+ * @param limit największa dopuszczalna wartość
+ * @param value wynik
+ *
+ * @return czy przed końcem wiersza była liczba
+ */
+bool readNumber(const char *&it, const char *end, unsigned int line,
+        unsigned long long limit, unsigned long long &value)
+{
+    it = skipBlank(it, end);
+    if (it == end) {
+        return false;
+    }
+    if (*it < '0' || *it > '9') {
+        fail(line, "Oczekiwano liczby naturalnej");
+    }
+    value = 0;
+    for(; it != end && *it >= '0' && *it <= '9'; ++it) {
+        value = value * 10 + (*it - '0');
+        if (value > limit) {
+            fail(line, "Liczba przekracza wymiar");
+        }
+    }
+    if (it != end && !isBlank(*it)) {
+        fail(line, "Oczekiwano liczby naturalnej");
+    }
+    return true;
+}
+
+/**
+ * @brief odczytaj wierzchołek z zakresu 1..n
+ *
+ * @param it bieżąca pozycja, przesuwana za liczbę
+ * @param end koniec wiersza
+ * @param line numer wiersza dla komunikatu błędu
+ * @param n liczba wierzchołków
+ * @param value wynik
+ *
+ * @return czy przed końcem wiersza była liczba
+ */
+bool readVertex(const char *&it, const char *end, unsigned int line,
+        unsigned long long n, unsigned long long &value)
+{
+    if (!readNumber(it, end, line, LABEL_LIMIT, value)) {
+        return false;
+    }
+    if (value < 1 || value > n) {
+        fail(line, "Wierzchołek spoza zakresu 1..n");
+    }
+    return true;
+}
+
+/**
+ * @brief lista krawędzi: `źródło cel' w wierszu, sam znacznik to wierzchołek
+ * izolowany; dalsza część wiersza (wagi) i tekst od `#' lub `%' są
+ * pomijane
+ */
+void parseEdgeList(const char *begin, const char *end, GraphBuilder &builder)
+{
+    const char *line_begin, *line_end;
+    const char *it = begin;
+    for(unsigned int line = 1; nextLine(it, end, line_begin, line_end); ++line) {
+        for(const char *c = line_begin; c != line_end; ++c) {
+            if (*c == '#' || *c == '%') {
+                line_end = c;
+                break;
+            }
+        }
+
+        unsigned long long source, target;
+        const char *pos = line_begin;
+        if (!readNumber(pos, line_end, line, LABEL_LIMIT, source)) {
+            continue;
+        }
+        if (!readNumber(pos, line_end, line, LABEL_LIMIT, target)) {
+            builder.addVertex(source);
+            continue;
+        }
+        builder.addEdge(source, target);
+    }
+}
+
+/**
+ * @brief DIMACS: `c' - komentarz, `p <typ> n m' - nagłówek (wierzchołki
+ * 1..n), `e u v' - krawędź nieskierowana, `a u v [waga]' - łuk
+ */
+void parseDimacs(const char *begin, const char *end, GraphBuilder &builder)
+{
+    unsigned long long n = 0;
+    bool header = false;
+
+    const char *line_begin, *line_end;
+    const char *it = begin;
+    for(unsigned int line = 1; nextLine(it, end, line_begin, line_end); ++line) {
+        const char *pos = skipBlank(line_begin, line_end);
+        if (pos == line_end) {
+            continue;
+        }
+        char kind = *pos++;
+        if (kind == 'c') {
+            continue;
+        }
+        if (kind == 'p') {
+            if (header) {
+                fail(line, "Powtórzony wiersz `p'");
+            }
+            // typ problemu (edge, col, sp, ...) nie ma znaczenia
+            pos = skipBlank(pos, line_end);
+            while (pos != line_end && !isBlank(*pos)) {
+                ++pos;
+            }
+            unsigned long long m;
+            if (!readNumber(pos, line_end, line, LABEL_LIMIT, n)) {
+                fail(line, "Brak liczby wierzchołków");
+            }
+            if (n > DIMACS_VERTEX_LIMIT) {
+                fail(line, "Liczba wierzchołków przekracza limit formatu DIMACS");
+            }
+            if (readNumber(pos, line_end, line,
+                        std::numeric_limits<unsigned int>::max(), m)) {
+                // zapowiedź z nagłówka tylko do rozmiaru pliku - wiersz
+                // krawędzi `e u v' ma co najmniej 6 znaków
+                builder.reserve(std::min(m, (unsigned long long) (end - it) / 6));
+            }
+            for(unsigned long long v = 1; v <= n; ++v) {
+                builder.addVertex(v);
+            }
+            header = true;
+            continue;
+        }
+        if (kind != 'e' && kind != 'a') {
+            fail(line, std::string("Nieznany typ wiersza `") + kind + "'");
+        }
+        if (!header) {
+            fail(line, "Brak wiersza `p' przed krawędziami");
+        }
+
+        unsigned long long u, v;
+        if (!readVertex(pos, line_end, line, n, u) ||
+                !readVertex(pos, line_end, line, n, v)) {
+            fail(line, "Brak wierzchołka krawędzi");
+        }
+        builder.addEdge(u, v);
+        if (kind == 'e') {
+            builder.addEdge(v, u);
+        }
+    }
+}
+
+/**
+ * @brief METIS: nagłówek `n m [fmt [ncon]]', potem wiersz sąsiadów (od 1)
+ * dla każdego wierzchołka; `fmt' określa obecność rozmiarów, wag
+ * wierzchołków i wag krawędzi, które są pomijane
+ */
+void parseMetis(const char *begin, const char *end, GraphBuilder &builder)
+{
+    unsigned long long n = 0, m = 0, fmt = 0, ncon = 1;
+    unsigned int header_line = 0;
+    unsigned long long vertex = 0, arcs = 0;
+
+    const char *line_begin, *line_end;
+    const char *it = begin;
+    for(unsigned int line = 1; nextLine(it, end, line_begin, line_end); ++line) {
+        if (line_begin != line_end && *line_begin == '%') {
+            continue;
+        }
+        const char *pos = line_begin;
+
+        if (header_line == 0) {
+            if (!readNumber(pos, line_end, line, LABEL_LIMIT, n)) {
+                continue;
+            }
+            if (!readNumber(pos, line_end, line, LABEL_LIMIT, m)) {
+                fail(line, "Brak liczby krawędzi w nagłówku");
+            }
+            if (readNumber(pos, line_end, line, 111, fmt)) {
+                if (fmt % 10 > 1 || fmt / 10 % 10 > 1) {
+                    fail(line, "Zły format wag `fmt'");
+                }
+                readNumber(pos, line_end, line, LABEL_LIMIT, ncon);
+            }
+            // każdy wierzchołek ma własny wiersz, więc nagłówek nie może
+            // zapowiedzieć więcej wierzchołków, niż zostało wierszy
+            if (n > (unsigned long long) std::count(it, end, '\n') + 1) {
+                fail(line, "Liczba wierzchołków większa niż liczba wierszy");
+            }
+            header_line = line;
+            // zapowiedź z nagłówka tylko do rozmiaru pliku - każdy sąsiad
+            // to co najmniej cyfra i odstęp
+            builder.reserve(std::min(2 * m,
+                        (unsigned long long) (end - it) / 2));
+            for(unsigned long long v = 1; v <= n; ++v) {
+                builder.addVertex(v);
+            }
+            continue;
+        }
+
+        if (++vertex > n) {
+            if (skipBlank(line_begin, line_end) != line_end) {
+                fail(line, "Więcej list sąsiedztwa niż wierzchołków");
+            }
+            continue;
+        }
+
+        unsigned long long skipped;
+        unsigned long long weights = (fmt / 100 % 10) +
+            (fmt / 10 % 10) * ncon;
+        for(unsigned long long w = 0; w < weights; ++w) {
+            if (!readNumber(pos, line_end, line,
+                        WEIGHT_LIMIT,
+                        skipped)) {
+                fail(line, "Brak wagi wierzchołka");
+            }
+        }
+
+        unsigned long long target;
+        while (readVertex(pos, line_end, line, n, target)) {
+            builder.addEdge(vertex, target);
+            ++arcs;
+            if (fmt % 10 == 1 && !readNumber(pos, line_end, line,
+                        WEIGHT_LIMIT,
+                        skipped)) {
+                fail(line, "Brak wagi krawędzi");
+            }
+        }
+    }
+
+    if (header_line != 0 && arcs != 2 * m) {
+        fail(header_line, "Liczba krawędzi niezgodna z nagłówkiem");
+    }
+}
+
+/**
+ * @brief dekoder bajtów graph6 (6 bitów na znak 63..126)
+ */
+struct SixBitReader
+{
+    const char *it;
+    const char *end;
+    unsigned int line;
+
+    unsigned int next()
+    {
+        if (this->it == this->end) {
+            fail(this->line, "Niepełny zapis graph6");
+        }
+        unsigned char c = *this->it++;
+        if (c < 63 || c > 126) {
+            fail(this->line, "Znak spoza zakresu graph6");
+        }
+        return c - 63;
+    }
+};
+
+/**
+ * @brief graph6 / digraph6 (prefiks `&'): liczba wierzchołków N(n),
+ * potem macierz sąsiedztwa po 6 bitów na znak - w graph6 górny trójkąt
+ * kolumnami, w digraph6 cała macierz wierszami; wierzchołki 0..n-1.
+ * Czytany jest pierwszy niepusty wiersz pliku.
+ */
+void parseNauty(const char *begin, const char *end, GraphBuilder &builder)
+{
+    const char *line_begin = NULL, *line_end = NULL;
+    const char *it = begin;
+    unsigned int line = 1;
+    for(;; ++line) {
+        if (!nextLine(it, end, line_begin, line_end)) {
+            return;
+        }
+        if (line_begin != line_end) {
+            break;
+        }
+    }
+
+    const char *pos = line_begin;
+    const char *headers[] = {">>graph6<<", ">>digraph6<<"};
+    for(size_t h = 0; h < 2; ++h) {
+        size_t length = strlen(headers[h]);
+        if ((size_t) (line_end - pos) >= length &&
+                memcmp(pos, headers[h], length) == 0) {
+            pos += length;
+        }
+    }
+    if (pos != line_end && *pos == ':') {
+        fail(line, "Format sparse6 nie jest obsługiwany");
+    }
+    bool directed = (pos != line_end && *pos == '&');
+    if (directed) {
+        ++pos;
+    }
+
+    SixBitReader reader = {pos, line_end, line};
+    unsigned long long n = reader.next();
+    if (n == 63) {
+        // 126 + 3 znaki (18 bitów) lub 126 126 + 6 znaków (36 bitów)
+        unsigned int count = 2;
+        n = reader.next();
+        if (n == 63) {
+            count = 6;
+            n = 0;
+        }
+        for(unsigned int i = 0; i < count; ++i) {
+            n = (n << 6) | reader.next();
+        }
+    }
+    if (n > LABEL_LIMIT) {
+        fail(line, "Liczba wierzchołków przekracza wymiar");
+    }
+
+    unsigned long long bits = directed ? n * n : n * (n - (n > 0)) / 2;
+    unsigned long long bytes = (bits + 5) / 6;
+    if ((unsigned long long) (reader.end - reader.it) != bytes) {
+        fail(line, "Zła długość macierzy sąsiedztwa");
+    }
+
+    for(unsigned long long v = 0; v < n; ++v) {
+        builder.addVertex(v);
+    }
+
+    // kolumna j górnego trójkąta zaczyna się od bitu base = j(j-1)/2
+    unsigned long long column = 1, base = 0;
+    for(unsigned long long p = 0; p < bytes; ++p) {
+        unsigned int x = reader.next();
+        while (x != 0) {
+            unsigned int high = 31 - __builtin_clz(x);
+            x ^= 1u << high;
+            unsigned long long k = 6 * p + 5 - high;
+            if (k >= bits) {
+                // bity dopełnienia
+                break;
+            }
+            if (directed) {
+                builder.addEdge(k / n, k % n);
+                continue;
+            }
+            while (k >= base + column) {
+                base += column++;
+            }
+            builder.addEdge(k - base, column);
+            builder.addEdge(column, k - base);
+        }
+    }
+}
+
+/**
+ * @brief czy każda krawędź ma krawędź przeciwną
+ */
+bool isSymmetric(const FrozenGraph &graph)
+{
+    for(idx_t v = 0; v < graph.getSize(); ++v) {
+        for(FrozenGraph::adj_iterator it = graph.adjBegin(v);
+                it != graph.adjEnd(v); ++it) {
+            if (!graph.isConnection(*it, v)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief zapisz graf jako graph6 lub digraph6
+ */
+void writeNauty(std::ostream &output, const FrozenGraph &graph, bool directed)
+{
+    using std::string;
+    using std::vector;
+
+    if (!directed && !isSymmetric(graph)) {
+        throw std::invalid_argument("Format graph6 wymaga grafu "
+                "nieskierowanego (użyj digraph6)");
+    }
+
+    unsigned long long n = graph.getSize();
+    string out = directed ? "&" : "";
+    if (n < 63) {
+        out += char(n + 63);
+    }
+    else {
+        unsigned int count = (n < 258048) ? 3 : 6;
+        out += char(126);
+        if (count == 6) {
+            out += char(126);
+        }
+        for(unsigned int i = count; i-- > 0; ) {
+            out += char(((n >> (6 * i)) & 63) + 63);
+        }
+    }
+
+    unsigned long long bits = directed ? n * n : n * (n - (n > 0)) / 2;
+    vector<unsigned char> data((bits + 5) / 6, 0);
+    for(idx_t v = 0; v < graph.getSize(); ++v) {
+        for(FrozenGraph::adj_iterator it = graph.adjBegin(v);
+                it != graph.adjEnd(v); ++it) {
+            unsigned long long k;
+            if (directed) {
+                k = v * n + *it;
+            }
+            else if (v < *it) {
+                k = (unsigned long long) *it * (*it - 1) / 2 + v;
+            }
+            else {
+                continue;
+            }
+            data[k / 6] |= 1 << (5 - k % 6);
+        }
+    }
+    for(size_t p = 0; p < data.size(); ++p) {
+        out += char(data[p] + 63);
+    }
+    out += '\n';
+    output.write(out.data(), out.size());
+}
+
+}
+
+bool parseFormat(const std::string &name, GraphFormat &format)
+{
+    for(int f = FORMAT_AUTO; f <= FORMAT_METIS; ++f) {
+        if (name == formatName((GraphFormat) f)) {
+            format = (GraphFormat) f;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string formatName(GraphFormat format)
+{
+    switch (format) {
+        case FORMAT_NATIVE:
+            return "native";
+        case FORMAT_EDGE_LIST:
+            return "edges";
+        case FORMAT_DIMACS:
+            return "dimacs";
+        case FORMAT_GRAPH6:
+            return "graph6";
+        case FORMAT_DIGRAPH6:
+            return "digraph6";
+        case FORMAT_METIS:
+            return "metis";
+        case FORMAT_AUTO:
+        default:
+            return "auto";
+    }
+}
+
+bool formatFromExtension(const std::string &filename, GraphFormat &format)
+{
+    static const struct
+    {
+        const char *extension;
+        GraphFormat format;
+    } extensions[] = {
+        {".txt", FORMAT_NATIVE},
+        {".edges", FORMAT_EDGE_LIST},
+        {".el", FORMAT_EDGE_LIST},
+        {".edgelist", FORMAT_EDGE_LIST},
+        {".dimacs", FORMAT_DIMACS},
+        {".col", FORMAT_DIMACS},
+        {".gr", FORMAT_DIMACS},
+        {".g6", FORMAT_GRAPH6},
+        {".d6", FORMAT_DIGRAPH6},
+        {".metis", FORMAT_METIS},
+        {".graph", FORMAT_METIS}
+    };
+
+    size_t dot = filename.rfind('.');
+    if (dot == std::string::npos || filename.find('/', dot) != std::string::npos) {
+        return false;
+    }
+    std::string extension = filename.substr(dot);
+    for(size_t e = 0; e < sizeof(extensions) / sizeof(extensions[0]); ++e) {
+        if (extension == extensions[e].extension) {
+            format = extensions[e].format;
+            return true;
+        }
+    }
+    return false;
+}
+
+void parseGraph(const char *begin, const char *end, GraphFormat format,
+        Graph &graph)
+{
+    GraphBuilder builder;
+    switch (format) {
+        case FORMAT_EDGE_LIST:
+            parseEdgeList(begin, end, builder);
+            break;
+        case FORMAT_DIMACS:
+            parseDimacs(begin, end, builder);
+            break;
+        case FORMAT_GRAPH6:
+        case FORMAT_DIGRAPH6:
+            parseNauty(begin, end, builder);
+            break;
+        case FORMAT_METIS:
+            parseMetis(begin, end, builder);
+            break;
+        case FORMAT_AUTO:
+        case FORMAT_NATIVE:
+        default:
+            GraphParser::parseParallel(begin, end, 1, graph);
+            return;
+    }
+    builder.build(graph);
+}
+
+void loadGraph(const std::string &filename, GraphFormat format, Graph &graph,
+        unsigned int threads)
+{
+    if (format == FORMAT_AUTO && !formatFromExtension(filename, format)) {
+        format = FORMAT_NATIVE;
+    }
+    if (format == FORMAT_NATIVE) {
+        graph.loadFromFile(filename, threads);
+        return;
+    }
+
+    MappedFile file(filename);
+    graph.clear();
+    parseGraph(file.getData(), file.getData() + file.getSize(), format, graph);
+}
+
+void writeGraph(std::ostream &output, GraphFormat format, const Graph &graph)
+{
+    if (format == FORMAT_AUTO || format == FORMAT_NATIVE) {
+        output << graph;
+        return;
+    }
+
+    FrozenGraph frozen(graph);
+    idx_t n = frozen.getSize();
+    switch (format) {
+        case FORMAT_EDGE_LIST:
+            for(idx_t v = 0; v < n; ++v) {
+                if (frozen.getOut(v) == 0 && frozen.getIn(v) == 0) {
+                    output << frozen.getLabel(v) << '\n';
+                }
+                for(FrozenGraph::adj_iterator it = frozen.adjBegin(v);
+                        it != frozen.adjEnd(v); ++it) {
+                    output << frozen.getLabel(v) << ' '
+                        << frozen.getLabel(*it) << '\n';
+                }
+            }
+            break;
+        case FORMAT_DIMACS: {
+            bool symmetric = isSymmetric(frozen);
+            if (symmetric) {
+                output << "p edge " << n << ' ' << frozen.getEdgeCount() / 2
+                    << '\n';
+            }
+            else {
+                output << "p sp " << n << ' ' << frozen.getEdgeCount() << '\n';
+            }
+            for(idx_t v = 0; v < n; ++v) {
+                for(FrozenGraph::adj_iterator it = frozen.adjBegin(v);
+                        it != frozen.adjEnd(v); ++it) {
+                    if (!symmetric) {
+                        output << "a " << v + 1 << ' ' << *it + 1 << " 1\n";
+                    }
+                    else if (v < *it) {
+                        output << "e " << v + 1 << ' ' << *it + 1 << '\n';
+                    }
+                }
+            }
+            break;
+        }
+        case FORMAT_GRAPH6:
+        case FORMAT_DIGRAPH6:
+            writeNauty(output, frozen, format == FORMAT_DIGRAPH6);
+            break;
+        case FORMAT_METIS:
+            if (!isSymmetric(frozen)) {
+                throw std::invalid_argument("Format METIS wymaga grafu "
+                        "nieskierowanego");
+            }
+            output << n << ' ' << frozen.getEdgeCount() / 2 << '\n';
+            for(idx_t v = 0; v < n; ++v) {
+                for(FrozenGraph::adj_iterator it = frozen.adjBegin(v);
+                        it != frozen.adjEnd(v); ++it) {
+                    output << (it == frozen.adjBegin(v) ? "" : " ") << *it + 1;
+                }
+                output << '\n';
+            }
+            break;
+        default:
+            break;
+    }
+    output.flush();
+}
+
+void saveGraph(const std::string &filename, GraphFormat format,
+        const Graph &graph)
+{
+    using std::ofstream;
+    using std::runtime_error;
+
+    if (format == FORMAT_AUTO && !formatFromExtension(filename, format)) {
+        format = FORMAT_NATIVE;
+    }
+
+    ofstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("Nie udało się otworzyć pliku do zapisu");
+    }
+    writeGraph(file, format, graph);
+    file.close();
+}
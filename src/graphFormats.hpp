@@ -0,0 +1,121 @@
+/**
+ *      @file  graphFormats.hpp
+ *     @brief  odczyt i zapis grafów w standardowych formatach wymiany
+ *
+ * Detailed description starts here.
+ *
+ * Obok własnego formatu `znacznik: sąsiad, ...' obsługiwane są: lista
+ * krawędzi, DIMACS, graph6, digraph6 i METIS. Format wybierany jest jawnie
+ * lub po rozszerzeniu pliku. Czytniki działają na tekście w pamięci (plik
+ * odwzorowany przez \ref MappedFile) i budują graf przez
+ * \ref GraphBuilder.
+ *
+ *=====================================================================================
+ */
+
+#ifndef GRAPHFORMATS_HPP
+#define GRAPHFORMATS_HPP
+
+#include <string>
+#include <ostream>
+
+#include "graph.hpp"
+
+/**
+ * @brief formaty plików z grafem
+ */
+enum GraphFormat
+{
+    FORMAT_AUTO,        /**< rozpoznanie po rozszerzeniu, domyślnie FORMAT_NATIVE */
+    FORMAT_NATIVE,      /**< `znacznik: sąsiad, sąsiad, ...' (.txt) */
+    FORMAT_EDGE_LIST,   /**< wiersze `źródło cel' (.edges, .el) */
+    FORMAT_DIMACS,      /**< wiersze `p', `e' i `a' (.dimacs, .col, .gr) */
+    FORMAT_GRAPH6,      /**< graf nieskierowany nauty (.g6) */
+    FORMAT_DIGRAPH6,    /**< graf skierowany nauty (.d6) */
+    FORMAT_METIS        /**< listy sąsiedztwa METIS (.metis, .graph) */
+};
+
+/**
+ * @brief zamień nazwę formatu na wartość \ref GraphFormat
+ *
+ * Rozpoznawane nazwy: `auto', `native', `edges', `dimacs', `graph6',
+ * `digraph6', `metis'.
+ *
+ * @param name nazwa formatu
+ * @param format wynik
+ *
+ * @return czy nazwa jest poprawna
+ */
+bool parseFormat(const std::string &name, GraphFormat &format);
+
+/**
+ * @brief nazwa formatu
+ *
+ * @param format format
+ *
+ * @return nazwa rozpoznawana przez \ref parseFormat
+ */
+std::string formatName(GraphFormat format);
+
+/**
+ * @brief rozpoznaj format po rozszerzeniu pliku
+ *
+ * @param filename nazwa pliku
+ * @param format wynik
+ *
+ * @return czy rozszerzenie jest znane
+ */
+bool formatFromExtension(const std::string &filename, GraphFormat &format);
+
+/**
+ * @brief wczytaj graf z tekstu w pamięci
+ *
+ * Wierzchołki formatów bez znaczników (DIMACS, METIS - od 1, graph6,
+ * digraph6 - od 0) dostają kolejne numery. Rzuca std::invalid_argument
+ * z komunikatem `Linia [k]> ...'.
+ *
+ * @param begin początek tekstu
+ * @param end koniec tekstu
+ * @param format format (FORMAT_AUTO - FORMAT_NATIVE)
+ * @param graph graf uzupełniany o wczytane wierzchołki i krawędzie
+ */
+void parseGraph(const char *begin, const char *end, GraphFormat format,
+        Graph &graph);
+
+/**
+ * @brief wczytaj graf z pliku
+ *
+ * @param filename nazwa pliku
+ * @param format format (FORMAT_AUTO - po rozszerzeniu)
+ * @param graph wczytywany graf (czyszczony)
+ * @param threads liczba wątków parsera formatu FORMAT_NATIVE
+ * (\ref Graph::loadFromFile)
+ */
+void loadGraph(const std::string &filename, GraphFormat format, Graph &graph,
+        unsigned int threads = 1);
+
+/**
+ * @brief zapisz graf w podanym formacie
+ *
+ * Formaty bez znaczników numerują wierzchołki w kolejności znaczników.
+ * DIMACS zapisuje graf symetryczny jako krawędzie `e', a skierowany jako
+ * łuki `a'. Dla grafu skierowanego graph6 i METIS rzucają
+ * std::invalid_argument.
+ *
+ * @param output strumień wyjściowy
+ * @param format format (FORMAT_AUTO - FORMAT_NATIVE)
+ * @param graph zapisywany graf
+ */
+void writeGraph(std::ostream &output, GraphFormat format, const Graph &graph);
+
+/**
+ * @brief zapisz graf do pliku
+ *
+ * @param filename nazwa pliku
+ * @param format format (FORMAT_AUTO - po rozszerzeniu)
+ * @param graph zapisywany graf
+ */
+void saveGraph(const std::string &filename, GraphFormat format,
+        const Graph &graph);
+
+#endif /* end of include guard: GRAPHFORMATS_HPP */
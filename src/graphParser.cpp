@@ -0,0 +1,309 @@
+/**
+ *      @file  graphParser.cpp
+ *     @brief  implementacja metod klasy GraphParser
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "graphParser.hpp"
+
+typedef Graph::label_t label_t;
+
+namespace {
+
+/**
+ * @brief wynik odczytu liczby
+ */
+enum NumberStatus
+{
+    NUMBER_OK,          /**< poprawna liczba */
+    NUMBER_INVALID,     /**< brak cyfr (stoi: std::invalid_argument) */
+    NUMBER_RANGE        /**< liczba spoza int (stoi: std::out_of_range) */
+};
+
+/**
+ * @brief czy znak jest białym znakiem w locale "C"
+ */
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' ||
+        c == '\r';
+}
+
+/**
+ * @brief odczytaj liczbę tak jak stoi
+ *
+ * Wiodące białe znaki są pomijane, potem opcjonalny znak i cyfry; tekst
+ * za liczbą jest ignorowany. Przy \p strip białe znaki są pomijane także
+ * wewnątrz liczby - tak jak stoi na tekście po strip_space().
+ *
+ * @param begin początek tekstu
+ * @param end koniec tekstu
+ * @param strip czy pomijać białe znaki wewnątrz liczby
+ * @param value wynik (wartość int rzutowana na znacznik)
+ *
+ * @return status odczytu
+ */
+NumberStatus parseNumber(const char *begin, const char *end, bool strip,
+        label_t &value)
+{
+    const char *it = begin;
+    while (it != end && isSpace(*it)) {
+        ++it;
+    }
+
+    bool negative = false;
+    if (it != end && (*it == '+' || *it == '-')) {
+        negative = (*it == '-');
+        ++it;
+    }
+
+    // 2^31 - moduł najmniejszej wartości int
+    const unsigned long long limit = 2147483648ULL;
+    unsigned long long magnitude = 0;
+    bool digits = false;
+    for(; it != end; ++it) {
+        if (strip && isSpace(*it)) {
+            continue;
+        }
+        if (*it < '0' || *it > '9') {
+            break;
+        }
+        digits = true;
+        if (magnitude <= limit) {
+            magnitude = magnitude * 10 + (*it - '0');
+        }
+    }
+
+    if (!digits) {
+        return NUMBER_INVALID;
+    }
+    if (magnitude > limit || (!negative && magnitude == limit)) {
+        return NUMBER_RANGE;
+    }
+    value = negative ? label_t(-(long long) magnitude) : label_t(magnitude);
+    return NUMBER_OK;
+}
+
+}
+
+GraphParser::GraphParser():
+    line_number(0), failed(false)
+{}
+
+void GraphParser::parse(std::istream &input, Graph &graph)
+{
+    using std::vector;
+
+    vector<char> buffer(PARSER_CHUNK_SIZE);
+    size_t filled = 0;
+
+    try {
+        for(;;) {
+            if (filled == buffer.size()) {
+                // wiersz dłuższy niż blok
+                buffer.resize(2 * buffer.size());
+            }
+            input.read(buffer.data() + filled, buffer.size() - filled);
+            filled += input.gcount();
+            const char *end = buffer.data() + filled;
+
+            if (!input) {
+                this->parseBlock(buffer.data(), end);
+                break;
+            }
+
+            // pełne wiersze bloku, niedokończony wiersz na początek bloku
+            const char *line = end;
+            while (line != buffer.data() && line[-1] != '\n') {
+                --line;
+            }
+            this->parseBlock(buffer.data(), line);
+            filled = end - line;
+            memmove(buffer.data(), line, filled);
+        }
+    }
+    catch (ParseError &e) {
+        throw std::invalid_argument(errorMessage(e.line, e.message));
+    }
+
+    this->builder.build(graph);
+}
+
+void GraphParser::parseParallel(const char *begin, const char *end,
+        unsigned int threads, Graph &graph)
+{
+    using std::thread;
+    using std::vector;
+
+    if (threads == 0) {
+        threads = std::max(1u, thread::hardware_concurrency());
+    }
+    size_t size = end - begin;
+    size_t chunks = std::max<size_t>(1,
+            std::min<size_t>(threads, size / PARSER_MIN_SPLIT));
+
+    // granice fragmentów przesunięte za najbliższy znak nowego wiersza
+    vector<const char *> bounds(chunks + 1, end);
+    bounds[0] = begin;
+    for(size_t c = 1; c < chunks; ++c) {
+        const char *bound = std::max(bounds[c - 1], begin + size * c / chunks);
+        const char *newline = static_cast<const char *>(memchr(bound, '\n',
+                    end - bound));
+        bounds[c] = (newline == NULL) ? end : newline + 1;
+    }
+
+    vector<GraphParser> parsers(chunks);
+    vector<thread> workers;
+    for(size_t c = 1; c < chunks; ++c) {
+        workers.push_back(thread(&GraphParser::parseChunk, &parsers[c],
+                    bounds[c], bounds[c + 1]));
+    }
+    parsers[0].parseChunk(bounds[0], bounds[1]);
+    for(size_t w = 0; w < workers.size(); ++w) {
+        workers[w].join();
+    }
+
+    // pierwszy błąd w kolejności pliku; wcześniejsze fragmenty wczytano
+    // w całości, więc znamy ich liczbę niepustych wierszy
+    unsigned int lines = 0;
+    for(size_t c = 0; c < chunks; ++c) {
+        if (parsers[c].failed) {
+            throw std::invalid_argument(errorMessage(
+                        lines + parsers[c].error.line,
+                        parsers[c].error.message));
+        }
+        lines += parsers[c].line_number;
+    }
+
+    // krawędzie fragmentów w jednym budowniczym, graf budowany raz
+    GraphBuilder &merged = parsers[0].builder;
+    for(size_t c = 1; c < chunks; ++c) {
+        merged.append(parsers[c].builder);
+        parsers[c].builder.clear();
+    }
+    merged.build(graph);
+}
+
+void GraphParser::parseBlock(const char *begin, const char *end)
+{
+    const char *line = begin;
+    for(;;) {
+        const char *newline =
+            static_cast<const char *>(memchr(line, '\n', end - line));
+        if (newline == NULL) {
+            break;
+        }
+        this->parseLine(line, newline);
+        line = newline + 1;
+    }
+    if (line != end) {
+        this->parseLine(line, end);
+    }
+}
+
+void GraphParser::parseChunk(const char *begin, const char *end)
+{
+    try {
+        this->parseBlock(begin, end);
+    }
+    catch (ParseError &e) {
+        this->failed = true;
+        this->error = e;
+    }
+}
+
+std::string GraphParser::errorMessage(unsigned int line,
+        const std::string &message)
+{
+    std::stringstream ss;
+    ss << "Linia [" << line << "]> " << message;
+    return ss.str();
+}
+
+void GraphParser::parseLine(const char *begin, const char *end)
+{
+    using std::stringstream;
+
+    const char *comment = static_cast<const char *>(memchr(begin, COM_SIGN[0],
+                end - begin));
+    if (comment != NULL) {
+        end = comment;
+    }
+    if (begin == end) {
+        return;
+    }
+    ++this->line_number;
+
+    const char *colon = static_cast<const char *>(memchr(begin, ':',
+                end - begin));
+    if (colon == NULL) {
+        this->fail("Brak znaku `:'");
+    }
+
+    label_t label;
+    switch (parseNumber(begin, colon, false, label)) {
+        case NUMBER_INVALID:
+            this->fail("Zła etykieta wierzchołka głównego");
+        case NUMBER_RANGE:
+            this->fail("Etykieta wierzchołka głównego przekracza wymiar");
+        default:
+            break;
+    }
+
+    // elementy rozdzielone przecinkami; ostatni element liczy się tylko,
+    // jeżeli zawiera coś poza białymi znakami
+    this->adjacent.clear();
+    const char *token = colon + 1;
+    for(const char *it = token; ; ++it) {
+        bool last = (it == end);
+        if (!last && *it != DELIMITER_CHAR) {
+            continue;
+        }
+        if (last) {
+            while (token != end && isSpace(*token)) {
+                ++token;
+            }
+            if (token == end) {
+                break;
+            }
+        }
+
+        label_t target;
+        NumberStatus status = parseNumber(token, it, true, target);
+        if (status != NUMBER_OK) {
+            stringstream ss;
+            ss << "Krawędź " << this->adjacent.size() + 1 << ": "
+                << (status == NUMBER_INVALID ?
+                        "zła etykieta wierzchołka docelowego" :
+                        "etykieta wierzchołka docelowego przekracza wymiar");
+            this->fail(ss.str());
+        }
+        this->adjacent.push_back(target);
+
+        if (last) {
+            break;
+        }
+        token = it + 1;
+    }
+
+    this->builder.addVertex(label);
+    for(size_t i = 0; i < this->adjacent.size(); ++i) {
+        this->builder.addEdge(label, this->adjacent[i]);
+    }
+}
+
+void GraphParser::fail(const std::string &message) const
+{
+    ParseError e;
+    e.line = this->line_number;
+    e.message = message;
+    throw e;
+}
@@ -0,0 +1,184 @@
+/**
+ *      @file  graphParser.hpp
+ *     @brief  plik nagłówkowy klasy GraphParser
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy GraphParser - strumieniowego parsera tekstowego formatu
+ * grafu (`znacznik: sąsiad, sąsiad, ...'), używanego przez operator>>
+ * klasy \ref Graph
+ *
+ *=====================================================================================
+ */
+
+#ifndef GRAPHPARSER_HPP
+#define GRAPHPARSER_HPP
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+#include "graphBuilder.hpp"
+
+/**
+ * @brief rozmiar bloku wczytywanego jednorazowo ze strumienia (bajty)
+ *
+ * Blok rośnie dwukrotnie, jeżeli nie mieści się w nim jeden wiersz.
+ */
+#define PARSER_CHUNK_SIZE (1 << 20)
+
+/**
+ * @brief minimalny rozmiar fragmentu pliku parsowanego przez jeden wątek
+ * (bajty) - mniejsze pliki dzielone są na mniej fragmentów
+ */
+#define PARSER_MIN_SPLIT (1 << 16)
+
+/**
+ * @brief klasa wczytuje graf w formacie tekstowym blokami i dzieli wiersze
+ * na liczby w miejscu
+ *
+ * Wiersze nie są kopiowane do std::string, a lista sąsiadów nie przechodzi
+ * przez split() i strip_space() - liczby czytane są wprost z bloku. Składnia
+ * i komunikaty błędów są takie same jak w dotychczasowym operator>>
+ * (getline, stoi, split po usunięciu białych znaków):
+ * * wiersz jest ucinany na znaku \ref COM_SIGN, pusty wiersz jest pomijany
+ *   i nie liczy się do numeru wiersza w komunikacie,
+ * * znacznik to początek tekstu przed pierwszym `:' (wiodące białe znaki
+ *   są pomijane, tekst za liczbą ignorowany),
+ * * sąsiedzi rozdzieleni są przecinkami, białe znaki wewnątrz są pomijane,
+ *   pusty element przed przecinkiem jest błędem.
+ *
+ * Znaczniki i krawędzie zbierane są w \ref GraphBuilder i wstawiane do grafu
+ * jednorazowo po wczytaniu całego strumienia, więc błąd w dowolnym wierszu
+ * pozostawia graf bez zmian.
+ *
+ * Plik w pamięci można parsować wielowątkowo
+ * (\ref GraphParser::parseParallel): każdy wątek parsuje fragment
+ * zakończony znakiem nowego wiersza własnym obiektem GraphParser, krawędzie
+ * fragmentów są łączone w jednym budowniczym, a numery wierszy w komunikatach błędów przesuwane są o liczbę niepustych
+ * wierszy wcześniejszych fragmentów.
+ */
+class GraphParser
+{
+    public:
+        /**
+         * @brief stwórz parser
+         */
+        GraphParser();
+
+        /**
+         * @brief wczytaj cały strumień i dodaj wierzchołki i krawędzie
+         * do grafu
+         *
+         * Rzuca std::invalid_argument z komunikatem `Linia [k]> ...'.
+         *
+         * @param input strumień z grafem
+         * @param graph graf uzupełniany o wczytane wierzchołki i krawędzie
+         */
+        void parse(std::istream &input, Graph &graph);
+
+        /**
+         * @brief sparsuj tekst w pamięci na wielu wątkach i dodaj
+         * wierzchołki i krawędzie do grafu
+         *
+         * Wynik i komunikaty błędów są takie same jak przy
+         * \ref GraphParser::parse.
+         *
+         * @param begin początek tekstu
+         * @param end koniec tekstu
+         * @param threads liczba wątków (0 - liczba rdzeni)
+         * @param graph graf uzupełniany o wczytane wierzchołki i krawędzie
+         */
+        static void parseParallel(const char *begin, const char *end,
+                unsigned int threads, Graph &graph);
+
+    private:
+        /**
+         * @brief błąd w wierszu o numerze liczonym od początku fragmentu
+         */
+        struct ParseError
+        {
+            /**
+             * @brief numer niepustego wiersza
+             */
+            unsigned int line;
+
+            /**
+             * @brief opis błędu
+             */
+            std::string message;
+        };
+
+        /**
+         * @brief numer bieżącego niepustego wiersza
+         */
+        unsigned int line_number;
+
+        /**
+         * @brief wczytane wierzchołki i krawędzie
+         */
+        GraphBuilder builder;
+
+        /**
+         * @brief sąsiedzi bieżącego wiersza
+         */
+        std::vector<Graph::label_t> adjacent;
+
+        /**
+         * @brief czy parsowanie fragmentu zakończyło się błędem
+         * (\ref GraphParser::parseChunk)
+         */
+        bool failed;
+
+        /**
+         * @brief błąd fragmentu
+         */
+        ParseError error;
+
+        /**
+         * @brief przetwórz wszystkie wiersze tekstu; ostatni wiersz nie musi
+         * kończyć się znakiem nowego wiersza
+         *
+         * @param begin początek tekstu
+         * @param end koniec tekstu
+         */
+        void parseBlock(const char *begin, const char *end);
+
+        /**
+         * @brief przetwórz fragment pliku (wątek roboczy), błąd zapisywany
+         * jest w \ref GraphParser::error
+         *
+         * @param begin początek fragmentu
+         * @param end koniec fragmentu
+         */
+        void parseChunk(const char *begin, const char *end);
+
+        /**
+         * @brief komunikat błędu w formacie operator>>
+         *
+         * @param line numer niepustego wiersza
+         * @param message opis błędu
+         *
+         * @return komunikat `Linia [k]> ...'
+         */
+        static std::string errorMessage(unsigned int line,
+                const std::string &message);
+
+        /**
+         * @brief przetwórz jeden wiersz (bez znaku końca wiersza)
+         *
+         * @param begin początek wiersza
+         * @param end koniec wiersza
+         */
+        void parseLine(const char *begin, const char *end);
+
+        /**
+         * @brief rzuć błąd bieżącego wiersza
+         *
+         * @param message opis błędu
+         */
+        void fail(const std::string &message) const;
+};
+
+#endif /* end of include guard: GRAPHPARSER_HPP */
@@ -0,0 +1,79 @@
+/**
+ *      @file  isoEngine.cpp
+ *     @brief  implementacja wyboru silnika weryfikacji izomorfizmu
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include "isoEngine.hpp"
+
+bool parseEngine(const std::string &name, IsoEngine &engine)
+{
+    if (name == "bt") {
+        engine = ENGINE_BACKTRACK;
+        return true;
+    }
+    if (name == "vf2pp") {
+        engine = ENGINE_VF2PP;
+        return true;
+    }
+    return false;
+}
+
+std::string engineName(IsoEngine engine)
+{
+    switch (engine) {
+        case ENGINE_VF2PP:
+            return "vf2pp";
+        case ENGINE_BACKTRACK:
+        default:
+            return "bt";
+    }
+}
+
+bool isIsomorphic(const FrozenGraph &gX, const FrozenGraph &gY,
+        IsoEngine engine, IsomorphismAlgo::iso_map &f,
+        unsigned int threads)
+{
+    SearchStats stats;
+    return isIsomorphic(gX, gY, engine, SearchLimits(), f, stats, threads) ==
+        ISO_ISOMORPHIC;
+}
+
+IsoResult isIsomorphic(const FrozenGraph &gX, const FrozenGraph &gY,
+        IsoEngine engine, const SearchLimits &limits,
+        IsomorphismAlgo::iso_map &f, SearchStats &stats,
+        unsigned int threads)
+{
+    IsoResult result;
+
+    if (engine == ENGINE_VF2PP) {
+        Vf2ppAlgo alg(gX, gY);
+        result = alg.isIsomorphism(limits);
+        stats = alg.getStats();
+        if (result == ISO_ISOMORPHIC) {
+            f = alg.getIsoMap();
+        }
+        return result;
+    }
+
+    if (threads != 1) {
+        ParallelIsoSolver solver(gX, gY, threads);
+        result = solver.isIsomorphism(limits);
+        stats = solver.getStats();
+        if (result == ISO_ISOMORPHIC) {
+            f = solver.getIsoMap();
+        }
+        return result;
+    }
+
+    IsomorphismAlgo alg(gX, gY);
+    result = alg.isIsomorphism(limits);
+    stats = alg.getStats();
+    if (result == ISO_ISOMORPHIC) {
+        f = alg.getIsoMap();
+    }
+    return result;
+}
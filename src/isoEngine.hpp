@@ -0,0 +1,89 @@
+/**
+ *      @file  isoEngine.hpp
+ *     @brief  wybór silnika weryfikacji izomorfizmu
+ *
+ * Detailed description starts here.
+ *
+ * Wspólny punkt wejścia do silników \ref IsomorphismAlgo i \ref Vf2ppAlgo,
+ * wykorzystywany przez interfejs linii poleceń.
+ *
+ *=====================================================================================
+ */
+
+#ifndef ISOENGINE_HPP
+#define ISOENGINE_HPP
+
+#include <string>
+
+#include "graph.hpp"
+#include "frozenGraph.hpp"
+#include "isomorphismAlgo.hpp"
+#include "vf2ppAlgo.hpp"
+#include "parallelSolver.hpp"
+
+/**
+ * @brief dostępne silniki weryfikacji izomorfizmu
+ */
+enum IsoEngine
+{
+    ENGINE_BACKTRACK,   /**< algorytm powrotów po krawędziach lasu DFS (\ref IsomorphismAlgo) */
+    ENGINE_VF2PP        /**< algorytm w stylu VF2++ (\ref Vf2ppAlgo) */
+};
+
+/**
+ * @brief zamień nazwę silnika na wartość \ref IsoEngine
+ *
+ * Rozpoznawane nazwy: `bt', `vf2pp'.
+ *
+ * @param name nazwa silnika
+ * @param engine wynik
+ *
+ * @return czy nazwa jest poprawna
+ */
+bool parseEngine(const std::string &name, IsoEngine &engine);
+
+/**
+ * @brief nazwa silnika
+ *
+ * @param engine silnik
+ *
+ * @return nazwa rozpoznawana przez \ref parseEngine
+ */
+std::string engineName(IsoEngine engine);
+
+/**
+ * @brief zweryfikuj izomorfizm grafów wybranym silnikiem
+ *
+ * @param gX graf X
+ * @param gY graf Y
+ * @param engine silnik
+ * @param f przekształcenie izomorficzne (wypełniane gdy grafy są izomorficzne)
+ * @param threads liczba wątków dla silnika \ref ENGINE_BACKTRACK
+ * (\ref ParallelIsoSolver gdy różna od 1, 0 - liczba rdzeni)
+ *
+ * @return czy grafy są izomorficzne
+ */
+bool isIsomorphic(const FrozenGraph &gX, const FrozenGraph &gY,
+        IsoEngine engine, IsomorphismAlgo::iso_map &f,
+        unsigned int threads = 1);
+
+/**
+ * @brief zweryfikuj izomorfizm grafów wybranym silnikiem z limitami
+ * przeszukiwania
+ *
+ * @param gX graf X
+ * @param gY graf Y
+ * @param engine silnik
+ * @param limits limity przeszukiwania (termin, liczba węzłów, flaga przerwania)
+ * @param f przekształcenie izomorficzne (wypełniane gdy grafy są izomorficzne)
+ * @param stats statystyki zebrane do zakończenia lub przerwania
+ * @param threads liczba wątków dla silnika \ref ENGINE_BACKTRACK
+ *
+ * @return wynik weryfikacji, \ref ISO_UNKNOWN gdy przekroczono limit
+ */
+IsoResult isIsomorphic(const FrozenGraph &gX, const FrozenGraph &gY,
+        IsoEngine engine, const SearchLimits &limits,
+        IsomorphismAlgo::iso_map &f, SearchStats &stats,
+        unsigned int threads = 1);
+
+#endif /* end of include guard: ISOENGINE_HPP */
@@ -0,0 +1,412 @@
+/**
+ *      @file  isoServer.cpp
+ *     @brief  implementacja metod klasy IsoServer
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "isoServer.hpp"
+
+namespace {
+
+/**
+ * @brief zapisz cały bufor do deskryptora
+ *
+ * @param fd deskryptor
+ * @param data dane
+ * @param size rozmiar danych
+ *
+ * @return czy zapisano wszystko
+ */
+bool writeAll(int fd, const char *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+/**
+ * @brief dopisz tekst jako napis JSON (w cudzysłowach)
+ *
+ * @param out wynik
+ * @param text tekst
+ */
+void appendJsonString(std::string &out, const std::string &text)
+{
+    out += '"';
+    for(size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = text[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief wczytaj rozmiar grafu z nagłówka `inline'
+ *
+ * @param iss strumień nagłówka
+ * @param size wynik
+ *
+ * @return czy rozmiar jest poprawny
+ */
+bool readSize(std::istringstream &iss, size_t &size)
+{
+    std::string token;
+    if (!(iss >> token) || token.find_first_not_of("0123456789") !=
+            std::string::npos || token.size() > 12) {
+        return false;
+    }
+    unsigned long long value = std::stoull(token);
+    if (value > SERVER_MAX_INLINE) {
+        return false;
+    }
+    size = value;
+    return true;
+}
+
+} /* namespace */
+
+IsoServer::IsoServer(IsoEngine _engine, unsigned int _threads, double _timeout,
+        unsigned long long _max_nodes, GraphFormat _file_format):
+    engine(_engine), threads(_threads), timeout(_timeout),
+    max_nodes(_max_nodes), file_format(_file_format), input(-1),
+    buffer(SERVER_READ_SIZE), buffer_begin(0), buffer_end(0)
+{}
+
+bool IsoServer::readLine(std::string &line)
+{
+    size_t scanned = this->buffer_begin;
+    for(;;) {
+        const char *begin = this->buffer.data() + this->buffer_begin;
+        const char *newline = static_cast<const char *>(memchr(
+                    this->buffer.data() + scanned, '\n',
+                    this->buffer_end - scanned));
+        if (newline != NULL) {
+            const char *end = newline;
+            if (end > begin && end[-1] == '\r') {
+                --end;
+            }
+            line.assign(begin, end);
+            this->buffer_begin = newline + 1 - this->buffer.data();
+            return true;
+        }
+        scanned = this->buffer_end;
+
+        // przesuń niepełny wiersz na początek bufora
+        if (this->buffer_begin > 0) {
+            memmove(this->buffer.data(), begin,
+                    this->buffer_end - this->buffer_begin);
+            this->buffer_end -= this->buffer_begin;
+            scanned -= this->buffer_begin;
+            this->buffer_begin = 0;
+        }
+        if (this->buffer_end == this->buffer.size()) {
+            // wiersz dłuższy niż bufor - to nie jest nagłówek żądania
+            return false;
+        }
+
+        ssize_t count = read(this->input, this->buffer.data() + this->buffer_end,
+                this->buffer.size() - this->buffer_end);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        this->buffer_end += count;
+    }
+}
+
+bool IsoServer::readPayload(size_t count)
+{
+    this->payload.resize(count);
+
+    size_t buffered = std::min(count, this->buffer_end - this->buffer_begin);
+    memcpy(this->payload.data(), this->buffer.data() + this->buffer_begin,
+            buffered);
+    this->buffer_begin += buffered;
+
+    // reszta czytana bezpośrednio, bez kopiowania przez bufor
+    size_t done = buffered;
+    while (done < count) {
+        ssize_t got = read(this->input, this->payload.data() + done,
+                count - done);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            return false;
+        }
+        done += got;
+    }
+    return true;
+}
+
+void IsoServer::loadFile(const std::string &filename, FrozenGraph &graph)
+{
+    if (FrozenGraph::isBinaryFile(filename)) {
+        graph.loadBinary(filename);
+        return;
+    }
+    loadGraph(filename, this->file_format, this->text);
+    graph.freeze(this->text);
+}
+
+void IsoServer::loadPayload(const std::string &format, FrozenGraph &graph)
+{
+    using std::invalid_argument;
+
+    if (format == "binary") {
+        // zawartość przechodzi na własność grafu
+        graph.loadBinary(std::move(this->payload));
+        this->payload.clear();
+        return;
+    }
+
+    GraphFormat parsed;
+    if (!parseFormat(format, parsed)) {
+        throw invalid_argument("nieznany format `" + format + "'");
+    }
+    this->text.clear();
+    parseGraph(this->payload.data(), this->payload.data() +
+            this->payload.size(), parsed, this->text);
+    graph.freeze(this->text);
+}
+
+void IsoServer::check(unsigned long long id)
+{
+    using std::to_string;
+    using std::chrono::steady_clock;
+
+    SearchLimits limits;
+    if (this->timeout > 0.0) {
+        limits.setTimeout(this->timeout);
+    }
+    limits.max_nodes = this->max_nodes;
+
+    IsoResult result;
+    const IsomorphismAlgo::iso_map *found = &this->mapping;
+    steady_clock::time_point start = steady_clock::now();
+    if (this->engine == ENGINE_BACKTRACK && this->threads == 1) {
+        result = this->solver.solve(this->graphX, this->graphY, limits);
+        found = &this->solver.getIsoMap();
+    } else {
+        SearchStats stats;
+        this->mapping.clear();
+        result = isIsomorphic(this->graphX, this->graphY, this->engine,
+                limits, this->mapping, stats, this->threads);
+    }
+    double seconds = elapsedSeconds(start);
+
+    std::string &out = this->response;
+    out.assign("{\"id\":");
+    out += to_string(id);
+    out += ",\"result\":\"";
+    out += result == ISO_ISOMORPHIC ? "iso" :
+        result == ISO_NOT_ISOMORPHIC ? "noniso" : "unknown";
+    out += "\",\"vertices\":[";
+    out += to_string(this->graphX.getVertexCount());
+    out += ',';
+    out += to_string(this->graphY.getVertexCount());
+    out += "],\"edges\":[";
+    out += to_string(this->graphX.getEdgeCount());
+    out += ',';
+    out += to_string(this->graphY.getEdgeCount());
+    out += "],\"seconds\":";
+    char number[32];
+    snprintf(number, sizeof(number), "%.6g", seconds);
+    out += number;
+    if (result == ISO_ISOMORPHIC) {
+        out += ",\"mapping\":[";
+        for(IsomorphismAlgo::iso_map::const_iterator it = found->begin();
+                it != found->end(); ++it) {
+            if (it != found->begin()) {
+                out += ',';
+            }
+            out += '[';
+            out += to_string(it->first);
+            out += ',';
+            out += to_string(it->second);
+            out += ']';
+        }
+        out += ']';
+    }
+    out += "}\n";
+}
+
+void IsoServer::error(unsigned long long id, const std::string &message)
+{
+    this->response.assign("{\"id\":");
+    this->response += std::to_string(id);
+    this->response += ",\"error\":";
+    appendJsonString(this->response, message);
+    this->response += "}\n";
+}
+
+void IsoServer::serve(int input, int output)
+{
+    using std::string;
+    using std::istringstream;
+    using std::exception;
+
+    this->input = input;
+    this->buffer_begin = 0;
+    this->buffer_end = 0;
+
+    string line;
+    unsigned long long id = 0;
+    while (this->readLine(line)) {
+        istringstream iss(line);
+        string command;
+        if (!(iss >> command)) {
+            continue;
+        }
+        if (command == "quit") {
+            break;
+        }
+
+        ++id;
+        bool framed = true;
+        try {
+            string extra;
+            if (command == "files") {
+                string fileX, fileY;
+                if (!(iss >> fileX >> fileY) || (iss >> extra)) {
+                    throw std::invalid_argument(
+                            "oczekiwano `files <plik X> <plik Y>'");
+                }
+                try {
+                    this->loadFile(fileX, this->graphX);
+                } catch (exception &e) {
+                    throw std::invalid_argument(string("graf X: ") + e.what());
+                }
+                try {
+                    this->loadFile(fileY, this->graphY);
+                } catch (exception &e) {
+                    throw std::invalid_argument(string("graf Y: ") + e.what());
+                }
+            } else if (command == "inline") {
+                string format;
+                size_t sizeX, sizeY;
+                if (!(iss >> format) || !readSize(iss, sizeX) ||
+                        !readSize(iss, sizeY) || (iss >> extra)) {
+                    framed = false;
+                    throw std::invalid_argument(
+                            "oczekiwano `inline <format> <bajty X> <bajty Y>'");
+                }
+                // oba grafy są czytane przed sprawdzeniem, żeby zachować
+                // granice kolejnych żądań także po błędzie w grafie X
+                string failure;
+                if (!this->readPayload(sizeX)) {
+                    framed = false;
+                    throw std::invalid_argument("niepełne dane grafu X");
+                }
+                try {
+                    this->loadPayload(format, this->graphX);
+                } catch (exception &e) {
+                    failure = string("graf X: ") + e.what();
+                }
+                if (!this->readPayload(sizeY)) {
+                    framed = false;
+                    throw std::invalid_argument("niepełne dane grafu Y");
+                }
+                if (failure.empty()) {
+                    try {
+                        this->loadPayload(format, this->graphY);
+                    } catch (exception &e) {
+                        failure = string("graf Y: ") + e.what();
+                    }
+                }
+                if (!failure.empty()) {
+                    throw std::invalid_argument(failure);
+                }
+            } else {
+                throw std::invalid_argument("nieznane żądanie `" + command + "'");
+            }
+            this->check(id);
+        } catch (exception &e) {
+            this->error(id, e.what());
+        }
+
+        if (!writeAll(output, this->response.data(), this->response.size()) ||
+                !framed) {
+            break;
+        }
+    }
+    this->input = -1;
+}
+
+void IsoServer::serveSocket(const std::string &path)
+{
+    using std::runtime_error;
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw runtime_error("Zbyt długa ścieżka gniazda");
+    }
+    strcpy(address.sun_path, path.c_str());
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) {
+        throw runtime_error("Nie udało się utworzyć gniazda");
+    }
+    unlink(path.c_str());
+    if (bind(server, reinterpret_cast<struct sockaddr *>(&address),
+                sizeof(address)) != 0 || listen(server, SERVER_BACKLOG) != 0) {
+        close(server);
+        throw runtime_error("Nie udało się nasłuchiwać na gnieździe `" +
+                path + "'");
+    }
+
+    // zerwane połączenie klienta kończy tylko obsługę tego połączenia
+    std::signal(SIGPIPE, SIG_IGN);
+
+    for(;;) {
+        int client = accept(server, NULL, NULL);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            close(server);
+            throw runtime_error("Nie udało się przyjąć połączenia");
+        }
+        this->serve(client, client);
+        close(client);
+    }
+}
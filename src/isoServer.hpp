@@ -0,0 +1,233 @@
+/**
+ *      @file  isoServer.hpp
+ *     @brief  plik nagłówkowy klasy IsoServer
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy IsoServer - długo działającego trybu weryfikacji par
+ * grafów przez standardowe wejście/wyjście lub gniazdo domeny Unix,
+ * z odpowiedziami w formacie JSON
+ *
+ *=====================================================================================
+ */
+
+#ifndef ISOSERVER_HPP
+#define ISOSERVER_HPP
+
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+#include "frozenGraph.hpp"
+#include "graphFormats.hpp"
+#include "isoEngine.hpp"
+#include "isoSolver.hpp"
+
+/**
+ * @brief rozmiar bloku czytanego jednorazowo z deskryptora (bajty)
+ */
+#define SERVER_READ_SIZE (1 << 16)
+
+/**
+ * @brief największy rozmiar grafu przesłanego w żądaniu `inline' (bajty)
+ */
+#define SERVER_MAX_INLINE (1ULL << 30)
+
+/**
+ * @brief długość kolejki połączeń gniazda
+ */
+#define SERVER_BACKLOG 16
+
+/**
+ * @brief klasa obsługuje żądania weryfikacji par grafów
+ *
+ * Protokół jest wierszowy, puste wiersze są pomijane:
+ * * `files <plik X> <plik Y>' - grafy z plików (tekstowe w formacie
+ *   \ref IsoServer::file_format lub binarne, rozpoznawane po nagłówku),
+ * * `inline <format> <bajty X> <bajty Y>' - za wierszem dokładnie tyle
+ *   bajtów grafu X i grafu Y; format to nazwa z \ref parseFormat lub
+ *   `binary' (plik z \ref FrozenGraph::saveBinary),
+ * * `quit' - zakończ połączenie.
+ *
+ * Na każde żądanie odpowiedzią jest jeden wiersz JSON, np.
+ * `{"id":1,"result":"iso","vertices":[3,3],"edges":[2,2],
+ * "seconds":1.2e-05,"mapping":[[1,2],[2,3],[3,1]]}'; `result' to `iso',
+ * `noniso' lub `unknown' (przekroczony limit), a błąd daje
+ * `{"id":2,"error":"..."}'. Po błędnym nagłówku `inline' połączenie jest
+ * zamykane, bo nie da się odnaleźć początku kolejnego żądania.
+ *
+ * Grafy, bufory żądań i odpowiedzi oraz - dla jednowątkowego silnika
+ * \ref ENGINE_BACKTRACK - solver \ref IsoSolver są polami obiektu, więc
+ * kolejne żądania korzystają z już przydzielonej pamięci.
+ */
+class IsoServer
+{
+    public:
+        /**
+         * @brief stwórz serwer
+         *
+         * @param _engine silnik weryfikacji
+         * @param _threads liczba wątków silnika \ref ENGINE_BACKTRACK
+         * @param _timeout limit czasu jednej weryfikacji w sekundach
+         * (0 - bez limitu)
+         * @param _max_nodes limit węzłów przeszukiwania (0 - bez limitu)
+         * @param _file_format format plików tekstowych w żądaniach `files'
+         */
+        IsoServer(IsoEngine _engine, unsigned int _threads, double _timeout,
+                unsigned long long _max_nodes, GraphFormat _file_format);
+
+        /**
+         * @brief obsługuj żądania do końca wejścia lub żądania `quit'
+         *
+         * @param input deskryptor wejścia
+         * @param output deskryptor wyjścia
+         */
+        void serve(int input, int output);
+
+        /**
+         * @brief nasłuchuj na gnieździe domeny Unix i obsługuj kolejne
+         * połączenia (nie kończy się)
+         *
+         * Istniejący plik gniazda jest usuwany. Rzuca std::runtime_error,
+         * gdy gniazda nie da się utworzyć.
+         *
+         * @param path ścieżka gniazda
+         */
+        void serveSocket(const std::string &path);
+
+    private:
+        /**
+         * @brief silnik weryfikacji
+         */
+        IsoEngine engine;
+
+        /**
+         * @brief liczba wątków silnika bt
+         */
+        unsigned int threads;
+
+        /**
+         * @brief limit czasu jednej weryfikacji (0 - bez limitu)
+         */
+        double timeout;
+
+        /**
+         * @brief limit węzłów przeszukiwania (0 - bez limitu)
+         */
+        unsigned long long max_nodes;
+
+        /**
+         * @brief format plików tekstowych w żądaniach `files'
+         */
+        GraphFormat file_format;
+
+        /**
+         * @brief deskryptor wejścia bieżącego połączenia
+         */
+        int input;
+
+        /**
+         * @brief bufor wejścia
+         */
+        std::vector<char> buffer;
+
+        /**
+         * @brief początek nieprzeczytanych danych w \ref IsoServer::buffer
+         */
+        size_t buffer_begin;
+
+        /**
+         * @brief koniec danych w \ref IsoServer::buffer
+         */
+        size_t buffer_end;
+
+        /**
+         * @brief bajty grafu z żądania `inline'
+         */
+        std::vector<char> payload;
+
+        /**
+         * @brief graf tekstowy przed zamrożeniem
+         */
+        Graph text;
+
+        /**
+         * @brief graf X bieżącego żądania
+         */
+        FrozenGraph graphX;
+
+        /**
+         * @brief graf Y bieżącego żądania
+         */
+        FrozenGraph graphY;
+
+        /**
+         * @brief solver jednowątkowego silnika bt, zachowujący tablice
+         * między żądaniami
+         */
+        IsoSolver solver;
+
+        /**
+         * @brief przekształcenie izomorficzne bieżącego żądania (gdy nie
+         * weryfikuje go \ref IsoServer::solver)
+         */
+        IsomorphismAlgo::iso_map mapping;
+
+        /**
+         * @brief odpowiedź na bieżące żądanie
+         */
+        std::string response;
+
+        /**
+         * @brief wczytaj wiersz (bez znaku końca wiersza)
+         *
+         * @param line wynik
+         *
+         * @return czy wczytano wiersz przed końcem wejścia
+         */
+        bool readLine(std::string &line);
+
+        /**
+         * @brief wczytaj dokładnie \p count bajtów do
+         * \ref IsoServer::payload
+         *
+         * @param count liczba bajtów
+         *
+         * @return czy wejście zawierało tyle bajtów
+         */
+        bool readPayload(size_t count);
+
+        /**
+         * @brief wczytaj graf z pliku (tekstowego lub binarnego)
+         *
+         * @param filename nazwa pliku
+         * @param graph wynik
+         */
+        void loadFile(const std::string &filename, FrozenGraph &graph);
+
+        /**
+         * @brief wczytaj graf z \ref IsoServer::payload
+         *
+         * @param format nazwa formatu z żądania
+         * @param graph wynik
+         */
+        void loadPayload(const std::string &format, FrozenGraph &graph);
+
+        /**
+         * @brief zweryfikuj izomorfizm wczytanej pary i zapisz wynik
+         * w \ref IsoServer::response
+         *
+         * @param id numer żądania
+         */
+        void check(unsigned long long id);
+
+        /**
+         * @brief zapisz odpowiedź z błędem w \ref IsoServer::response
+         *
+         * @param id numer żądania
+         * @param message opis błędu
+         */
+        void error(unsigned long long id, const std::string &message);
+};
+
+#endif /* end of include guard: ISOSERVER_HPP */
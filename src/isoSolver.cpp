@@ -0,0 +1,34 @@
+/**
+ *      @file  isoSolver.cpp
+ *     @brief  implementacja metod klasy IsoSolver
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include "isoSolver.hpp"
+
+IsoSolver::IsoSolver()
+{
+
+}
+
+bool IsoSolver::solve(const FrozenGraph &gX, const FrozenGraph &gY)
+{
+    return this->solve(gX, gY, SearchLimits()) == ISO_ISOMORPHIC;
+}
+
+IsoResult IsoSolver::solve(const FrozenGraph &gX, const FrozenGraph &gY,
+        const SearchLimits &limits)
+{
+    this->algo.bind(gX, gY);
+    return this->algo.isIsomorphism(limits);
+}
+
+IsoResult IsoSolver::solve(const CompiledPattern &pattern, const FrozenGraph &gY,
+        const SearchLimits &limits)
+{
+    this->algo.bind(pattern, gY);
+    return this->algo.isIsomorphism(limits);
+}
@@ -0,0 +1,103 @@
+/**
+ *      @file  isoSolver.hpp
+ *     @brief  plik nagłówkowy klasy IsoSolver
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy IsoSolver - algorytmu powrotów \ref IsomorphismAlgo
+ * wielokrotnego użytku, dla wielu weryfikacji z rzędu
+ *
+ *=====================================================================================
+ */
+
+#ifndef ISOSOLVER_HPP
+#define ISOSOLVER_HPP
+
+#include "frozenGraph.hpp"
+#include "isomorphismAlgo.hpp"
+#include "searchLimits.hpp"
+#include "compiledPattern.hpp"
+
+/**
+ * @brief klasa weryfikuje izomorfizm kolejnych par grafów algorytmem
+ * \ref IsomorphismAlgo, zachowując jego tablice między wywołaniami
+ *
+ * Obiekt \ref IsomorphismAlgo wiąże się z jedną parą grafów, więc każda
+ * weryfikacja przydziela od nowa przekształcenie, zbiór S, liczniki,
+ * kolory, numerację DFS, posortowane krawędzie i stos ramek. IsoSolver
+ * trzyma jeden obiekt algorytmu i przy każdym \ref IsoSolver::solve
+ * podstawia nowe grafy - tablice tylko rosną do rozmiaru największej pary,
+ * więc seria weryfikacji małych grafów nie przydziela pamięci po pierwszej
+ * z nich.
+ */
+class IsoSolver
+{
+    public:
+        /**
+         * @brief stwórz solver bez grafów
+         */
+        IsoSolver();
+
+        /**
+         * @brief zweryfikuj izomorfizm pary grafów
+         *
+         * Grafy nie są kopiowane i nie muszą istnieć po powrocie.
+         *
+         * @param gX graf X
+         * @param gY graf Y
+         *
+         * @return czy grafy są izomorficzne
+         */
+        bool solve(const FrozenGraph &gX, const FrozenGraph &gY);
+
+        /**
+         * @brief zweryfikuj izomorfizm pary grafów z limitami przeszukiwania
+         *
+         * @param gX graf X
+         * @param gY graf Y
+         * @param limits limity przeszukiwania
+         *
+         * @return wynik weryfikacji, \ref ISO_UNKNOWN gdy przekroczono limit
+         */
+        IsoResult solve(const FrozenGraph &gX, const FrozenGraph &gY,
+                const SearchLimits &limits);
+
+        /**
+         * @brief zweryfikuj izomorfizm skompilowanego wzorca z grafem
+         *
+         * Kroki przygotowawcze grafu X pochodzą ze wzorca, wynik jest taki
+         * sam jak dla pary (\ref CompiledPattern::getGraph, \p gY).
+         *
+         * @param pattern wzorzec (graf X)
+         * @param gY graf Y
+         * @param limits limity przeszukiwania
+         *
+         * @return wynik weryfikacji, \ref ISO_UNKNOWN gdy przekroczono limit
+         */
+        IsoResult solve(const CompiledPattern &pattern, const FrozenGraph &gY,
+                const SearchLimits &limits = SearchLimits());
+
+        /**
+         * @brief przekształcenie izomorficzne ostatniej pary (puste, gdy
+         * grafy nie były izomorficzne)
+         *
+         * @return referencja na mapę znaczników grafu X na graf Y
+         */
+        const IsomorphismAlgo::iso_map &getIsoMap() const
+        {return this->algo.getIsoMap();};
+
+        /**
+         * @brief statystyki ostatniej weryfikacji
+         *
+         * @return referencja na statystyki
+         */
+        const SearchStats &getStats() const {return this->algo.getStats();};
+
+    private:
+        /**
+         * @brief algorytm, którego tablice są zachowywane
+         */
+        IsomorphismAlgo algo;
+};
+
+#endif /* end of include guard: ISOSOLVER_HPP */
@@ -8,43 +8,275 @@
  */
 
 #include "isomorphismAlgo.hpp"
+#include "compiledPattern.hpp"
 
 IsomorphismAlgo::IsomorphismAlgo(
         const Graph &_graphX,
         const Graph &_graphY):
-    graphX(_graphX), graphY(_graphY), edges_count_k(0)
+    frozenX(_graphX), frozenY(_graphY),
+    graphX(&frozenX), graphY(&frozenY), pattern(NULL), edges_count_k(0),
+    assigned_count(0),
+    task_sink(NULL), split_depth(0), cancel(NULL), budget(NULL),
+    pending_nodes(0)
 {
 
 }
+
+IsomorphismAlgo::IsomorphismAlgo(
+        const FrozenGraph &_graphX,
+        const FrozenGraph &_graphY):
+    graphX(&_graphX), graphY(&_graphY), pattern(NULL), edges_count_k(0),
+    assigned_count(0),
+    task_sink(NULL), split_depth(0), cancel(NULL), budget(NULL),
+    pending_nodes(0)
+{
+
+}
+
+IsomorphismAlgo::IsomorphismAlgo():
+    graphX(&frozenX), graphY(&frozenY), pattern(NULL), edges_count_k(0),
+    assigned_count(0),
+    task_sink(NULL), split_depth(0), cancel(NULL), budget(NULL),
+    pending_nodes(0)
+{
+
+}
+
+void IsomorphismAlgo::bind(
+        const FrozenGraph &_graphX,
+        const FrozenGraph &_graphY)
+{
+    this->graphX = &_graphX;
+    this->graphY = &_graphY;
+    this->pattern = NULL;
+}
+
+void IsomorphismAlgo::bind(
+        const CompiledPattern &_pattern,
+        const FrozenGraph &_graphY)
+{
+    this->graphX = &_pattern.getGraph();
+    this->graphY = &_graphY;
+    this->pattern = &_pattern;
+}
+
 bool IsomorphismAlgo::isIsomorphism()
 {
-    if (this->graphX.isEmpty() && this->graphY.isEmpty()) {
-        return true;
+    return this->isIsomorphism(SearchLimits()) == ISO_ISOMORPHIC;
+}
+
+IsoResult IsomorphismAlgo::isIsomorphism(const SearchLimits &limits)
+{
+    using std::chrono::steady_clock;
+
+    steady_clock::time_point start = steady_clock::now();
+    this->stats = SearchStats();
+
+    // budżet obejmuje także przygotowania - uszczegóławianie kolorów dużego
+    // grafu może trwać dłużej niż samo przeszukiwanie
+    SearchBudget limit(limits);
+    this->budget = &limit;
+    this->pending_nodes = 0;
+    IsoResult result = ISO_NOT_ISOMORPHIC;
+
+    if (this->graphX->isEmpty() && this->graphY->isEmpty()) {
+        this->label_map.clear();
+        result = ISO_ISOMORPHIC;
+    }
+    else if (this->prepare()) {
+        int dfs_num_k = -1;
+        steady_clock::time_point phase = steady_clock::now();
+        if (this->match(ordered_edges.begin(), dfs_num_k)) {
+            this->mapLabels();
+            result = ISO_ISOMORPHIC;
+        }
+        else if (limit.isExhausted()) {
+            result = ISO_UNKNOWN;
+        }
+        this->stats.match_seconds = elapsedSeconds(phase);
+    }
+    else if (limit.isExhausted()) {
+        // termin upłynął w czasie przygotowań
+        result = ISO_UNKNOWN;
+    }
+
+    this->flushBudget();
+    this->budget = NULL;
+    this->refinement.budget = NULL;
+
+    if (result != ISO_ISOMORPHIC) {
+        this->label_map.clear();
+    }
+
+    this->stats.seconds = elapsedSeconds(start);
+    return result;
+}
+
+void IsomorphismAlgo::flushBudget()
+{
+    if (this->budget != NULL && this->pending_nodes > 0) {
+        this->budget->consume(this->pending_nodes);
+    }
+    this->pending_nodes = 0;
+}
+
+bool IsomorphismAlgo::prepare()
+{
+    using std::chrono::steady_clock;
+
+    if (this->pattern != NULL) {
+        return this->preparePattern();
     }
 
-    if (!this->meetsRequirements()) {
+    steady_clock::time_point phase = steady_clock::now();
+    bool meets = this->meetsRequirements();
+    this->stats.requirements_seconds = elapsedSeconds(phase);
+    if (!meets || !this->checkBudget()) {
         return false;
     }
 
+    phase = steady_clock::now();
+    bool refined = this->refineColours();
+    this->stats.refinement_seconds = elapsedSeconds(phase);
+    if (!refined) {
+        // różne histogramy kolorów stabilnych
+        return false;
+    }
+
+    phase = steady_clock::now();
+    this->numberVertexes();
+    this->stats.numbering_seconds = elapsedSeconds(phase);
+    if (!this->checkBudget()) {
+        return false;
+    }
+
+    phase = steady_clock::now();
+    this->orderEdges();
+    this->stats.ordering_seconds = elapsedSeconds(phase);
+    return this->checkBudget();
+}
+
+bool IsomorphismAlgo::preparePattern()
+{
+    using std::sort;
+    using std::chrono::steady_clock;
+
+    const CompiledPattern &compiled = *this->pattern;
+
+    steady_clock::time_point phase = steady_clock::now();
+    bool meets = this->graphX->getSize() == this->graphY->getSize() &&
+        this->graphX->getEdgeCount() == this->graphY->getEdgeCount();
+    if (meets) {
+        this->resetData();
+        this->invY_buckets.resize(this->graphY->getSize());
+        for(idx_t y = 0; y < this->graphY->getSize(); ++y) {
+            this->invY_buckets[y] = this->graphY->getInvariant(y);
+        }
+        sort(this->invY_buckets.begin(), this->invY_buckets.end());
+        meets = (this->invY_buckets == compiled.inv_hist);
+    }
+    this->stats.requirements_seconds = elapsedSeconds(phase);
+    if (!meets || !this->checkBudget()) {
+        return false;
+    }
+
+    phase = steady_clock::now();
+    this->colourY.resize(this->graphY->getSize());
+    for(idx_t y = 0; y < this->graphY->getSize(); ++y) {
+        this->colourY[y] = this->graphY->getInvariant(y);
+    }
+    unsigned int colour_count = 0;
+    this->refinement.budget = this->budget;
+    bool refined = ColourRefinement::refineByTrace(compiled.trace,
+            *this->graphY, this->colourY, colour_count, this->refinement);
+    this->stats.refinement_seconds = elapsedSeconds(phase);
+    if (!refined) {
+        return false;
+    }
+
+    // numeracja DFS i porządek krawędzi zależą tylko od grafu X
+    this->colourX = compiled.colours;
+    this->colour_size = compiled.colour_size;
+    this->dfs_num = compiled.dfs_num;
+    this->dfs_vec = compiled.dfs_vec;
+    this->ordered_edges = compiled.ordered_edges;
+    return this->checkBudget();
+}
+
+void IsomorphismAlgo::compile(CompiledPattern &target)
+{
+    using std::sort;
+
+    this->resetData();
+
+    target.inv_hist.resize(this->graphX->getSize());
+    this->colourX.resize(this->graphX->getSize());
+    for(idx_t x = 0; x < this->graphX->getSize(); ++x) {
+        target.inv_hist[x] = this->graphX->getInvariant(x);
+        this->colourX[x] = this->graphX->getInvariant(x);
+    }
+    sort(target.inv_hist.begin(), target.inv_hist.end());
+
+    unsigned int colour_count = ColourRefinement::refineTraced(*this->graphX,
+            this->colourX, target.trace);
+    this->colour_size.assign(colour_count, 0);
+    for(idx_t x = 0; x < this->graphX->getSize(); ++x) {
+        ++this->colour_size[this->colourX[x]];
+    }
+
     this->numberVertexes();
     this->orderEdges();
 
-    int dfs_num_k = -1;
-    return this->match(ordered_edges.begin(), dfs_num_k);
+    target.colours.swap(this->colourX);
+    target.colour_size.swap(this->colour_size);
+    target.dfs_num.swap(this->dfs_num);
+    target.dfs_vec.swap(this->dfs_vec);
+    target.ordered_edges.swap(this->ordered_edges);
+}
+
+void IsomorphismAlgo::adoptPrepared(const IsomorphismAlgo &master)
+{
+    this->resetData();
+    this->dfs_num = master.dfs_num;
+    this->dfs_vec = master.dfs_vec;
+    this->ordered_edges = master.ordered_edges;
+    this->colourX = master.colourX;
+    this->colourY = master.colourY;
+    this->colour_size = master.colour_size;
 }
 
+bool IsomorphismAlgo::runTask(const SearchTask &task)
+{
+    for(size_t d = 0; d < task.images.size(); ++d) {
+        this->assign(this->dfs_vec[d], task.images[d]);
+    }
+    this->edges_count_k = task.edges_count_k;
+
+    bool found = this->match(this->ordered_edges.begin() + task.edge,
+            task.dfs_num_k);
+
+    if (found) {
+        this->mapLabels();
+    }
+    else {
+        for(size_t d = task.images.size(); d > 0; --d) {
+            this->unassign(task.images[d - 1]);
+        }
+    }
+    return found;
+}
 
 bool IsomorphismAlgo::meetsRequirements()
 {
-    if (this->graphX.isEmpty() && this->graphY.isEmpty()) {
+    if (this->graphX->isEmpty() && this->graphY->isEmpty()) {
         return true;
     }
 
-    if (this->graphX.getSize() != this->graphY.getSize()) {
+    if (this->graphX->getSize() != this->graphY->getSize()) {
         return false;
     }
 
-    if (this->graphX.getEdgeCount() != this->graphY.getEdgeCount()) {
+    if (this->graphX->getEdgeCount() != this->graphY->getEdgeCount()) {
         return false;
     }
 
@@ -63,199 +295,347 @@ bool IsomorphismAlgo::match(edge_iter iter, int dfs_num_k)
 {
     using std::max;
 
-    if (iter != this->ordered_edges.end()) {
-        // zostały jeszcze krawędzie do przyporządkowania
-
-        // rozpatrujemy wierzchołki krawędzi (graf G_X)
-        Graph::label_t i = iter->source;
-        Graph::label_t j = iter->target;
-
-        if (dfs_num[i] > dfs_num_k) {
-            // Szukanie 'MATCH' dla korzenia lasu DFS o nr. k+1
-            //
-            // nie przyporządkowaliśmy jeszcze wierzchołka na którym
-            // obecnie stoimy. Ma to miejsce dla korzeni DFS lasu
-
-            Graph::label_t next = dfs_vec[dfs_num_k + 1];
-            // sprawdzamy jaki znacznik w grafie ma korzeń k+1
-
-            for(Graph::iterator it = this->graphY.begin();
-                    it != this->graphY.end(); ++it) {
-                // dla wszystkich wierzchołków w grafie G_Y
-                if (this->graphX.getInvariant(next) ==
-                        this->graphY.getInvariant(*it) &&
-                        (!this->in_S.count(*it))) {
-                    // które mają taki sam 'stopień' (invariant)
-                    // i nie są jeszcze przypisane do żadnego z k
-                    // wierzchołków drzewa
-                    this->f_map[next] = (*it);
-                    this->in_S.insert(*it);
-                    // próbujemy przypisać korzeń k+1
-                    this->edges_count_k = 0;
-                    // do nowego korzenia nie dochodzą i nie wychodzą żadne
-                    // wcześniej napotkane krawędzie
-
-                    if (this->match(iter, dfs_num_k + 1)) {
-                        // próbujemy dopasować kolejny wierzchołek
-                        return true;
+    if (this->frames.size() < this->graphX->getSize() + 1) {
+        // każda ramka przyporządkowuje jeden wierzchołek
+        this->frames.resize(this->graphX->getSize() + 1);
+    }
+
+    size_t depth = 0;
+    bool descend = true;
+
+    while (true) {
+        if (descend) {
+            // wejście w stan (iter, dfs_num_k) - odpowiednik wywołania
+            // rekurencyjnego
+            descend = false;
+
+            if (this->task_sink != NULL &&
+                    this->assigned_count == this->split_depth) {
+                // zapisz poddrzewo jako zadanie zamiast je przeszukiwać
+                SearchTask task;
+                task.images.resize(this->assigned_count);
+                for(unsigned int d = 0; d < this->assigned_count; ++d) {
+                    task.images[d] = this->f_map[this->dfs_vec[d]];
+                }
+                task.edge = iter - this->ordered_edges.begin();
+                task.dfs_num_k = dfs_num_k;
+                task.edges_count_k = this->edges_count_k;
+                this->task_sink->push_back(task);
+            }
+            else if (iter == this->ordered_edges.end()) {
+                // przeszliśmy wszystkie krawędzie, znaleziono dopasowania
+                //
+                // Każda krawędź G_X ma odpowiednik w G_Y, a grafy mają tyle samo
+                // krawędzi. Pozostały tylko wierzchołki izolowane, które nie są
+                // końcem żadnej krawędzi - przyporządkowujemy je w dowolnej kolejności
+                idx_t y = 0;
+                for(dfs_idx_t d = dfs_num_k + 1;
+                        d < (dfs_idx_t) this->dfs_vec.size(); ++d) {
+                    while (FrozenGraph::testBit(this->in_S_bits.data(), y)) {
+                        ++y;
                     }
-                    // nie udało się go dopasować do tego wierzchołka z G_Y
-                    this->in_S.erase(*it);
+                    this->assign(this->dfs_vec[d], y);
                 }
+                return true;
             }
+            else {
+                // zostały jeszcze krawędzie do przyporządkowania
+
+                // rozpatrujemy wierzchołki krawędzi (graf G_X)
+                idx_t i = iter->source;
+                idx_t j = iter->target;
+
+                if (dfs_num[i] > dfs_num_k) {
+                    // Szukanie 'MATCH' dla korzenia lasu DFS o nr. k+1
+                    //
+                    // nie przyporządkowaliśmy jeszcze wierzchołka na którym
+                    // obecnie stoimy. Ma to miejsce dla korzeni DFS lasu.
+                    // Kandydatami są wszystkie wierzchołki grafu G_Y
+                    MatchFrame &frame = this->frames[depth++];
+                    frame.root = true;
+                    frame.iter = iter;
+                    frame.dfs_num_k = dfs_num_k;
+                    frame.x = dfs_vec[dfs_num_k + 1];
+                    frame.y = NO_VERTEX;
+                    frame.next = 0;
+                }
+                else if (dfs_num[j] > dfs_num_k) {
+                    // Sprawdz czy G_X[k] ~= G_Y[S] i znajdz 'MATCH' dla j
+                    //
+                    // Obecna krawędź wychodzi z dopasowanego wierzchołka, ale
+                    // dochodzi do jeszcze niedopasowanego. Oznacza to, że jest
+                    // to ostatnia krawędź incydentna z tym wierzchołkiem jaką będziemy
+                    // rozpatrywać.
+                    idx_t fk = this->f_map[dfs_vec[dfs_num_k]];
+                    // sprawdzamy jaki wierzchołek G_Y przypisano k-temu wierzchołkowi
+                    this->edges_count_k -= this->mapped_out[fk];
+                    this->edges_count_k -= this->mapped_in[fk];
+                    // sprawdzamy czy grafie G_Y[S] f(k) jest incydentny z taką samą
+                    // liczbą krawędzi co wierzchołek k w grafie G[k]
+
+                    if (this->edges_count_k == 0) {
+                        // Wierzchołek j jest incydentny z i, a więc f(j) musi
+                        // być incydentny z f(i). Dlatego kandydatami są
+                        // wierzchołki z listy sąsiedztwa f(i).
+                        idx_t fi = this->f_map[i];
+                        MatchFrame &frame = this->frames[depth++];
+                        frame.root = false;
+                        frame.iter = iter;
+                        frame.dfs_num_k = max(dfs_num_k, max(dfs_num[i], dfs_num[j]));
+                        // jeżeli numerowanie drzewa jest poprawne to
+                        // dfs_num_k + 1
+                        frame.x = j;
+                        frame.y = NO_VERTEX;
+                        frame.cur = this->graphY->adjBegin(fi);
+                        frame.end = this->graphY->adjEnd(fi);
+                    }
+                    else {
+                        // k i f(k) zostały źle dopasowane
+                        SEARCH_STAT(++this->stats.rejected_edges_count);
+                    }
+                }
+                else {
+                    // sprawdź czy (f(i), f(j)) in E_Y[S] i idź dalej
+                    //
+                    // Oba wierzchołki mają już przyporządkowanie, trzeba sprawdzić
+                    // czy nowo napotkana krawędź występuje też w G[S]
+                    idx_t fi = this->f_map[i];
+                    idx_t fj = this->f_map[j];
+                    SEARCH_STAT(++this->stats.connection_calls);
+                    if (this->graphY->isConnection(fi, fj, this->in_S_bits)) {
+                        ++this->edges_count_k;
+                        ++iter;
+                        descend = true;
+                        continue;
+                    }
+                    // krawędź (i, j) nie ma odpowiednika w G_Y[S], k lub
+                    // wcześniejszy wierzchołek został źle dopasowany
+                }
+            }
+        }
+
+        // nawrót: kolejny kandydat dla ramki na szczycie stosu
+        if (depth == 0) {
+            return false;
         }
-        else if (dfs_num[j] > dfs_num_k) {
-            // Sprawdz czy G_X[k] ~= G_Y[S] i znajdz 'MATCH' dla j
-            //
-            // Obecna krawędź wychodzi z dopasowanego wierzchołka, ale
-            // dochodzi do jeszcze niedopasowanego. Oznacza to, że jest
-            // to ostatnia krawędź incydentna z tym wierzchołkiem jaką będziemy
-            // rozpatrywać.
-            Graph::label_t k = dfs_vec[dfs_num_k];
-            // sprawdzamy jaki znacznik w G_X ma k-ty dopasowany wierzchołek
-            this->edges_count_k -= this->graphY.getOut(f_map.at(k), in_S);
-            this->edges_count_k -= this->graphY.getIn(f_map.at(k), in_S);
-            // sprawdzamy czy grafie G_Y[S] f(k) jest incydentny z taką samą
-            // liczbą krawędzi co wierzchołek k w grafie G[k]
-
-            if (this->edges_count_k != 0) {
-                // jak nie jest to k i f(k) zostały źle dopasowane
-                return false;
+
+        // Przerwanie sprawdzamy tylko przed kolejnym węzłem, nie przy
+        // weryfikacji krawędzi - przyporządkowanie dokończone ostatnim
+        // dozwolonym węzłem jest wynikiem (limit węzłów to `co najwyżej N')
+        if ((this->cancel != NULL &&
+                    this->cancel->load(std::memory_order_relaxed)) ||
+                (this->budget != NULL && this->budget->isExhausted())) {
+            // przerwanie - cofamy przyporządkowania ze stosu
+            for(; depth > 0; --depth) {
+                if (this->frames[depth - 1].y != NO_VERTEX) {
+                    this->unassign(this->frames[depth - 1].y);
+                }
             }
+            return false;
+        }
 
-            Graph::label_t fi = this->f_map.at(i);
-            // będziemy próbowali przyporządkować wierzchołek z grafu G_Y[V-S]
-            // do wierzchołka j z G_X. Wierzchołek j jest incydentny z i, a więc
-            // f(j) musi być incydentny z f(i). Dlatego przeszukujemy listę sąsiedztwa
-            // wierzchołka f(i).
-            for(Graph::AdjIter it = this->graphY.adjBegin(fi);
-                    it != this->graphY.adjEnd(fi); ++it) {
-                if (this->graphX.getInvariant(j) ==
-                        this->graphY.getInvariant(*it) &&
-                        (!this->in_S.count(*it))) {
-                    // odrzucamy wierzchołki o złym 'stopniu' (invariant)
-                    // i już przyporządkowane
-                    this->f_map[j] = (*it);
-                    this->in_S.insert(*it);
-                    this->edges_count_k = 1;
-                    // liczba krawędzi łączących nowo przyporządkowany wierzchołek
-                    // z G[k] to 1, (właśnie nią dotarliśmy do wierzchołka)
-
-                    int next_k = max(dfs_num_k, max(dfs_num[i], dfs_num[j]));
-                    // jeżeli numerowanie drzewa jest poprawne to next_k = dfs_num_K + 1
-                    // graf musi być spójny
-
-                    if (this->match(iter + 1, next_k)) {
-                        // rozpatruj następną krawędź dla grafu G_X[k+1]
-                        return true;
-                    }
-                    this->in_S.erase(*it);
-                    // jednak złe przyporządkowanie
+        MatchFrame &frame = this->frames[depth - 1];
+        if (frame.y != NO_VERTEX) {
+            // jednak złe przyporządkowanie
+            SEARCH_STAT(this->stats.addBacktrack(this->assigned_count));
+            this->unassign(frame.y);
+            frame.y = NO_VERTEX;
+        }
+
+        idx_t y = NO_VERTEX;
+        if (frame.root) {
+            while (frame.next < this->graphY->getSize()) {
+                idx_t c = frame.next++;
+                // wierzchołki o takim samym kolorze stabilnym, nie
+                // przypisane jeszcze do żadnego z k wierzchołków drzewa
+                if (this->colourX[frame.x] != this->colourY[c]) {
+                    SEARCH_STAT(++this->stats.rejected_invariant);
+                }
+                else if (!FrozenGraph::testBit(this->in_S_bits.data(), c)) {
+                    y = c;
+                    break;
                 }
             }
         }
         else {
-            // sprawdź czy (f(i), f(j)) in E_Y[S] i idź dalej
-            //
-            // Oba wierzchołki mają już przyporządkowanie, trzeba sprawdzić
-            // czy nowo napotkana krawędź występuje też w G[S]
-            Graph::label_t fi = this->f_map.at(i);
-            Graph::label_t fj = this->f_map.at(j);
-            if(this->graphY.isConnection(fi, fj, this->in_S)) {
-                ++this->edges_count_k;
-                // jeśli występuje to zwiększamy licznik
-            }
-            if (this->match(iter + 1, dfs_num_k)) {
-                // rozpatrujemy kolejną krawędź, próbując dopasować k+1 wierzchołek
-                return true;
+            while (frame.cur != frame.end) {
+                idx_t c = *(frame.cur++);
+                // odrzucamy wierzchołki o złym kolorze stabilnym
+                // i już przyporządkowane
+                if (this->colourX[frame.x] != this->colourY[c]) {
+                    SEARCH_STAT(++this->stats.rejected_invariant);
+                }
+                else if (!FrozenGraph::testBit(this->in_S_bits.data(), c)) {
+                    y = c;
+                    break;
+                }
             }
         }
-    } else {
-        return true;
-        // przeszliśmy wszystkie krawędzie, znaleziono dopasowania
+
+        if (y == NO_VERTEX) {
+            // brak kandydatów - wracamy do poprzedniej ramki
+            --depth;
+            continue;
+        }
+
+        this->assign(frame.x, y);
+        frame.y = y;
+        this->chargeNode();
+
+        if (frame.root) {
+            // do nowego korzenia nie dochodzą i nie wychodzą żadne
+            // wcześniej napotkane krawędzie
+            this->edges_count_k = 0;
+            iter = frame.iter;
+            dfs_num_k = frame.dfs_num_k + 1;
+        }
+        else {
+            // liczba krawędzi łączących nowo przyporządkowany wierzchołek
+            // z G[k] to 1, (właśnie nią dotarliśmy do wierzchołka)
+            this->edges_count_k = 1;
+            iter = frame.iter + 1;
+            dfs_num_k = frame.dfs_num_k;
+        }
+        descend = true;
     }
-    return false;
 }
 
 
+void IsomorphismAlgo::assign(idx_t x, idx_t y)
+{
+    ++this->assigned_count;
+    this->f_map[x] = y;
+    FrozenGraph::setBit(this->in_S_bits.data(), y);
+
+    for(FrozenGraph::adj_iterator it = this->graphY->adjBegin(y);
+            it != this->graphY->adjEnd(y); ++it) {
+        ++this->mapped_in[*it];
+    }
+    for(FrozenGraph::adj_iterator it = this->graphY->predBegin(y);
+            it != this->graphY->predEnd(y); ++it) {
+        ++this->mapped_out[*it];
+    }
+}
+
+void IsomorphismAlgo::unassign(idx_t y)
+{
+    --this->assigned_count;
+    FrozenGraph::clearBit(this->in_S_bits.data(), y);
+
+    for(FrozenGraph::adj_iterator it = this->graphY->adjBegin(y);
+            it != this->graphY->adjEnd(y); ++it) {
+        --this->mapped_in[*it];
+    }
+    for(FrozenGraph::adj_iterator it = this->graphY->predBegin(y);
+            it != this->graphY->predEnd(y); ++it) {
+        --this->mapped_out[*it];
+    }
+}
+
 void IsomorphismAlgo::resetData()
 {
-    this->f_map.clear();
-    this->dfs_num.clear();
+    this->f_map.assign(this->graphX->getSize(), NO_VERTEX);
+    this->dfs_num.assign(this->graphX->getSize(), 0);
     this->dfs_vec.clear();
-    this->in_S.clear();
+    this->in_S_bits.assign(this->graphY->getWordCount(), 0);
+    this->mapped_out.assign(this->graphY->getSize(), 0);
+    this->mapped_in.assign(this->graphY->getSize(), 0);
     this->ordered_edges.clear();
     this->invX_buckets.clear();
     this->invY_buckets.clear();
+    this->colourX.clear();
+    this->colourY.clear();
+    this->colour_size.clear();
     this->edges_count_k = 0;
+    this->assigned_count = 0;
 
 }
 
 void IsomorphismAlgo::countInvBuckets()
 {
-    using std::map;
+    using std::sort;
 
-    for(Graph::iterator it = this->graphX.begin();
-            it != this->graphX.end(); ++it) {
-        ++this->invX_buckets[graphX.getInvariant(*it)];
+    this->invX_buckets.resize(this->graphX->getSize());
+    for(idx_t x = 0; x < this->graphX->getSize(); ++x) {
+        this->invX_buckets[x] = this->graphX->getInvariant(x);
     }
+    sort(this->invX_buckets.begin(), this->invX_buckets.end());
 
-    for(map<unsigned, unsigned>::const_iterator it = this->invX_buckets.begin();
-            it != invX_buckets.end(); ++it) {
+    this->invY_buckets.resize(this->graphY->getSize());
+    for(idx_t y = 0; y < this->graphY->getSize(); ++y) {
+        this->invY_buckets[y] = this->graphY->getInvariant(y);
     }
+    sort(this->invY_buckets.begin(), this->invY_buckets.end());
+}
 
-    for(Graph::iterator it = this->graphY.begin();
-            it != this->graphY.end(); ++it) {
-        ++this->invY_buckets[graphY.getInvariant(*it)];
+bool IsomorphismAlgo::refineColours()
+{
+    this->colourX.resize(this->graphX->getSize());
+    for(idx_t x = 0; x < this->graphX->getSize(); ++x) {
+        this->colourX[x] = this->graphX->getInvariant(x);
+    }
+    this->colourY.resize(this->graphY->getSize());
+    for(idx_t y = 0; y < this->graphY->getSize(); ++y) {
+        this->colourY[y] = this->graphY->getInvariant(y);
+    }
+
+    unsigned int colour_count = 0;
+    this->refinement.budget = this->budget;
+    if (!ColourRefinement::refineJoint(*this->graphX, *this->graphY,
+                this->colourX, this->colourY, colour_count,
+                this->refinement)) {
+        return false;
     }
-}
 
+    this->colour_size.assign(colour_count, 0);
+    for(idx_t x = 0; x < this->graphX->getSize(); ++x) {
+        ++this->colour_size[this->colourX[x]];
+    }
+    return true;
+}
 
 void IsomorphismAlgo::numberVertexes()
 {
 
-    using std::multimap;
+    using std::vector;
+    using std::pair;
     using std::make_pair;
-    typedef multimap<unsigned int, Graph::label_t> XinvLabelMap;
+    using std::sort;
+    typedef vector<pair<unsigned int, idx_t> > XinvLabelMap;
 
-    XinvLabelMap xinvLabel;
-    // multimapa liczba wierzchołków o takim samym 'stopniu' (invariant) jak ja
-    //   -->
-    // mój znacznik
+    XinvLabelMap &xinvLabel = this->root_order;
+    // pary: liczba wierzchołków o takim samym kolorze stabilnym jak ja,
+    // mój indeks; posortowane rosnąco
 
-    for(Graph::iterator it = this->graphX.begin();
-            it != this->graphX.end(); ++it) {
-        unsigned int inv = graphX.getInvariant(*it);
-        xinvLabel.insert(
-                make_pair(this->invX_buckets[inv], (*it)));
+    xinvLabel.clear();
+    for(idx_t x = 0; x < this->graphX->getSize(); ++x) {
+        unsigned int bucket = this->colour_size[this->colourX[x]];
+        xinvLabel.push_back(make_pair(bucket, x));
     }
+    sort(xinvLabel.begin(), xinvLabel.end());
 
 
-    Graph::dfs_visited visited;
-
-    dfs_idx_t idx = 0;
-    this->dfs_vec.resize(xinvLabel.size());
+    this->visited.assign(this->graphX->getSize(), false);
 
+    // ścieżki kolejnych drzew dopisywane są wprost do dfs_vec
+    this->dfs_vec.clear();
     for(XinvLabelMap::const_iterator it = xinvLabel.begin();
             it != xinvLabel.end(); ++it) {
-        Graph::dfs_path path;
-        this->graphX.getDFSPath(path, it->second, visited);
-
-        for(Graph::dfs_path::const_iterator dfsIt = path.begin();
-                dfsIt != path.end(); ++dfsIt) {
-            this->dfs_vec[idx] = (*dfsIt);
-            this->dfs_num[(*dfsIt)] = (idx++);
-        }
-        visited.insert(path.begin(), path.end());
+        this->graphX->appendDFSPath(this->dfs_vec, it->second,
+                this->visited, this->dfs_stack);
 
-        if (visited.size() == this->graphX.getSize()) {
+        if (this->dfs_vec.size() == this->graphX->getSize()) {
             break;
         }
     }
+
+    for(dfs_idx_t idx = 0; idx < (dfs_idx_t) this->dfs_vec.size(); ++idx) {
+        this->dfs_num[this->dfs_vec[idx]] = idx;
+    }
 }
 
 bool IsomorphismAlgo::EdgeComparator::operator() (
-        const Graph::Edge &left, const Graph::Edge &right)
+        const FrozenGraph::Edge &left, const FrozenGraph::Edge &right)
 {
     using std::min;
     using std::max;
@@ -263,11 +643,11 @@ bool IsomorphismAlgo::EdgeComparator::operator() (
 
     typedef IsomorphismAlgo::dfs_idx_t dfs_idx_t;
 
-    dfs_idx_t ls = this->dfs_num.at(left.source);
-    dfs_idx_t lt = this->dfs_num.at(left.target);
+    dfs_idx_t ls = this->dfs_num[left.source];
+    dfs_idx_t lt = this->dfs_num[left.target];
 
-    dfs_idx_t rs = this->dfs_num.at(right.source);
-    dfs_idx_t rt = this->dfs_num.at(right.target);
+    dfs_idx_t rs = this->dfs_num[right.source];
+    dfs_idx_t rt = this->dfs_num[right.target];
 
     dfs_idx_t maxl = max(ls, lt);
     dfs_idx_t maxr = max(rs, rt);
@@ -280,12 +660,7 @@ void IsomorphismAlgo::orderEdges()
 {
     using std::sort;
 
-    Graph::edge_set_t edges;
-
-    this->graphX.getEdges(edges);
-
-    this->ordered_edges.insert(this->ordered_edges.begin(),
-            edges.begin(), edges.end());
+    this->graphX->getEdges(this->ordered_edges);
 
     EdgeComparator comp(this->dfs_num);
 
@@ -298,32 +673,58 @@ std::string IsomorphismAlgo::getInfo() const
 {
     using std::endl;
     using std::stringstream;
-    typedef std::vector<Graph::Edge> EdgeVec;
+    typedef std::vector<FrozenGraph::Edge> EdgeVec;
 
     stringstream ss;
-    for(dfs_num_t::const_iterator it = this->dfs_num.begin();
-            it != this->dfs_num.end(); ++it) {
-        ss << it->first << " :: " << it->second << endl;
+    for(idx_t x = 0; x < this->dfs_num.size(); ++x) {
+        ss << this->graphX->getLabel(x) << " :: " << this->dfs_num[x] << endl;
     }
 
     for(EdgeVec::const_iterator it = this->ordered_edges.begin();
             it != this->ordered_edges.end(); ++it) {
-        ss << it->source << " -> " << it->target << " | " <<
-            this->dfs_num.at(it->source) << " -> " <<
-            this->dfs_num.at(it->target) << endl;
+        ss << this->graphX->getLabel(it->source) << " -> " <<
+            this->graphX->getLabel(it->target) << " | " <<
+            this->dfs_num[it->source] << " -> " <<
+            this->dfs_num[it->target] << endl;
     }
 
     ss << endl;
 
-    for(iso_map::const_iterator it = this->f_map.begin();
-            it != this->f_map.end(); ++it) {
-        ss << it->first << " -->> " << it->second << endl;
+    for(idx_t x = 0; x < this->f_map.size(); ++x) {
+        if (this->f_map[x] != NO_VERTEX) {
+            ss << this->graphX->getLabel(x) << " -->> " <<
+                this->graphY->getLabel(this->f_map[x]) << endl;
+        }
     }
 
     ss << endl;
 
     return ss.str();
 }
+void IsomorphismAlgo::mapLabels()
+{
+    using std::make_pair;
+
+    idx_t x = 0;
+    iso_map::iterator it = this->label_map.begin();
+    if (this->label_map.size() == this->f_map.size()) {
+        for(; x < this->f_map.size() &&
+                it->first == this->graphX->getLabel(x); ++x, ++it) {
+            it->second = this->graphY->getLabel(this->f_map[x]);
+        }
+    }
+    if (x == this->f_map.size()) {
+        return;
+    }
+
+    this->label_map.clear();
+    for(x = 0; x < this->f_map.size(); ++x) {
+        this->label_map.insert(this->label_map.end(),
+                make_pair(this->graphX->getLabel(x),
+                    this->graphY->getLabel(this->f_map[x])));
+    }
+}
+
 bool IsomorphismAlgo::verifyIsomorphism(const Graph &graphX, const Graph &graphY, const iso_map &f)
 {
     Graph::edge_set_t edgesX;
@@ -13,11 +13,18 @@
 #define ISOMORPHISMALGO_HPP
 
 #include <map>
-#include <set>
+#include <vector>
+#include <algorithm>
 #include <sstream>
 #include <iostream>
+#include <atomic>
 
 #include "graph.hpp"
+#include "frozenGraph.hpp"
+#include "colourRefinement.hpp"
+#include "searchLimits.hpp"
+
+class CompiledPattern;
 
 /**
  * @brief klasa reprezentuje algorytm do weryfikacji izomorfizmu grafów
@@ -26,9 +33,19 @@
  * wersję algorytmu powrotów.
  *
  * Udostępnia także funkcję weryfikującą izomorfizm dwóch grafów.
+ *
+ * Algorytm pracuje na zamrożonych grafach \ref FrozenGraph (reprezentacja CSR
+ * z gęstymi indeksami 0..n-1). Cały stan przeszukiwania to płaskie tablice
+ * indeksowane gęstymi indeksami (oraz zbiór bitowy S), a znaczniki
+ * \ref Graph::label_t pojawiają się dopiero w wynikowym przekształceniu
+ * \ref IsomorphismAlgo::getIsoMap.
  */
 class IsomorphismAlgo
 {
+    friend class ParallelIsoSolver;
+    friend class IsoSolver;
+    friend class CompiledPattern;
+
     public:
         /**
          * @brief mapa do reprezentacji izomorfizmu dwóch grafów
@@ -45,13 +62,27 @@ class IsomorphismAlgo
          */
         IsomorphismAlgo(const Graph &_graphX, const Graph &_graphY);
 
+        /**
+         * @brief konstruktor biorący referencje na dwa zamrożone grafy
+         *
+         * Grafy nie są kopiowane, muszą istnieć przez cały czas życia
+         * obiektu.
+         *
+         * @param _graphX zamrożony graf X
+         * @param _graphY zamrożony graf Y
+         */
+        IsomorphismAlgo(const FrozenGraph &_graphX, const FrozenGraph &_graphY);
+
         /**
          * @brief funkcja weryfikująca izomorfizm grafów podanych w
          * konstruktorze
          *
          * * W pierwszym kroku sprawdzane jest czy grafy spełniają wymagania
          * podstawowe \ref IsomorphismAlgo::meetsRequirements.
-         * * Jeżeli grafy spełniają te wymagania, przygotowywane są struktury danych.
+         * * Jeżeli grafy spełniają te wymagania, wyznaczane są kolory stabilne
+         * (\ref IsomorphismAlgo::refineColours); różne histogramy kolorów
+         * oznaczają brak izomorfizmu bez przeszukiwania.
+         * * Przygotowywane są struktury danych.
          * * Następnie wykonywany jest właściwy algorytm (metoda powrotów).
          * * Jeżeli grafy są izomorficzne, po wykonaniu się funkcji obiekt klasy
          * zawiera przekształcenie izomorficzne z grafu X na graf Y.
@@ -61,6 +92,27 @@ class IsomorphismAlgo
          */
         bool isIsomorphism();
 
+        /**
+         * @brief funkcja weryfikująca izomorfizm z limitami przeszukiwania
+         *
+         * Przeszukiwanie sprawdza limity co \ref BUDGET_CHECK_INTERVAL węzłów
+         * i przerywa się, gdy upłynie termin, zostanie przekroczona liczba
+         * węzłów lub ustawiona zostanie flaga przerwania.
+         *
+         * @param limits limity przeszukiwania
+         *
+         * @return \ref ISO_ISOMORPHIC, \ref ISO_NOT_ISOMORPHIC lub
+         * \ref ISO_UNKNOWN gdy przeszukiwanie przerwano
+         */
+        IsoResult isIsomorphism(const SearchLimits &limits);
+
+        /**
+         * @brief statystyki ostatniej weryfikacji (także przerwanej)
+         *
+         * @return referencja na statystyki
+         */
+        const SearchStats &getStats() const {return this->stats;};
+
         /**
          * @brief sprawdź warunki podstawowe izomorfizmu grafów podanych w
          * konstruktorze.
@@ -81,7 +133,7 @@ class IsomorphismAlgo
          *
          * @return referencja na mapę znaczników grafu X na graf Y
          */
-        const iso_map &getIsoMap() const {return this->f_map;};
+        const iso_map &getIsoMap() const {return this->label_map;};
 
         /**
          * @brief Weryfikuje przekształcenie izomorficzne dwóch grafów.
@@ -104,6 +156,11 @@ class IsomorphismAlgo
         std::string getInfo() const;
 
     private:
+        /**
+         * @brief gęsty indeks wierzchołka zamrożonego grafu
+         */
+        typedef FrozenGraph::idx_t idx_t;
+
         /**
          * @brief indeks wierzchołka DFS lasu
          */
@@ -112,17 +169,109 @@ class IsomorphismAlgo
         /**
          * @brief iterator po posortowanych krawędziach
          */
-        typedef std::vector<Graph::Edge>::const_iterator edge_iter;
+        typedef std::vector<FrozenGraph::Edge>::const_iterator edge_iter;
 
         /**
-         * @brief mapowanie \ref Graph::label_t -> \ref IsomorphismAlgo::dfs_idx_t
+         * @brief mapowanie \ref IsomorphismAlgo::idx_t -> \ref IsomorphismAlgo::dfs_idx_t
          */
-        typedef std::map<Graph::label_t, dfs_idx_t> dfs_num_t;
+        typedef std::vector<dfs_idx_t> dfs_num_t;
 
         /**
-         * @brief mapowanie \ref IsomorphismAlgo::dfs_idx_t -> \ref Graph::label_t
+         * @brief mapowanie \ref IsomorphismAlgo::dfs_idx_t -> \ref IsomorphismAlgo::idx_t
          */
-        typedef std::vector<Graph::label_t> dfs_vec_t;
+        typedef std::vector<idx_t> dfs_vec_t;
+
+        /**
+         * @brief przekształcenie indeksów grafu X na indeksy grafu Y,
+         * \ref NO_VERTEX dla wierzchołków bez przyporządkowania
+         */
+        typedef std::vector<idx_t> idx_map;
+
+        /**
+         * @brief posortowane 'stopnie' (invariant) wszystkich wierzchołków
+         * grafu, czyli histogram 'stopni' w postaci ciągu
+         */
+        typedef std::vector<unsigned int> inv_hist_t;
+
+        /**
+         * @brief poddrzewo przeszukiwania do przetworzenia niezależnie
+         * (np. przez inny wątek)
+         *
+         * Opisuje stan wejścia do \ref IsomorphismAlgo::match po
+         * przyporządkowaniu pierwszych images.size() wierzchołków DFS lasu.
+         */
+        struct SearchTask
+        {
+            /**
+             * @brief obrazy wierzchołków dfs_vec[0], dfs_vec[1], ...
+             */
+            std::vector<idx_t> images;
+
+            /**
+             * @brief pozycja w \ref IsomorphismAlgo::ordered_edges
+             */
+            size_t edge;
+
+            /**
+             * @brief indeks DFS ostatnio rozpatrywanego wierzchołka
+             */
+            int dfs_num_k;
+
+            /**
+             * @brief wartość \ref IsomorphismAlgo::edges_count_k
+             */
+            int edges_count_k;
+        };
+
+        /**
+         * @brief punkt wyboru na stosie przeszukiwania
+         * \ref IsomorphismAlgo::match
+         */
+        struct MatchFrame
+        {
+            /**
+             * @brief czy wybierany jest obraz korzenia lasu DFS (kandydaci:
+             * wszystkie wierzchołki G_Y), czy obraz końca krawędzi (kandydaci:
+             * następniki f(i))
+             */
+            bool root;
+
+            /**
+             * @brief krawędź, przy której powstał punkt wyboru
+             */
+            edge_iter iter;
+
+            /**
+             * @brief dla korzenia - indeks DFS przed przyporządkowaniem,
+             * dla końca krawędzi - indeks DFS po przyporządkowaniu
+             */
+            int dfs_num_k;
+
+            /**
+             * @brief wierzchołek grafu G_X, któremu szukany jest obraz
+             */
+            idx_t x;
+
+            /**
+             * @brief bieżący obraz x (\ref NO_VERTEX gdy brak)
+             */
+            idx_t y;
+
+            /**
+             * @brief kolejny kandydat dla korzenia
+             */
+            idx_t next;
+
+            /**
+             * @brief kolejny kandydat dla końca krawędzi
+             */
+            FrozenGraph::adj_iterator cur;
+
+            /**
+             * @brief koniec listy kandydatów dla końca krawędzi
+             */
+            FrozenGraph::adj_iterator end;
+        };
 
         /**
          * @brief komparator do sortowania krawędzi w DFS lesie
@@ -151,68 +300,146 @@ class IsomorphismAlgo
                  *
                  * @return czy pierwsza krawędź jest mniejsza od drugiej
                  */
-                bool operator() (const Graph::Edge &left, const Graph::Edge &right);
+                bool operator() (const FrozenGraph::Edge &left, const FrozenGraph::Edge &right);
 
             private:
                 /**
-                 * @brief mapa \ref IsomorphismAlgo::dfs_num_t
+                 * @brief tablica \ref IsomorphismAlgo::dfs_num_t
                  */
                 const dfs_num_t &dfs_num;
         };
     private:
+        /**
+         * @brief zamrożona kopia grafu X, gdy obiekt stworzono z \ref Graph
+         */
+        const FrozenGraph frozenX;
+
+        /**
+         * @brief zamrożona kopia grafu Y, gdy obiekt stworzono z \ref Graph
+         */
+        const FrozenGraph frozenY;
+
         /**
          * @brief Graf X na podstawie którego budowany będzie DFS las
          */
-        const Graph &graphX;
+        const FrozenGraph *graphX;
 
         /**
          * @brief Graf Y w którym szukane będą wierzchołki izomorficzne
          */
-        const Graph &graphY;
+        const FrozenGraph *graphY;
 
         /**
          * @brief przekształcenie izomorficzne wierzchołków grafu \ref IsomorphismAlgo::graphX na
-         * \ref IsomorphismAlgo::graphY
+         * \ref IsomorphismAlgo::graphY (w indeksach)
          */
-        iso_map f_map;
+        idx_map f_map;
+
+        /**
+         * @brief przekształcenie izomorficzne w znacznikach, wypełniane
+         * po znalezieniu izomorfizmu
+         */
+        iso_map label_map;
 
 
         /**
-         * @brief mapowanie \ref Graph::label_t -> \ref IsomorphismAlgo::dfs_idx_t
+         * @brief mapowanie \ref IsomorphismAlgo::idx_t -> \ref IsomorphismAlgo::dfs_idx_t
          * dla wierzchołków grafu \ref IsomorphismAlgo::graphX
          */
         dfs_num_t dfs_num;
 
         /**
-         * @brief mapowanie \ref IsomorphismAlgo::dfs_idx_t -> \ref Graph::label_t
+         * @brief mapowanie \ref IsomorphismAlgo::dfs_idx_t -> \ref IsomorphismAlgo::idx_t
          * dla wierzchołków grafu \ref IsomorphismAlgo::graphX
          */
         dfs_vec_t dfs_vec;
 
         /**
          * @brief wierzchołki grafu \ref IsomorphismAlgo::graphY już dopasowane
+         * (zbiór S) zapisane bitowo
          */
-        std::set<Graph::label_t> in_S;
+        FrozenGraph::vertex_bits_t in_S_bits;
+
+        /**
+         * @brief dla każdego wierzchołka grafu \ref IsomorphismAlgo::graphY
+         * liczba jego następników należących do S
+         *
+         * Aktualizowane przyrostowo przy każdym przyporządkowaniu
+         * i cofnięciu przyporządkowania (koszt O(stopień)).
+         */
+        std::vector<unsigned int> mapped_out;
+
+        /**
+         * @brief dla każdego wierzchołka grafu \ref IsomorphismAlgo::graphY
+         * liczba jego poprzedników należących do S
+         */
+        std::vector<unsigned int> mapped_in;
 
         /**
          * @brief posortowane krawędzie DFS lasu, odpowiadające krawędziom grafu
          * \ref IsomorphismAlgo::graphX
          */
-        std::vector<Graph::Edge> ordered_edges;
+        std::vector<FrozenGraph::Edge> ordered_edges;
 
         /**
          * @brief struktura pomocnicza, do wyznaczenia liczby
          * wierzchołków o takim samym 'stopniu' (invariant) w grafie
          * \ref IsomorphismAlgo::graphX
          */
-        std::map<unsigned int, unsigned int> invX_buckets;
+        inv_hist_t invX_buckets;
 
         /**
          * @brief struktura pomocnicza, do wyznaczenia liczby
          * wierzchołków o takim samym 'stopniu' (invariant) w grafie
          * \ref IsomorphismAlgo::graphY
          */
-        std::map<unsigned int, unsigned int> invY_buckets;
+        inv_hist_t invY_buckets;
+
+        /**
+         * @brief stabilne kolory wierzchołków grafu \ref IsomorphismAlgo::graphX
+         *
+         * Wierzchołek x może zostać przyporządkowany tylko wierzchołkowi y
+         * o tym samym kolorze.
+         */
+        ColourRefinement::colouring_t colourX;
+
+        /**
+         * @brief stabilne kolory wierzchołków grafu \ref IsomorphismAlgo::graphY
+         */
+        ColourRefinement::colouring_t colourY;
+
+        /**
+         * @brief liczba wierzchołków grafu \ref IsomorphismAlgo::graphX
+         * w każdym z kolorów
+         */
+        std::vector<unsigned int> colour_size;
+
+        /**
+         * @brief skompilowany wzorzec grafu X (NULL - kroki przygotowawcze
+         * wykonywane od nowa)
+         */
+        const CompiledPattern *pattern;
+
+        /**
+         * @brief tablice robocze \ref IsomorphismAlgo::refineColours
+         */
+        ColourRefinement::Workspace refinement;
+
+        /**
+         * @brief pary (liczność koloru, indeks) porządkujące korzenie lasu
+         * DFS w \ref IsomorphismAlgo::numberVertexes
+         */
+        std::vector<std::pair<unsigned int, idx_t> > root_order;
+
+        /**
+         * @brief wierzchołki grafu X odwiedzone przy numerowaniu
+         */
+        FrozenGraph::dfs_visited visited;
+
+        /**
+         * @brief stos przejścia DFS przy numerowaniu
+         */
+        FrozenGraph::dfs_path dfs_stack;
 
         /**
          * @brief licznik wykorzystywany w metodzie IsomorphismAlgo::match
@@ -222,17 +449,168 @@ class IsomorphismAlgo
          */
         int edges_count_k;
 
+        /**
+         * @brief ramki stosu przeszukiwania, przydzielane raz na
+         * liczbę wierzchołków + 1 elementów
+         */
+        std::vector<MatchFrame> frames;
+
+        /**
+         * @brief liczba przyporządkowanych wierzchołków
+         */
+        unsigned int assigned_count;
+
+        /**
+         * @brief gdy różne od NULL, przeszukiwanie zatrzymuje się po
+         * przyporządkowaniu \ref IsomorphismAlgo::split_depth wierzchołków
+         * i zapisuje tu stan jako zadanie
+         */
+        std::vector<SearchTask> *task_sink;
+
+        /**
+         * @brief głębokość podziału drzewa przeszukiwania na zadania
+         */
+        unsigned int split_depth;
+
+        /**
+         * @brief flaga przerwania przeszukiwania (NULL gdy brak)
+         */
+        const std::atomic<bool> *cancel;
+
+        /**
+         * @brief budżet przeszukiwania (NULL gdy brak limitów)
+         */
+        SearchBudget *budget;
+
+        /**
+         * @brief węzły nie przekazane jeszcze do \ref IsomorphismAlgo::budget
+         */
+        unsigned int pending_nodes;
+
+        /**
+         * @brief statystyki przeszukiwania
+         */
+        SearchStats stats;
+
+        /**
+         * @brief konstruktor bez grafów, dla \ref IsoSolver - grafy podaje
+         * \ref IsomorphismAlgo::bind
+         */
+        IsomorphismAlgo();
+
+        /**
+         * @brief weryfikuj kolejną parę grafów, zachowując przydzielone
+         * tablice
+         *
+         * Grafy nie są kopiowane, muszą istnieć do końca weryfikacji.
+         *
+         * @param _graphX zamrożony graf X
+         * @param _graphY zamrożony graf Y
+         */
+        void bind(const FrozenGraph &_graphX, const FrozenGraph &_graphY);
+
+        /**
+         * @brief weryfikuj skompilowany wzorzec z kolejnym grafem Y
+         *
+         * @param _pattern wzorzec (graf X)
+         * @param _graphY zamrożony graf Y
+         */
+        void bind(const CompiledPattern &_pattern, const FrozenGraph &_graphY);
+
+        /**
+         * @brief policz węzeł przeszukiwania i co
+         * \ref SearchBudget::getCheckInterval węzłów rozlicz budżet
+         */
+        void chargeNode()
+        {
+            ++this->stats.nodes;
+            if (this->budget != NULL &&
+                    ++this->pending_nodes >= this->budget->getCheckInterval()) {
+                this->budget->consume(this->pending_nodes);
+                this->pending_nodes = 0;
+            }
+        };
+
+        /**
+         * @brief przekaż do budżetu węzły nierozliczone
+         */
+        void flushBudget();
+
+        /**
+         * @brief sprawdź limity między krokami przygotowawczymi
+         *
+         * @return czy można kontynuować (true gdy brak budżetu)
+         */
+        bool checkBudget()
+        {
+            return this->budget == NULL || this->budget->consume(0);
+        };
+
+        /**
+         * @brief wykonaj kroki przed przeszukiwaniem: warunki podstawowe,
+         * kolory stabilne, numeracja DFS i porządek krawędzi
+         *
+         * Limity \ref IsomorphismAlgo::budget sprawdzane są między krokami
+         * i w trakcie uszczegóławiania kolorów; po ich wyczerpaniu wynik
+         * to false, a wywołujący rozróżnia przypadki przez
+         * \ref SearchBudget::isExhausted.
+         *
+         * @return czy grafy mogą być izomorficzne
+         */
+        bool prepare();
+
+        /**
+         * @brief kroki przygotowawcze z \ref IsomorphismAlgo::pattern:
+         * zależne od grafu X są przepisywane, graf Y kolorowany jest według
+         * zapisu wzorca
+         *
+         * @return czy grafy mogą być izomorficzne (false także po
+         * wyczerpaniu limitów)
+         */
+        bool preparePattern();
+
+        /**
+         * @brief wykonaj kroki przygotowawcze zależne tylko od grafu X
+         * i przenieś ich wyniki do wzorca
+         *
+         * @param target kompilowany wzorzec
+         */
+        void compile(CompiledPattern &target);
+
+        /**
+         * @brief przejmij wyniki \ref IsomorphismAlgo::prepare innego
+         * obiektu dla tych samych grafów
+         *
+         * @param master obiekt, na którym wykonano prepare
+         */
+        void adoptPrepared(const IsomorphismAlgo &master);
+
+        /**
+         * @brief przeszukaj poddrzewo opisane zadaniem
+         *
+         * @param task zadanie
+         *
+         * @return czy znaleziono izomorfizm
+         */
+        bool runTask(const SearchTask &task);
+
         /**
          * @brief główna procedura sprawdzająca izomorfizm grafów
          *
-         * Metoda rekurencyjna, która próbuje przyporządkować k-temu
-         * wierzchołkowi DFS lasu, wierzchołek z grafu G_Y, tak żeby
-         * G_X[k] ~= G_Y[S].
+         * Metoda próbuje przyporządkować k-temu wierzchołkowi DFS lasu,
+         * wierzchołek z grafu G_Y, tak żeby G_X[k] ~= G_Y[S].
          *
          * Procedura przechodzi przez wierzchołki DFS lesu. Porusza się po odpowiednio
          * posortowanych krawędziach grafu \ref IsomorphismAlgo::graphX. Gdy uda się przejść
          * wszystkie krawędzie grafu \ref IsomorphismAlgo::graphX, procedura kończy się sukcesem.
          *
+         * Przeszukiwanie z powrotami jest iteracyjne: punkty wyboru (korzeń
+         * lasu, obraz nowego wierzchołka) to ramki \ref IsomorphismAlgo::MatchFrame
+         * na jawnym stosie \ref IsomorphismAlgo::frames, a krawędzie między
+         * dopasowanymi już wierzchołkami sprawdzane są bez ramki. Głębokość
+         * stosu to co najwyżej liczba wierzchołków, niezależnie od liczby
+         * krawędzi.
+         *
          * @param iter iterator po posortowanych krawędziach grafu \ref IsomorphismAlgo::graphX, czyli po
          * \ref IsomorphismAlgo::dfs_num.
          * @param dfs_num_k indeks rozpatrywanego wierzchołka DFS lasu.
@@ -242,8 +620,31 @@ class IsomorphismAlgo
          */
         bool match(edge_iter iter, int dfs_num_k);
 
+        /**
+         * @brief przyporządkuj wierzchołkowi x grafu X wierzchołek y grafu Y
+         *
+         * Dodaje y do S i aktualizuje liczniki
+         * \ref IsomorphismAlgo::mapped_out i \ref IsomorphismAlgo::mapped_in
+         * sąsiadów y.
+         *
+         * @param x indeks wierzchołka grafu X
+         * @param y indeks wierzchołka grafu Y
+         */
+        void assign(idx_t x, idx_t y);
+
+        /**
+         * @brief cofnij przyporządkowanie wierzchołka y grafu Y
+         *
+         * @param y indeks wierzchołka grafu Y
+         */
+        void unassign(idx_t y);
+
         /**
          * @brief czyści struktury danych
+         *
+         * Tablice dostają rozmiary bieżących grafów, ale zachowują
+         * pojemność, więc kolejne weryfikacje grafów nie większych od
+         * poprzednich nie przydzielają pamięci.
          */
         void resetData();
 
@@ -256,10 +657,23 @@ class IsomorphismAlgo
          */
         void countInvBuckets();
 
+        /**
+         * @brief wyznacza stabilne kolory wierzchołków obu grafów
+         *
+         * Generuje struktury danych \ref IsomorphismAlgo::colourX,
+         * \ref IsomorphismAlgo::colourY i \ref IsomorphismAlgo::colour_size.
+         *
+         * @return czy histogramy kolorów obu grafów są równe
+         */
+        bool refineColours();
+
         /**
          * @brief numeruje wierzchołki grafu \ref IsomorphismAlgo::graphX zgodnie
          * z czasem przechodzenia DFS
          *
+         * Korzenie lasu DFS wybierane są od wierzchołków z najmniej
+         * licznych kolorów.
+         *
          * Generuje struktury danych \ref IsomorphismAlgo::dfs_num i
          * \ref IsomorphismAlgo::dfs_vec.
          */
@@ -273,6 +687,15 @@ class IsomorphismAlgo
          * Generuje strukturę danych \ref IsomorphismAlgo::ordered_edges
          */
         void orderEdges();
+
+        /**
+         * @brief przepisuje \ref IsomorphismAlgo::f_map na znaczniki
+         *
+         * Generuje strukturę danych \ref IsomorphismAlgo::label_map. Gdy
+         * mapa zawiera już te same znaczniki grafu X (kolejna weryfikacja
+         * z tym samym grafem X), nadpisywane są tylko obrazy.
+         */
+        void mapLabels();
 };
 
 
@@ -15,18 +15,128 @@
 #include <iterator>
 #include <chrono>
 #include <exception>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
 
 //#define NDEBUG
 #include <assert.h>
 #include <vector>
+#include <fstream>
+#include <algorithm>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <csignal>
+#include <unistd.h>
 
 #include "graph.hpp"
+#include "frozenGraph.hpp"
 #include "isomorphismAlgo.hpp"
+#include "isoEngine.hpp"
+#include "canonicalForm.hpp"
+#include "batchClassifier.hpp"
+#include "randomEngine.hpp"
+#include "graphFamilies.hpp"
+#include "graphFormats.hpp"
+#include "isoServer.hpp"
+#include "graphParser.hpp"
+#include "compiledPattern.hpp"
 
 #define VERTEX_SIZE_PRINT 10
 
 using namespace std;
 
+/**
+ * @brief opcje programu podawane jako `--nazwa=wartość'
+ */
+struct RunOptions
+{
+    RunOptions(): engine(ENGINE_BACKTRACK), threads(1), timeout(0.0),
+        max_nodes(0), stats(false), has_seed(false), seed(0),
+        family(FAMILY_RANDOM), noniso(false), format(FORMAT_AUTO) {};
+
+    /**
+     * @brief silnik weryfikacji izomorfizmu (--engine)
+     */
+    IsoEngine engine;
+
+    /**
+     * @brief liczba wątków silnika bt i parsera plików tekstowych (--threads),
+     * 0 - liczba rdzeni
+     */
+    unsigned int threads;
+
+    /**
+     * @brief limit czasu weryfikacji w sekundach (--timeout), 0 - bez limitu
+     */
+    double timeout;
+
+    /**
+     * @brief limit węzłów przeszukiwania (--max-nodes), 0 - bez limitu
+     */
+    unsigned long long max_nodes;
+
+    /**
+     * @brief czy wypisać statystyki przeszukiwania (--stats)
+     */
+    bool stats;
+
+    /**
+     * @brief czy podano ziarno generatora grafów losowych (--seed)
+     */
+    bool has_seed;
+
+    /**
+     * @brief ziarno generatora grafów losowych
+     */
+    uint64_t seed;
+
+    /**
+     * @brief rodzina grafów dla opcji r (--family)
+     */
+    GraphFamily family;
+
+    /**
+     * @brief czy opcja r ma wygenerować parę nieizomorficzną (--noniso)
+     */
+    bool noniso;
+
+    /**
+     * @brief format wczytywanych plików z grafem (--format), domyślnie
+     * rozpoznawany po rozszerzeniu
+     */
+    GraphFormat format;
+};
+
+/**
+ * @brief ziarno z opcji lub, gdy nie podano, z zegara
+ *
+ * @param options opcje programu
+ *
+ * @return ziarno
+ */
+uint64_t runSeed(const RunOptions &options)
+{
+    return options.has_seed ? options.seed : RandomEngine::clockSeed();
+}
+
+/**
+ * @brief flaga przerwania weryfikacji, ustawiana przez SIGINT
+ */
+static std::atomic<bool> interrupted(false);
+
+/**
+ * @brief obsługa SIGINT - przerwij bieżącą weryfikację
+ *
+ * @param sig numer sygnału
+ */
+extern "C" void onInterrupt(int sig)
+{
+    (void)sig;
+    interrupted.store(true);
+}
+
 /**
  * @brief zwraca wiadomość pomocniczą programu
  *
@@ -38,19 +148,74 @@ std::string helpMsg()
     stringstream ss;
 
     ss  << "Program do weryfikowania izomorfizmu grafów" << endl
-        << "IZOMORF [OPCJA] [VAL1] [VAL2]" << endl
+        << "IZOMORF [OPCJA] [VAL1] [VAL2] [--FLAGA=WARTOŚĆ ...]" << endl
         << " OPCJE:" << endl
         << string(80, '-') << endl
         << "    f <plik z grafem 1> <plik z grafem 2> " << endl
-        << "          wczytaj grafy z plików i przetestuj ich izomorfizm" << endl
+        << "          wczytaj grafy z plików i przetestuj ich izomorfizm; pliki" << endl
+        << "          mogą być tekstowe lub binarne (z opcji convert)" << endl
+        << string(80, '-') << endl
+        << "    convert <plik tekstowy> <plik wynikowy> " << endl
+        << "          zapisz graf w formacie binarnym, wczytywanym bez parsowania" << endl
+        << "          (odwzorowanie pliku w pamięć), lub w formacie tekstowym," << endl
+        << "          jeżeli wskazuje go rozszerzenie pliku wynikowego" << endl
         << string(80, '-') << endl
         << "    r <V = liczba wierzchołków> <D = gęstość> " << endl
         << "          wygeneruj graf dwa izomorficzne grafy losowe o danej ilości" << endl
         << "          wierzchołków i gęstości i przetestuj ich izomorfizm" << endl
         << "          0 <= V <= 1000, D in (0, 1]" << endl
         << string(80, '-') << endl
+        << "    c <plik z grafem> " << endl
+        << "          wczytaj graf z pliku i wypisz jego etykietowanie kanoniczne" << endl
+        << "          oraz skrót certyfikatu (grafy izomorficzne mają równe skróty)" << endl
+        << string(80, '-') << endl
+        << "    b <katalog | plik z listą grafów> " << endl
+        << "          podziel grafy z plików na klasy izomorfizmu; plik z listą" << endl
+        << "          zawiera jedną ścieżkę w wierszu (względną wobec pliku listy)," << endl
+        << "          puste wiersze i zaczynające się od # są pomijane" << endl
+        << string(80, '-') << endl
+        << "    m <plik ze wzorcem> <katalog | plik z listą grafów> " << endl
+        << "          porównaj jeden graf wzorca z każdym z grafów (lista jak dla" << endl
+        << "          opcji b); kroki przygotowawcze wzorca wykonywane są raz" << endl
+        << string(80, '-') << endl
+        << "    s [ścieżka gniazda] " << endl
+        << "          tryb serwera: czytaj żądania ze standardowego wejścia lub" << endl
+        << "          z gniazda domeny Unix i odpowiadaj wierszami JSON;" << endl
+        << "          żądania: `files <plik X> <plik Y>'," << endl
+        << "          `inline <format|binary> <bajty X> <bajty Y>' + dane, `quit'" << endl
+        << string(80, '-') << endl
         << "    t " << endl
         << "          przeprowadź serię testów" << endl
+        << string(80, '-') << endl
+        << " FLAGI:" << endl
+        << "    --engine=<bt|vf2pp>" << endl
+        << "          silnik weryfikacji: bt - algorytm powrotów (domyślny)," << endl
+        << "          vf2pp - algorytm w stylu VF2++" << endl
+        << "    --threads=<N>" << endl
+        << "          liczba wątków silnika bt oraz wczytywania plików tekstowych" << endl
+        << "          (opcje f, s, convert; dla opcji m - liczba grafów porównywanych" << endl
+        << "          jednocześnie; domyślnie 1, 0 - liczba rdzeni)" << endl
+        << "    --timeout=<sekundy>" << endl
+        << "          limit czasu weryfikacji (opcje f, r, s, m - dla całej serii);" << endl
+        << "          po jego przekroczeniu wynik jest nierozstrzygnięty" << endl
+        << "    --max-nodes=<N>" << endl
+        << "          limit węzłów przeszukiwania (opcje f, r, s, m)" << endl
+        << "    --stats" << endl
+        << "          wypisz czasy kroków weryfikacji i liczniki przeszukiwania" << endl
+        << "          (liczniki tylko w wersji zbudowanej przez `make stats')" << endl
+        << "    --seed=<N>" << endl
+        << "          ziarno grafów losowych (opcje r, t); bez flagi ziarno brane" << endl
+        << "          jest z zegara i wypisywane, aby można było powtórzyć przebieg" << endl
+        << "    --family=<random|grid|regular|srg|cfi|miyazaki|tournament>" << endl
+        << "          rodzina grafów opcji r (domyślnie random); V jest zaokrąglane" << endl
+        << "          do najbliższego rozmiaru, dla którego rodzina istnieje" << endl
+        << "    --noniso" << endl
+        << "          opcja r generuje parę nieizomorficzną o równych stopniach" << endl
+        << "    --format=<auto|native|edges|dimacs|graph6|digraph6|metis>" << endl
+        << "          format wczytywanych plików tekstowych (opcje f, c, b, s, m," << endl
+        << "          convert); auto (domyślnie) rozpoznaje format po rozszerzeniu:" << endl
+        << "          .txt, .edges/.el, .dimacs/.col/.gr, .g6, .d6, .metis/.graph," << endl
+        << "          inne rozszerzenia - format natywny" << endl
         ;
     return ss.str();
 }
@@ -61,16 +226,48 @@ std::string helpMsg()
  * @param g wczytywany graf
  * @param filename nazwa pliku z grafem
  * @param graphname nazwa grafu dla komunikatu o błędzie
+ * @param threads liczba wątków parsera pliku tekstowego
+ * @param format format pliku
  */
-void readGraph(Graph &g, std::string filename, std::string graphname)
+void readGraph(Graph &g, std::string filename, std::string graphname,
+        unsigned int threads = 1, GraphFormat format = FORMAT_AUTO)
 {
 
     try {
-        g.loadFromFile(filename);
-    } catch (exception e) {
+        loadGraph(filename, format, g, threads);
+    } catch (exception &e) {
+        cout << "Nie udało się wczytać grafu " << graphname << endl
+            << "   " << e.what() << endl;
+        throw;
+    }
+}
+
+/**
+ * @brief wczytuje zamrożony graf z pliku tekstowego lub binarnego
+ * (rozpoznawanego po nagłówku), ew. wypisuje komunikat błędu
+ *
+ * @param g wczytywany graf
+ * @param filename nazwa pliku z grafem
+ * @param graphname nazwa grafu dla komunikatu o błędzie
+ * @param threads liczba wątków parsera pliku tekstowego
+ * @param format format pliku tekstowego
+ */
+void readFrozenGraph(FrozenGraph &g, std::string filename, std::string graphname,
+        unsigned int threads = 1, GraphFormat format = FORMAT_AUTO)
+{
+    if (!FrozenGraph::isBinaryFile(filename)) {
+        Graph text;
+        readGraph(text, filename, graphname, threads, format);
+        g.freeze(text);
+        return;
+    }
+
+    try {
+        g.loadBinary(filename);
+    } catch (exception &e) {
         cout << "Nie udało się wczytać grafu " << graphname << endl
             << "   " << e.what() << endl;
-        throw e;
+        throw;
     }
 }
 
@@ -78,25 +275,27 @@ void readGraph(Graph &g, std::string filename, std::string graphname)
  * @brief wypisuje na konsolę proces weryfikacji izomorfizmu
  * dwóch grafów
  *
- * @param gX graf pierwszy
- * @param gY graf drugi
+ * @param fX graf pierwszy
+ * @param fY graf drugi
+ * @param options opcje programu
  */
-void checkIsomorphism(const Graph &gX, const Graph &gY)
+void checkIsomorphism(const FrozenGraph &fX, const FrozenGraph &fY,
+        const RunOptions &options)
 {
     using std::chrono::high_resolution_clock;
     using std::chrono::duration;
     using std::chrono::duration_cast;
 
-    IsomorphismAlgo isoalg(gX, gY);
+    IsomorphismAlgo isoalg(fX, fY);
 
     cout << "*** Sprawdzanie izomorfizmu grafów ***" << endl;
     cout << string(100, '=') << endl;
     cout << "Graf X:" << endl;
-    cout << "    Liczba wierzchołków: " << gX.getVertexCount() << endl;
-    cout << "    Liczba krawędzi:     " << gX.getEdgeCount() << endl;
+    cout << "    Liczba wierzchołków: " << fX.getVertexCount() << endl;
+    cout << "    Liczba krawędzi:     " << fX.getEdgeCount() << endl;
     cout << "Graf Y:" << endl;
-    cout << "    Liczba wierzchołków: " << gY.getVertexCount() << endl;
-    cout << "    Liczba krawędzi:     " << gY.getEdgeCount() << endl;
+    cout << "    Liczba wierzchołków: " << fY.getVertexCount() << endl;
+    cout << "    Liczba krawędzi:     " << fY.getEdgeCount() << endl;
     cout << string(100, '=') << endl;
     cout << "Czy grafy spełniają warunki wstępne..." << endl;
 
@@ -108,24 +307,35 @@ void checkIsomorphism(const Graph &gX, const Graph &gY)
 
     cout << "TAK: spełniają warunki wstępne" << endl;
     cout << string(100, '=') << endl;
-    cout << "Czy grafy są izomorficzne..." << endl;
+    cout << "Czy grafy są izomorficzne... [silnik: "
+        << engineName(options.engine) << "]" << endl;
+
+    SearchLimits limits;
+    if (options.timeout > 0.0) {
+        limits.setTimeout(options.timeout);
+    }
+    limits.max_nodes = options.max_nodes;
+    limits.cancel = &interrupted;
 
+    IsomorphismAlgo::iso_map im;
+    SearchStats stats;
     high_resolution_clock::time_point start = high_resolution_clock::now();
-    bool flag = isoalg.isIsomorphism();
+    IsoResult result = isIsomorphic(fX, fY, options.engine, limits, im, stats,
+            options.threads);
     high_resolution_clock::time_point end = high_resolution_clock::now();
     duration<double> time_span = duration_cast<duration<double>>(end - start);
 
-    if (flag) {
+    if (result == ISO_UNKNOWN) {
+        cout << "__NIE WIADOMO: przekroczono limit przeszukiwania__" << endl;
+    } else if (result == ISO_ISOMORPHIC) {
         cout << "__TAK: grafy są IZOMORFICZNE__" << endl;
 
-        if (gX.getVertexCount() <= VERTEX_SIZE_PRINT) {
+        if (fX.getVertexCount() <= VERTEX_SIZE_PRINT) {
             cout << "Graf X: ---------------------------" << endl;
-            cout << gX << endl;
+            cout << fX << endl;
             cout << "Graf Y: ---------------------------" << endl;
-            cout << gY << endl;
+            cout << fY << endl;
 
-            IsomorphismAlgo::iso_map im;
-            im = isoalg.getIsoMap();
             cout << "IZOMORFIZM: -----------------------" << endl;
             for (auto iz : im) {
                 cout << iz.first << " -> " << iz.second << endl;
@@ -138,6 +348,12 @@ void checkIsomorphism(const Graph &gX, const Graph &gY)
     cout << string(100, '=') << endl;
     cout << "Czas obliczeń:" << endl;
     cout << "   " << time_span.count() << " sekund" << endl;
+    cout << "Węzły przeszukiwania:" << endl;
+    cout << "   " << stats.nodes << endl;
+    if (options.stats) {
+        cout << string(100, '=') << endl;
+        cout << stats.getInfo();
+    }
 }
 
 /**
@@ -152,11 +368,13 @@ void checkIsomorphism(const Graph &gX, const Graph &gY)
  * @param izom czy grafy powinny być izomorficzne
  * @param nr numer testu
  * @param testname nazwa testu
+ * @param options opcje programu
  *
  * @return czy test wykonał się poprawnie
  */
 bool runTestUnit(const Graph &gX, const Graph &gY,
-        bool meets, bool izom, unsigned int nr, std::string testname)
+        bool meets, bool izom, unsigned int nr, std::string testname,
+        const RunOptions &options)
 {
     using std::chrono::high_resolution_clock;
     using std::chrono::duration;
@@ -170,7 +388,9 @@ bool runTestUnit(const Graph &gX, const Graph &gY,
     cout << " -- " << testname << endl;
     cout << string(80, '=') << endl;
 
-    IsomorphismAlgo isoalg(gX, gY);
+    FrozenGraph fX(gX), fY(gY);
+    IsomorphismAlgo isoalg(fX, fY);
+    IsomorphismAlgo::iso_map im;
 
     duration<double> time_span;
 
@@ -188,7 +408,7 @@ bool runTestUnit(const Graph &gX, const Graph &gY,
 
         if (flag) {
             start = high_resolution_clock::now();
-            retrn = (izom == isoalg.isIsomorphism());
+            retrn = (izom == isIsomorphic(fX, fY, options.engine, im, options.threads));
             end = high_resolution_clock::now();
             time_span = duration_cast<duration<double>>(end - start);
         } else {
@@ -197,7 +417,7 @@ bool runTestUnit(const Graph &gX, const Graph &gY,
     }
     else {
         high_resolution_clock::time_point start = high_resolution_clock::now();
-        retrn = (izom == isoalg.isIsomorphism());
+        retrn = (izom == isIsomorphic(fX, fY, options.engine, im, options.threads));
         high_resolution_clock::time_point end = high_resolution_clock::now();
         time_span = duration_cast<duration<double>>(end - start);
     }
@@ -222,11 +442,13 @@ bool runTestUnit(const Graph &gX, const Graph &gY,
  * @param izom czy grafy powinny być izomorficzne
  * @param nr numer testu
  * @param testname nazwa testu
+ * @param options opcje programu
  *
  * @return czy test wykonał się poprawnie
  */
 bool runFileTest(std::string filenameX, std::string filenameY,
-        bool meets, bool izom, unsigned int nr, std::string testname)
+        bool meets, bool izom, unsigned int nr, std::string testname,
+        const RunOptions &options)
 {
     try {
         Graph gX, gY;
@@ -234,10 +456,10 @@ bool runFileTest(std::string filenameX, std::string filenameY,
         readGraph(gX, filenameX, "Graf X");
         readGraph(gY, filenameY, "Graf Y");
 
-        return runTestUnit(gX, gY, meets, izom, nr, testname);
+        return runTestUnit(gX, gY, meets, izom, nr, testname, options);
     } catch (exception e) {
         cout << "BŁĄD: złe dane do wczytywania grafów" << endl;
-        cout << "TEST: FAIL" << cout;
+        cout << "TEST: FAIL" << endl;
     }
     return false;
 }
@@ -254,267 +476,1649 @@ bool runFileTest(std::string filenameX, std::string filenameY,
  * @param izom czy grafy powinny być izomorficzne
  * @param nr numer testu
  * @param testname nazwa testu
+ * @param seed ziarno (ten sam przebieg daje `r v d --seed=ziarno')
+ * @param options opcje programu
  *
  * @return czy test wykonał się poprawnie
  */
 bool runRandomTest(unsigned int v, double d,
-        bool izom, unsigned int nr, std::string testname)
+        bool izom, unsigned int nr, std::string testname, uint64_t seed,
+        const RunOptions &options)
 {
     try {
-        Graph gX = Graph::generateRandom(v, d);
-        Graph gY; gY.randomIsomorphic(gX);
+        RandomEngine engine(seed);
+        Graph gX = Graph::generateRandom(v, d, engine);
+        Graph gY; gY.randomIsomorphic(gX, engine);
 
-        return runTestUnit(gX, gY, true, izom, nr, testname);
+        stringstream name;
+        name << testname << " [--seed=" << seed << "]";
+        return runTestUnit(gX, gY, true, izom, nr, name.str(), options);
     } catch (exception e) {
         cout << "BŁĄD: złe dane do generowania grafu losowego" << endl;
-        cout << "TEST: FAIL" << cout;
+        cout << "TEST: FAIL" << endl;
     }
     return false;
 }
 
 /**
- * @brief uruchom testy
+ * @brief wypisz nagłówek testu, który nie weryfikuje jednej pary grafów
+ *
+ * @param nr numer testu
+ * @param testname nazwa testu
  */
-void executeTests()
+void printTestHeader(unsigned int nr, std::string testname)
 {
-    unsigned int allTests = 0;
-    unsigned int okTests = 0;
-    unsigned int failTests = 0;
-
-    /* FILE TESTS */
-    string rootTestFold = "../tests/";
-    typedef vector< pair< pair<string, string>, string >> test_t;
-    typedef map<string, test_t> testCases_t;
-
-    typedef test_t::iterator tIter;
-    typedef testCases_t::iterator tCIter;
-    testCases_t testCases;
-
-    testCases["nie_sp_war/"] =
-    {
-        make_pair(make_pair("nsp_gx_v_1.txt", "nsp_gy_v_1.txt"),
-                "NIE SPEŁNIA WARUNKÓW WSTĘPNYCH: różna ilość wierzchołków"),
-        make_pair(make_pair("nsp_gx_e_1.txt", "nsp_gy_e_1.txt"),
-                "NIE SPEŁNIA WARUNKÓW WSTĘPNYCH: różna ilość krawędzi"),
-        make_pair(make_pair("nsp_gx_rrs_1.txt", "nsp_gy_rrs_1.txt"),
-                "NIE SPEŁNIA WARUNKÓW WSTĘPNYCH: różna liczność stopni wierzchołków 1"),
-        make_pair(make_pair("nsp_gx_rrs_1.txt", "nsp_gy_rrs_1.txt"),
-                "NIE SPEŁNIA WARUNKÓW WSTĘPNYCH: różna liczność stopni wierzchołków 2"),
-    };
-    testCases["sp_war_nie_izom/"] =
-    {
-        make_pair(make_pair("swni_gx_1.txt", "swni_gy_1.txt"),
-                "SPEŁNIA WSTĘPNE, NIE JEST IZOMORFICZNY 1"),
-        make_pair(make_pair("swni_gx_2.txt", "swni_gy_2.txt"),
-                "SPEŁNIA WSTĘPNE, NIE JEST IZOMORFICZNY 2"),
-        make_pair(make_pair("swni_gx_3.txt", "swni_gy_3.txt"),
-                "SPEŁNIA WSTĘPNE, NIE JEST IZOMORFICZNY 3"),
-    };
-    testCases["izom/"] =
-    {
-        make_pair(make_pair("izo_gx_1.txt", "izo_gy_1.txt"),
-                "IZOMORFICZNY 1"),
-        make_pair(make_pair("izo_gx_2.txt", "izo_gy_2.txt"),
-                "IZOMORFICZNY 2"),
-        make_pair(make_pair("izo_gx_3.txt", "izo_gy_3.txt"),
-                "IZOMORFICZNY 3"),
-    };
-
-    map<string, pair<bool, bool>> testCasesFlags;
-
-    testCasesFlags["nie_sp_war/"] = make_pair(false, false);
-    testCasesFlags["sp_war_nie_izom/"] = make_pair(true, false);
-    testCasesFlags["izom/"] = make_pair(true, true);
-
-    for(tCIter tcit = testCases.begin();
-            tcit != testCases.end(); ++tcit) {
-        string tfold = rootTestFold + tcit->first;
-        for(tIter tit = tcit->second.begin();
-                tit != tcit->second.end(); ++tit) {
-            string fnameX = tfold + tit->first.first;
-            string fnameY = tfold + tit->first.second;
-            string testname = tit->second;
-            cout << fnameX << ", " << fnameY << endl;
-
-            ++allTests;
-            if (runFileTest(fnameX, fnameY, testCasesFlags[tcit->first].first,
-                        testCasesFlags[tcit->first].second, allTests,
-                        testname)) {
-                ++okTests;
-            } else {
-                ++failTests;
-            }
-        }
+    cout << string(80, '*') << endl;
+    cout << "WYKONYWANIE TESTU: [" << nr << "]" << endl;
+    cout << " -- " << testname << endl;
+    cout << string(80, '=') << endl;
+}
 
-    }
+/**
+ * @brief wypisz wynik testu
+ *
+ * @param retrn czy test wykonał się poprawnie
+ *
+ * @return \p retrn
+ */
+bool printTestResult(bool retrn)
+{
+    cout << "TEST: " << (retrn ? "OK" : "FAIL") << endl << endl;
+    return retrn;
+}
 
-    /* RANDOM TESTS */
-    vector<unsigned int> verSizes = {5, 10, 20, 50, 100, 200, 500};
-    vector<double> dens = {0.1, 0.2, 0.5};
+/**
+ * @brief uruchom test wielowątkowego silnika bt
+ *
+ * Na kilku turniejach regularnych \ref ParallelIsoSolver musi znaleźć
+ * izomorfizm, a zwrócone przekształcenie musi być poprawne. Liczby węzłów
+ * przeszukiwania jedno- i wielowątkowego są tylko wypisywane - zależą od
+ * szeregowania wątków.
+ *
+ * @param threads liczba wątków
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
+ */
+bool runParallelTest(unsigned int threads, unsigned int nr,
+        std::string testname)
+{
+    // (liczba wierzchołków, ziarno) jak w `r v 0.5 --family=tournament'
+    const unsigned int cases[][2] = {{51, 2}, {51, 4}, {71, 7}};
 
-    vector<unsigned int>::const_iterator vit;
-    vector<double>::const_iterator dit;
+    printTestHeader(nr, testname);
+    try {
+        unsigned long long serial = 0, parallel = 0;
+        bool retrn = true;
+        for(unsigned int c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+            RandomEngine engine(cases[c][1]);
+            Graph gX, gY;
+            generateFamilyPair(FAMILY_TOURNAMENT, cases[c][0], 0.5, true,
+                    engine, gX, gY);
+            FrozenGraph fX(gX), fY(gY);
 
-    for(dit = dens.begin(); dit != dens.end(); ++dit) {
-        for(vit = verSizes.begin(); vit != verSizes.end(); ++vit) {
-            ++allTests;
-            if (runRandomTest((*vit), (*dit), true, allTests,
-                        "Test dwóch losowych grafów izomorficznych")) {
-                ++okTests;
-            } else {
-                ++failTests;
-            }
+            IsomorphismAlgo::iso_map im;
+            SearchStats stats;
+            retrn &= isIsomorphic(fX, fY, ENGINE_BACKTRACK, SearchLimits(),
+                    im, stats, 1) == ISO_ISOMORPHIC;
+            serial += stats.nodes;
+
+            im.clear();
+            retrn &= isIsomorphic(fX, fY, ENGINE_BACKTRACK, SearchLimits(),
+                    im, stats, threads) == ISO_ISOMORPHIC &&
+                IsomorphismAlgo::verifyIsomorphism(gX, gY, im);
+            parallel += stats.nodes;
         }
+        cout << "Węzły: " << serial << " (1 wątek), " << parallel << " ("
+            << threads << " wątki)" << endl;
+        return printTestResult(retrn);
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
     }
-
-    cout << string(80, '=') << endl;
-    cout << setw(5) << allTests << " : Wykonanych testów" << endl;
-    cout << setw(2) << okTests << "/" << setw(2) << allTests << " : Poprawnych testów" << endl;
-    cout << setw(2) << failTests << "/" << setw(2) << allTests << " : Błędnych testów" << endl;
+    return printTestResult(false);
 }
 
 /**
- * @brief uruchom program na grafach zapisanych w plikach
+ * @brief uruchom test certyfikatów kanonicznych na grafach z plików
+ *
+ * Skróty certyfikatów \ref CanonicalForm muszą być równe dla grafów
+ * izomorficznych i różne dla nieizomorficznych.
  *
  * @param filenameX plik z grafem 1
  * @param filenameY plik z grafem 2
+ * @param izom czy grafy są izomorficzne
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
  */
-void executeFromFiles(std::string filenameX, std::string filenameY)
+bool runCanonicalTest(std::string filenameX, std::string filenameY,
+        bool izom, unsigned int nr, std::string testname)
 {
+    printTestHeader(nr, testname);
     try {
         Graph gX, gY;
-
         readGraph(gX, filenameX, "Graf X");
         readGraph(gY, filenameY, "Graf Y");
 
-        checkIsomorphism(gX, gY);
-    } catch (exception e) {
-        cout << "BŁĄD: złe dane do wczytywania grafów" << endl;
-        cout << "   " << e.what() << endl;
-        cout << endl << helpMsg();
+        CanonicalForm canonX(gX), canonY(gY);
+        canonX.canonize();
+        canonY.canonize();
+
+        cout << "Skróty certyfikatów: " << hex << canonX.getHash() << ", "
+            << canonY.getHash() << dec << endl;
+        return printTestResult(
+                (canonX.getHash() == canonY.getHash()) == izom &&
+                (canonX.getCertificate() == canonY.getCertificate()) == izom);
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
     }
+    return printTestResult(false);
 }
 
 /**
- * @brief uruchom program na losowych izomorficznych grafach
+ * @brief uruchom test zapisu grafu w formacie pliku
  *
- * @param v ilosc wierzchołków w grafach losowych
- * @param d gęstość krawędzi w grafach losowych
+ * Graf wczytany z pliku (format rozpoznawany po rozszerzeniu) zapisany
+ * w tym samym formacie musi dać dokładnie zawartość pliku.
+ *
+ * @param filename plik z grafem zapisanym przez \ref writeGraph
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
  */
-void executeRandom(unsigned int v, double d)
+bool runFormatTest(std::string filename, unsigned int nr, std::string testname)
 {
+    printTestHeader(nr, testname);
     try {
-        Graph gX = Graph::generateRandom(v, d);
-        Graph gY; gY.randomIsomorphic(gX);
+        GraphFormat format = FORMAT_NATIVE;
+        formatFromExtension(filename, format);
 
-        checkIsomorphism(gX, gY);
-    } catch (exception e) {
-        cout << "BŁĄD: złe dane do generowania grafu losowego" << endl;
-        cout << "   " << e.what() << endl;
-        cout << endl << helpMsg();
+        Graph g;
+        readGraph(g, filename, "G", 1, format);
+
+        ifstream file(filename.c_str(), ios::binary);
+        stringstream expected, written;
+        expected << file.rdbuf();
+        writeGraph(written, format, g);
+
+        cout << filename << " [format: " << formatName(format) << "]" << endl;
+        return printTestResult(written.str() == expected.str());
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
     }
+    return printTestResult(false);
 }
 
 /**
- * @brief interpretuj argumenty wywołania programu
+ * @brief uruchom test odrzucenia nagłówka zapowiadającego zbyt wiele
+ * wierzchołków
  *
- * @param argc liczba zmiennych
- * @param argv[] tablica argumentów
+ * @param text zawartość pliku
+ * @param format format pliku
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
  */
-void parseInput(int argc, const char *argv[])
+bool runHeaderTest(std::string text, GraphFormat format, unsigned int nr,
+        std::string testname)
 {
-
-    if (argc < 2) {
-        cout << "BŁĄD: zbyt mała liczba argumentów" << endl << endl;
-        cout << helpMsg();
-        exit(1);
+    printTestHeader(nr, testname);
+    try {
+        Graph g;
+        parseGraph(text.data(), text.data() + text.size(), format, g);
+    } catch (invalid_argument &e) {
+        cout << formatName(format) << ": " << e.what() << endl;
+        return printTestResult(string(e.what()).find("Linia [1]>") == 0);
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
+        return printTestResult(false);
     }
+    cout << formatName(format) << ": nagłówek przyjęty" << endl;
+    return printTestResult(false);
+}
 
-    string option(argv[1]);
-
-    if (option == "t") {
-        executeTests();
-        return;
+/**
+ * @brief czy dwa zamrożone grafy mają te same znaczniki, następniki
+ * i poprzedniki
+ *
+ * @param gA graf pierwszy
+ * @param gB graf drugi
+ *
+ * @return czy grafy są identyczne
+ */
+bool sameFrozenGraph(const FrozenGraph &gA, const FrozenGraph &gB)
+{
+    if (gA.getSize() != gB.getSize() || gA.getEdgeCount() != gB.getEdgeCount()) {
+        return false;
     }
-
-    if (option == "f") {
-        if (argc < 4) {
-            cout << "BŁĄD: zbyt mała liczba argumentów dla opcji `f'" << endl << endl;
-            cout << helpMsg();
-            exit(1);
+    for(FrozenGraph::idx_t v = 0; v < gA.getSize(); ++v) {
+        if (gA.getLabel(v) != gB.getLabel(v) ||
+                !equal(gA.adjBegin(v), gA.adjEnd(v), gB.adjBegin(v)) ||
+                gA.adjEnd(v) - gA.adjBegin(v) != gB.adjEnd(v) - gB.adjBegin(v) ||
+                !equal(gA.predBegin(v), gA.predEnd(v), gB.predBegin(v)) ||
+                gA.predEnd(v) - gA.predBegin(v) != gB.predEnd(v) - gB.predBegin(v)) {
+            return false;
         }
-        executeFromFiles(string(argv[2]), string(argv[3]));
-        return;
     }
+    return true;
+}
 
-    if (option == "r") {
-        if (argc < 4) {
-            cout << "BŁĄD: zbyt mała liczba argumentów dla opcji `r'" << endl << endl;
-            cout << helpMsg();
-            exit(1);
-        }
-        istringstream issv(argv[2]);
-        unsigned int v;
-        if (!(issv >> v)) {
-            cout << "BŁĄD: liczba wierzchołków musi być liczbą naturalną <- OPCJA `r'" << endl << endl;
-            cout << helpMsg();
-            exit(1);
-        }
-        istringstream issd(argv[3]);
-        double d;
-        if (!(issd >> d)) {
-            cout << "BŁĄD: gęstość musi być dodatnią liczbą rzeczywistą z przedziału (0, 1] <- OPCJA `r'" << endl << endl;
-            cout << helpMsg();
-            exit(1);
-        }
-        executeRandom(v, d);
-        return;
+/**
+ * @brief czy wczytanie uszkodzonego pliku binarnego zostanie odrzucone
+ *
+ * @param data zawartość pliku
+ * @param what opis uszkodzenia
+ *
+ * @return czy \ref FrozenGraph::loadBinary rzucił wyjątek
+ */
+bool rejectsBinary(std::vector<char> data, std::string what)
+{
+    try {
+        FrozenGraph g;
+        g.loadBinary(std::move(data));
+    } catch (exception &e) {
+        cout << what << ": " << e.what() << endl;
+        return true;
     }
-
-    cout << "BŁĄD: nieznana opcja  `"<< option <<"'" << endl << endl;
-    cout << helpMsg();
-    exit(1);
+    cout << what << ": plik przyjęty" << endl;
+    return false;
 }
 
-void plotPoints(unsigned start, unsigned stop, unsigned step, double density)
+/**
+ * @brief uruchom test formatu binarnego
+ *
+ * Graf z pliku zapisany przez \ref FrozenGraph::saveBinary i wczytany
+ * z powrotem musi być identyczny, a plik obcięty, z poprzednikami,
+ * które nie są transpozycją następników, lub z przesunięciem CSR za
+ * końcem listy sąsiadów - odrzucony.
+ *
+ * @param filename plik z grafem tekstowym
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
+ */
+bool runBinaryTest(std::string filename, unsigned int nr, std::string testname)
 {
-    using std::cout;
-    using std::endl;
+    printTestHeader(nr, testname);
+    cout << filename << endl;
+
+    char binname[] = "/tmp/izomorf_XXXXXX";
+    int fd = mkstemp(binname);
+    if (fd < 0) {
+        cout << "BŁĄD: nie udało się utworzyć pliku tymczasowego" << endl;
+        return printTestResult(false);
+    }
+    close(fd);
 
-    using std::chrono::high_resolution_clock;
-    using std::chrono::duration;
+    bool retrn = false;
+    try {
+        Graph g;
+        readGraph(g, filename, "G");
+        FrozenGraph saved(g), loaded;
+        saved.saveBinary(binname);
+        loaded.loadBinary(string(binname));
+        retrn = FrozenGraph::isBinaryFile(binname) &&
+            sameFrozenGraph(saved, loaded);
+
+        ifstream file(binname, ios::binary);
+        vector<char> data((istreambuf_iterator<char>(file)),
+                istreambuf_iterator<char>());
+
+        vector<char> truncated(data.begin(), data.end() - sizeof(uint32_t));
+        retrn &= rejectsBinary(truncated, "obcięty plik");
+
+        // ostatni poprzednik ostatniego wierzchołka zastąpiony innym
+        vector<char> transposed(data);
+        uint32_t last;
+        memcpy(&last, &transposed[transposed.size() - sizeof(last)], sizeof(last));
+        last = (last + 1) % saved.getSize();
+        memcpy(&transposed[transposed.size() - sizeof(last)], &last, sizeof(last));
+        retrn &= rejectsBinary(transposed, "poprzedniki różne od następników");
+
+        // gwiazda: poprzedniki ostatniego wierzchołka rosną aż do końca
+        // pliku, więc wiersz poprzedników wierzchołka 0 przedłużony za m
+        // czytałby poza danymi, gdyby przesunięcia nie były sprawdzone
+        // przed listą sąsiadów
+        string star = "1 5\n2 5\n3 5\n4 5\n";
+        Graph gStar;
+        parseGraph(star.data(), star.data() + star.size(), FORMAT_EDGE_LIST,
+                gStar);
+        FrozenGraph(gStar).saveBinary(binname);
+        ifstream starFile(binname, ios::binary);
+        vector<char> overrun((istreambuf_iterator<char>(starFile)),
+                istreambuf_iterator<char>());
+        size_t n = gStar.getVertexCount(), m = gStar.getEdgeCount();
+        size_t in_offsets = overrun.size() - sizeof(uint32_t) * (n + 1 + m);
+        uint32_t beyond = m + 1000;
+        memcpy(&overrun[in_offsets + sizeof(beyond)], &beyond, sizeof(beyond));
+        retrn &= rejectsBinary(overrun, "przesunięcie za końcem sąsiadów");
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
+        retrn = false;
+    }
+    unlink(binname);
+    return printTestResult(retrn);
+}
+
+/**
+ * @brief tekst grafu-ścieżki w formacie natywnym, z komentarzami i pustymi
+ * wierszami, na tyle długi, by \ref GraphParser::parseParallel podzielił
+ * go na kilka fragmentów
+ *
+ * @param broken etykieta wierzchołka, którego wiersz nie ma `:' (0 - brak)
+ * @param broken_line wynik - numer niepustego wiersza z błędem
+ *
+ * @return tekst grafu
+ */
+std::string parserTestText(unsigned int broken, unsigned int &broken_line)
+{
+    const unsigned int n = 40000;
+
+    stringstream ss;
+    unsigned int lines = 0;
+    for(unsigned int v = 1; v <= n; ++v) {
+        if (v % 10 == 0) {
+            // nie liczą się do numeru wiersza w komunikacie
+            ss << "# wierzchołek " << v << endl << endl;
+        }
+        ++lines;
+        if (v == broken) {
+            broken_line = lines;
+            ss << v << " " << v + 1 << endl;
+        } else if (v < n) {
+            ss << v << ": " << v + 1 << endl;
+        } else {
+            ss << v << ":" << endl;
+        }
+    }
+    return ss.str();
+}
+
+/**
+ * @brief uruchom test wielowątkowego parsera formatu natywnego
+ *
+ * Plik z testów i długi tekst wczytane na kilku wątkach muszą dać ten
+ * sam graf co parser jednowątkowy, a błąd we fragmencie innym niż pierwszy
+ * - ten sam komunikat z numerem wiersza liczonym od początku pliku.
+ *
+ * @param filename plik z grafem tekstowym
+ * @param threads liczba wątków parsera
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
+ */
+bool runParserTest(std::string filename, unsigned int threads,
+        unsigned int nr, std::string testname)
+{
+    printTestHeader(nr, testname);
+    try {
+        Graph serial, parallel;
+        serial.loadFromFile(filename, 1);
+        parallel.loadFromFile(filename, threads);
+        bool retrn = sameFrozenGraph(FrozenGraph(serial),
+                FrozenGraph(parallel));
+
+        unsigned int line = 0;
+        string text = parserTestText(0, line);
+        std::istringstream input(text);
+        Graph gS, gP;
+        GraphParser().parse(input, gS);
+        GraphParser::parseParallel(text.data(), text.data() + text.size(),
+                threads, gP);
+        retrn &= gS.getSize() > 0 &&
+            sameFrozenGraph(FrozenGraph(gS), FrozenGraph(gP));
+
+        // błąd w trzeciej ćwiartce tekstu - poza pierwszym fragmentem
+        text = parserTestText(30000, line);
+        stringstream expected;
+        expected << "Linia [" << line << "]> Brak znaku `:'";
+        string message;
+        try {
+            Graph g;
+            GraphParser::parseParallel(text.data(), text.data() + text.size(),
+                    threads, g);
+        } catch (invalid_argument &e) {
+            message = e.what();
+        }
+        cout << "Błąd: " << message << endl;
+        retrn &= (message == expected.str());
+
+        return printTestResult(retrn);
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
+    }
+    return printTestResult(false);
+}
+
+/**
+ * @brief obsłuż skrypt żądań przez \ref IsoServer::serve na potokach
+ *
+ * Żądania i odpowiedzi mieszczą się w buforach potoków, więc cały skrypt
+ * jest zapisywany przed obsługą, a odpowiedzi czytane po niej.
+ *
+ * @param server serwer
+ * @param requests treść żądań
+ * @param responses wynik - wiersze odpowiedzi
+ *
+ * @return czy udało się utworzyć potoki i przesłać dane
+ */
+bool serveScript(IsoServer &server, const std::string &requests,
+        std::vector<std::string> &responses)
+{
+    int input[2], output[2];
+    if (pipe(input) != 0) {
+        return false;
+    }
+    if (pipe(output) != 0) {
+        close(input[0]);
+        close(input[1]);
+        return false;
+    }
+
+    bool sent = write(input[1], requests.data(), requests.size()) ==
+        (ssize_t) requests.size();
+    close(input[1]);
+    if (sent) {
+        server.serve(input[0], output[1]);
+    }
+    close(input[0]);
+    close(output[1]);
+
+    string received;
+    char chunk[4096];
+    ssize_t count;
+    while ((count = read(output[0], chunk, sizeof(chunk))) > 0) {
+        received.append(chunk, count);
+    }
+    close(output[0]);
+
+    responses.clear();
+    stringstream ss(received);
+    string line;
+    while (getline(ss, line)) {
+        cout << line << endl;
+        responses.push_back(line);
+    }
+    return sent;
+}
+
+/**
+ * @brief uruchom test protokołu \ref IsoServer
+ *
+ * Pierwsze połączenie: `files' z parą izomorficzną, `inline' z poprawnymi
+ * rozmiarami, `inline' z błędnym grafem X (odpowiedź z błędem, a kolejne
+ * żądanie dostaje własną odpowiedź) i `quit', po którym nic nie jest
+ * obsługiwane. Drugie połączenie: błędny nagłówek `inline' zamyka
+ * połączenie.
+ *
+ * @param filenameX plik z grafem X
+ * @param filenameY plik z grafem Y izomorficznym z X
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
+ */
+bool runServerTest(std::string filenameX, std::string filenameY,
+        unsigned int nr, std::string testname)
+{
+    printTestHeader(nr, testname);
+    try {
+        IsoServer server(ENGINE_BACKTRACK, 1, 0.0, 0, FORMAT_AUTO);
+        string files = "files " + filenameX + " " + filenameY + "\n";
+
+        stringstream script;
+        script << files;
+        // ścieżka 1 -> 2 -> 3 w dwóch numeracjach
+        script << "inline edges 8 8\n" << "1 2\n2 3\n" << "3 1\n1 2\n";
+        script << "inline edges 8 8\n" << "1 x\n2 3\n" << "3 1\n1 2\n";
+        // te same liczby wierzchołków i krawędzi, inne stopnie
+        script << "inline edges 8 8\n" << "1 2\n2 3\n" << "1 2\n1 3\n";
+        script << "quit\n" << files;
+
+        vector<string> responses;
+        bool retrn = serveScript(server, script.str(), responses) &&
+            responses.size() == 4 &&
+            responses[0].find("{\"id\":1,\"result\":\"iso\"") == 0 &&
+            responses[1].find("{\"id\":2,\"result\":\"iso\"") == 0 &&
+            responses[2].find("{\"id\":3,\"error\":\"graf X: ") == 0 &&
+            responses[3].find("{\"id\":4,\"result\":\"noniso\"") == 0;
+
+        retrn &= serveScript(server, "inline edges 8 x\n" + files, responses) &&
+            responses.size() == 1 &&
+            responses[0].find("{\"id\":1,\"error\":") == 0;
+
+        return printTestResult(retrn);
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
+    }
+    return printTestResult(false);
+}
+
+/**
+ * @brief uruchom test skompilowanego wzorca
+ *
+ * \ref IsoSolver ze wzorcem \ref CompiledPattern musi dać ten sam wynik
+ * co \ref IsomorphismAlgo na parze (X, Y), a przekształcenie musi być
+ * izomorfizmem.
+ *
+ * @param filenameX plik z grafem wzorca
+ * @param filenameY plik z grafem Y
+ * @param izom czy grafy są izomorficzne
+ * @param trace_reject czy para musi spełniać warunki wstępne i zostać
+ * odrzucona przez zapis uszczegóławiania kolorów, przed przeszukiwaniem
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
+ */
+bool runPatternTest(std::string filenameX, std::string filenameY, bool izom,
+        bool trace_reject, unsigned int nr, std::string testname)
+{
+    printTestHeader(nr, testname);
+    try {
+        Graph gX, gY;
+        readGraph(gX, filenameX, "Graf X");
+        readGraph(gY, filenameY, "Graf Y");
+        FrozenGraph fX(gX), fY(gY);
+
+        IsomorphismAlgo::iso_map im;
+        bool direct = isIsomorphic(fX, fY, ENGINE_BACKTRACK, im);
+
+        CompiledPattern pattern(fX);
+        IsoSolver solver;
+        IsoResult result = solver.solve(pattern, fY);
+
+        bool retrn = direct == izom &&
+            result == (izom ? ISO_ISOMORPHIC : ISO_NOT_ISOMORPHIC) &&
+            (!izom || IsomorphismAlgo::verifyIsomorphism(gX, gY,
+                                                         solver.getIsoMap()));
+
+        if (trace_reject) {
+            // te same 'stopnie', ale kolory Y niezgodne z zapisem wzorca
+            ColourRefinement::colouring_t coloursX(fX.getSize());
+            ColourRefinement::colouring_t coloursY(fY.getSize());
+            vector<unsigned int> invX(fX.getSize()), invY(fY.getSize());
+            for(FrozenGraph::idx_t v = 0; v < fX.getSize(); ++v) {
+                coloursX[v] = invX[v] = fX.getInvariant(v);
+            }
+            for(FrozenGraph::idx_t v = 0; v < fY.getSize(); ++v) {
+                coloursY[v] = invY[v] = fY.getInvariant(v);
+            }
+            sort(invX.begin(), invX.end());
+            sort(invY.begin(), invY.end());
+
+            ColourRefinement::Trace trace;
+            ColourRefinement::Workspace work;
+            unsigned int colour_count = 0;
+            ColourRefinement::refineTraced(fX, coloursX, trace);
+            retrn &= fX.getEdgeCount() == fY.getEdgeCount() &&
+                invX == invY &&
+                !ColourRefinement::refineByTrace(trace, fY, coloursY,
+                        colour_count, work) &&
+                solver.getStats().nodes == 0;
+        }
+
+        cout << "Kolory wzorca: " << pattern.getColourCount()
+            << ", węzły: " << solver.getStats().nodes << endl;
+        return printTestResult(retrn);
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
+    }
+    return printTestResult(false);
+}
+
+/**
+ * @brief uruchom test \ref IsoSolver na parach z plików
+ *
+ * Jeden solver weryfikuje kolejno wszystkie pary (o różnych rozmiarach),
+ * dwukrotnie, więc każda para trafia na tablice pozostawione przez
+ * poprzednią. Wynik musi być zgodny z oczekiwanym, a przekształcenie
+ * musi być izomorfizmem.
+ *
+ * @param pairs pliki grafów X i Y oraz czy grafy są izomorficzne
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
+ */
+bool runSolverTest(
+        const std::vector<std::pair<std::pair<std::string, std::string>, bool> > &pairs,
+        unsigned int nr, std::string testname)
+{
+    printTestHeader(nr, testname);
+    try {
+        vector<Graph> graphs(2 * pairs.size());
+        vector<FrozenGraph> frozen(2 * pairs.size());
+        for(size_t i = 0; i < pairs.size(); ++i) {
+            readGraph(graphs[2 * i], pairs[i].first.first, "Graf X");
+            readGraph(graphs[2 * i + 1], pairs[i].first.second, "Graf Y");
+            frozen[2 * i].freeze(graphs[2 * i]);
+            frozen[2 * i + 1].freeze(graphs[2 * i + 1]);
+        }
+
+        IsoSolver solver;
+        bool retrn = true;
+        unsigned int checks = 0;
+        for(int round = 0; round < 2; ++round) {
+            for(size_t i = 0; i < pairs.size(); ++i) {
+                bool izom = pairs[i].second;
+                bool found = solver.solve(frozen[2 * i], frozen[2 * i + 1]);
+                bool ok = found == izom && (!izom ||
+                        IsomorphismAlgo::verifyIsomorphism(graphs[2 * i],
+                            graphs[2 * i + 1], solver.getIsoMap()));
+                if (!ok) {
+                    cout << "Błędny wynik: " << pairs[i].first.first << ", "
+                        << pairs[i].first.second << endl;
+                }
+                retrn &= ok;
+                ++checks;
+            }
+        }
+        cout << "Weryfikacje: " << checks << endl;
+        return printTestResult(retrn);
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
+    }
+    return printTestResult(false);
+}
+
+/**
+ * @brief uruchom test limitu węzłów przeszukiwania
+ *
+ * Limit równy liczbie węzłów potrzebnych do znalezienia izomorfizmu
+ * musi dać wynik \ref ISO_ISOMORPHIC, limit o jeden mniejszy -
+ * \ref ISO_UNKNOWN.
+ *
+ * @param engine silnik
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test wykonał się poprawnie
+ */
+bool runNodeLimitTest(IsoEngine engine, unsigned int nr, std::string testname)
+{
+    printTestHeader(nr, testname);
+    try {
+        // para z `r 20 0.3 --seed=4'
+        RandomEngine random(4);
+        Graph gX, gY;
+        generateFamilyPair(FAMILY_RANDOM, 20, 0.3, true, random, gX, gY);
+        FrozenGraph fX(gX), fY(gY);
+
+        IsomorphismAlgo::iso_map im;
+        SearchStats stats;
+        bool retrn = isIsomorphic(fX, fY, engine, SearchLimits(), im, stats)
+            == ISO_ISOMORPHIC;
+        unsigned long long needed = stats.nodes;
+
+        SearchLimits limits;
+        limits.max_nodes = needed;
+        retrn &= isIsomorphic(fX, fY, engine, limits, im, stats)
+            == ISO_ISOMORPHIC;
+        limits.max_nodes = needed - 1;
+        retrn &= needed < 2 || isIsomorphic(fX, fY, engine, limits, im, stats)
+            == ISO_UNKNOWN;
+
+        cout << "Węzły: " << needed << " [silnik: " << engineName(engine)
+            << "]" << endl;
+        return printTestResult(retrn);
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
+    }
+    return printTestResult(false);
+}
+
+/**
+ * @brief test przerwania w czasie przygotowań: ścieżka skierowana o 20000
+ * wierzchołkach z ustawioną już flagą przerwania daje wynik nieznany przed
+ * uszczegóławianiem kolorów i bez węzłów przeszukiwania, a bez limitów -
+ * izomorfizm
+ *
+ * @param engine silnik weryfikacji
+ * @param threads liczba wątków
+ * @param nr numer testu
+ * @param testname nazwa testu
+ *
+ * @return czy test zakończył się powodzeniem
+ */
+bool runCancelTest(IsoEngine engine, unsigned int threads, unsigned int nr,
+        std::string testname)
+{
+    printTestHeader(nr, testname);
+    try {
+        const unsigned int n = 20000;
+        Graph gX;
+        for(unsigned int v = 1; v <= n; ++v) {
+            gX.addVertex(v);
+        }
+        for(unsigned int v = 1; v < n; ++v) {
+            gX.addEdge(v, v + 1);
+        }
+        RandomEngine random(12);
+        FrozenGraph fX(gX);
+        FrozenGraph fY = fX.randomIsomorphic(random);
+
+        std::atomic<bool> cancel(true);
+        SearchLimits limits;
+        limits.cancel = &cancel;
+
+        IsomorphismAlgo::iso_map im;
+        SearchStats stats;
+        bool retrn = isIsomorphic(fX, fY, engine, limits, im, stats, threads)
+            == ISO_UNKNOWN && stats.nodes == 0 &&
+            stats.refinement_seconds == 0.0;
+        retrn &= isIsomorphic(fX, fY, engine, SearchLimits(), im, stats,
+                threads) == ISO_ISOMORPHIC;
+
+        cout << "[silnik: " << engineName(engine) << ", wątki: " << threads
+            << "]" << endl;
+        return printTestResult(retrn);
+    } catch (exception &e) {
+        cout << "BŁĄD: " << e.what() << endl;
+    }
+    return printTestResult(false);
+}
+
+/**
+ * @brief uruchom testy
+ *
+ * @param options opcje programu
+ */
+void executeTests(const RunOptions &options)
+{
+    unsigned int allTests = 0;
+    unsigned int okTests = 0;
+    unsigned int failTests = 0;
+
+    /* FILE TESTS */
+    string rootTestFold = "../tests/";
+    typedef vector< pair< pair<string, string>, string >> test_t;
+    typedef map<string, test_t> testCases_t;
+
+    typedef test_t::iterator tIter;
+    typedef testCases_t::iterator tCIter;
+    testCases_t testCases;
+
+    testCases["nie_sp_war/"] =
+    {
+        make_pair(make_pair("nsp_gx_v_1.txt", "nsp_gy_v_1.txt"),
+                "NIE SPEŁNIA WARUNKÓW WSTĘPNYCH: różna ilość wierzchołków"),
+        make_pair(make_pair("nsp_gx_e_1.txt", "nsp_gy_e_1.txt"),
+                "NIE SPEŁNIA WARUNKÓW WSTĘPNYCH: różna ilość krawędzi"),
+        make_pair(make_pair("nsp_gx_rrs_1.txt", "nsp_gy_rrs_1.txt"),
+                "NIE SPEŁNIA WARUNKÓW WSTĘPNYCH: różna liczność stopni wierzchołków 1"),
+        make_pair(make_pair("nsp_gx_rrs_1.txt", "nsp_gy_rrs_1.txt"),
+                "NIE SPEŁNIA WARUNKÓW WSTĘPNYCH: różna liczność stopni wierzchołków 2"),
+    };
+    testCases["sp_war_nie_izom/"] =
+    {
+        make_pair(make_pair("swni_gx_1.txt", "swni_gy_1.txt"),
+                "SPEŁNIA WSTĘPNE, NIE JEST IZOMORFICZNY 1"),
+        make_pair(make_pair("swni_gx_2.txt", "swni_gy_2.txt"),
+                "SPEŁNIA WSTĘPNE, NIE JEST IZOMORFICZNY 2"),
+        make_pair(make_pair("swni_gx_3.txt", "swni_gy_3.txt"),
+                "SPEŁNIA WSTĘPNE, NIE JEST IZOMORFICZNY 3"),
+        make_pair(make_pair("swni_gx_4.metis", "swni_gy_4.g6"),
+                "SPEŁNIA WSTĘPNE, NIE JEST IZOMORFICZNY 4: METIS, graph6"),
+    };
+    testCases["izom/"] =
+    {
+        make_pair(make_pair("izo_gx_1.txt", "izo_gy_1.txt"),
+                "IZOMORFICZNY 1"),
+        make_pair(make_pair("izo_gx_2.txt", "izo_gy_2.txt"),
+                "IZOMORFICZNY 2"),
+        make_pair(make_pair("izo_gx_3.txt", "izo_gy_3.txt"),
+                "IZOMORFICZNY 3"),
+    };
+    testCases["formaty/"] =
+    {
+        make_pair(make_pair("fmt_gx_1.txt", "fmt_gy_1.g6"),
+                "FORMATY: graph6 (graf Petersena)"),
+        make_pair(make_pair("fmt_gx_2.txt", "fmt_gy_2.d6"),
+                "FORMATY: digraph6"),
+        make_pair(make_pair("fmt_gx_3.edges", "fmt_gy_3.dimacs"),
+                "FORMATY: lista krawędzi, DIMACS skierowany"),
+        make_pair(make_pair("fmt_gx_4.dimacs", "fmt_gy_4.metis"),
+                "FORMATY: DIMACS nieskierowany, METIS"),
+    };
+
+    map<string, pair<bool, bool>> testCasesFlags;
+
+    testCasesFlags["nie_sp_war/"] = make_pair(false, false);
+    testCasesFlags["sp_war_nie_izom/"] = make_pair(true, false);
+    testCasesFlags["izom/"] = make_pair(true, true);
+    testCasesFlags["formaty/"] = make_pair(true, true);
+
+    for(tCIter tcit = testCases.begin();
+            tcit != testCases.end(); ++tcit) {
+        string tfold = rootTestFold + tcit->first;
+        for(tIter tit = tcit->second.begin();
+                tit != tcit->second.end(); ++tit) {
+            string fnameX = tfold + tit->first.first;
+            string fnameY = tfold + tit->first.second;
+            string testname = tit->second;
+            cout << fnameX << ", " << fnameY << endl;
+
+            ++allTests;
+            if (runFileTest(fnameX, fnameY, testCasesFlags[tcit->first].first,
+                        testCasesFlags[tcit->first].second, allTests,
+                        testname, options)) {
+                ++okTests;
+            } else {
+                ++failTests;
+            }
+        }
+
+    }
+
+    /* CANONICAL FORM TESTS */
+    for(tCIter tcit = testCases.begin();
+            tcit != testCases.end(); ++tcit) {
+        string tfold = rootTestFold + tcit->first;
+        for(tIter tit = tcit->second.begin();
+                tit != tcit->second.end(); ++tit) {
+            ++allTests;
+            if (runCanonicalTest(tfold + tit->first.first,
+                        tfold + tit->first.second,
+                        testCasesFlags[tcit->first].second, allTests,
+                        "CERTYFIKAT KANONICZNY: " + tit->second)) {
+                ++okTests;
+            } else {
+                ++failTests;
+            }
+        }
+    }
+
+    /* COMPILED PATTERN TESTS */
+    vector<string> patternFolders = {"izom/", "nie_sp_war/"};
+    for(vector<string>::const_iterator fit = patternFolders.begin();
+            fit != patternFolders.end(); ++fit) {
+        string tfold = rootTestFold + (*fit);
+        test_t &cases = testCases[*fit];
+        for(tIter tit = cases.begin(); tit != cases.end(); ++tit) {
+            ++allTests;
+            if (runPatternTest(tfold + tit->first.first,
+                        tfold + tit->first.second,
+                        testCasesFlags[*fit].second, false, allTests,
+                        "WZORZEC: " + tit->second)) {
+                ++okTests;
+            } else {
+                ++failTests;
+            }
+        }
+    }
+    ++allTests;
+    if (runPatternTest(rootTestFold + "sp_war_nie_izom/swni_gx_1.txt",
+                rootTestFold + "sp_war_nie_izom/swni_gy_1.txt", false, true,
+                allTests, "WZORZEC: odrzucenie przez zapis uszczegóławiania")) {
+        ++okTests;
+    } else {
+        ++failTests;
+    }
+
+    /* FORMAT WRITER TESTS */
+    vector<string> formatFiles = {
+        "formaty/fmt_gy_1.g6", "formaty/fmt_gy_2.d6", "formaty/fmt_gx_3.edges",
+        "formaty/fmt_gy_3.dimacs", "formaty/fmt_gx_4.dimacs",
+        "formaty/fmt_gy_4.metis",
+    };
+    for(vector<string>::const_iterator fit = formatFiles.begin();
+            fit != formatFiles.end(); ++fit) {
+        ++allTests;
+        if (runFormatTest(rootTestFold + (*fit), allTests,
+                    "Zapis grafu w formacie wczytanego pliku")) {
+            ++okTests;
+        } else {
+            ++failTests;
+        }
+    }
+
+    vector<pair<string, GraphFormat> > headers = {
+        make_pair("p edge 3000000000 0\n", FORMAT_DIMACS),
+        make_pair("3000000000 0\n", FORMAT_METIS),
+    };
+    for(vector<pair<string, GraphFormat> >::const_iterator hit =
+            headers.begin(); hit != headers.end(); ++hit) {
+        ++allTests;
+        if (runHeaderTest(hit->first, hit->second, allTests,
+                    "Nagłówek zapowiadający zbyt wiele wierzchołków")) {
+            ++okTests;
+        } else {
+            ++failTests;
+        }
+    }
+
+    /* SOLVER TESTS */
+    vector<pair<pair<string, string>, bool> > solverPairs;
+    for(tCIter tcit = testCases.begin();
+            tcit != testCases.end(); ++tcit) {
+        string tfold = rootTestFold + tcit->first;
+        for(tIter tit = tcit->second.begin();
+                tit != tcit->second.end(); ++tit) {
+            solverPairs.push_back(make_pair(make_pair(
+                            tfold + tit->first.first, tfold + tit->first.second),
+                        testCasesFlags[tcit->first].second));
+        }
+    }
+    ++allTests;
+    if (runSolverTest(solverPairs, allTests,
+                "Jeden IsoSolver dla wszystkich par z plików")) {
+        ++okTests;
+    } else {
+        ++failTests;
+    }
+
+    /* BINARY FORMAT TESTS */
+    ++allTests;
+    if (runBinaryTest(rootTestFold + "izom/izo_gx_2.txt", allTests,
+                "Zapis i odczyt grafu w formacie binarnym")) {
+        ++okTests;
+    } else {
+        ++failTests;
+    }
+
+    /* PARSER TESTS */
+    ++allTests;
+    if (runParserTest(rootTestFold + "izom/izo_gx_2.txt", 4, allTests,
+                "Wielowątkowy parser formatu natywnego")) {
+        ++okTests;
+    } else {
+        ++failTests;
+    }
+
+    /* SERVER TESTS */
+    ++allTests;
+    if (runServerTest(rootTestFold + "izom/izo_gx_1.txt",
+                rootTestFold + "izom/izo_gy_1.txt", allTests,
+                "Protokół trybu serwera")) {
+        ++okTests;
+    } else {
+        ++failTests;
+    }
+
+    /* RANDOM TESTS */
+    vector<unsigned int> verSizes = {5, 10, 20, 50, 100, 200, 500};
+    vector<double> dens = {0.1, 0.2, 0.5};
+
+    // test nr k używa ziarna seed + k
+    uint64_t seed = runSeed(options);
+    cout << string(80, '*') << endl;
+    cout << "TESTY LOSOWE: ziarno bazowe " << seed
+        << " (powtórzenie: t --seed=" << seed << ")" << endl;
+
+    vector<unsigned int>::const_iterator vit;
+    vector<double>::const_iterator dit;
+
+    for(dit = dens.begin(); dit != dens.end(); ++dit) {
+        for(vit = verSizes.begin(); vit != verSizes.end(); ++vit) {
+            ++allTests;
+            if (runRandomTest((*vit), (*dit), true, allTests,
+                        "Test dwóch losowych grafów izomorficznych",
+                        seed + allTests, options)) {
+                ++okTests;
+            } else {
+                ++failTests;
+            }
+        }
+    }
+
+    /* PARALLEL TESTS */
+    vector<unsigned int> threadCounts = {2, 4};
+    for(vit = threadCounts.begin(); vit != threadCounts.end(); ++vit) {
+        ++allTests;
+        if (runParallelTest((*vit), allTests,
+                    "Izomorfizm z wielowątkowego silnika bt")) {
+            ++okTests;
+        } else {
+            ++failTests;
+        }
+    }
+
+    /* SEARCH LIMIT TESTS */
+    vector<IsoEngine> engines = {ENGINE_BACKTRACK, ENGINE_VF2PP};
+    vector<IsoEngine>::const_iterator eit;
+    for(eit = engines.begin(); eit != engines.end(); ++eit) {
+        ++allTests;
+        if (runNodeLimitTest((*eit), allTests,
+                    "Limit węzłów równy liczbie węzłów przeszukiwania")) {
+            ++okTests;
+        } else {
+            ++failTests;
+        }
+    }
+
+    vector<pair<IsoEngine, unsigned int> > cancelled = {
+        make_pair(ENGINE_BACKTRACK, 1u), make_pair(ENGINE_BACKTRACK, 4u),
+        make_pair(ENGINE_VF2PP, 1u)};
+    for(size_t i = 0; i < cancelled.size(); ++i) {
+        ++allTests;
+        if (runCancelTest(cancelled[i].first, cancelled[i].second, allTests,
+                    "Przerwanie w czasie przygotowań")) {
+            ++okTests;
+        } else {
+            ++failTests;
+        }
+    }
+
+    cout << string(80, '=') << endl;
+    cout << setw(5) << allTests << " : Wykonanych testów" << endl;
+    cout << setw(2) << okTests << "/" << setw(2) << allTests << " : Poprawnych testów" << endl;
+    cout << setw(2) << failTests << "/" << setw(2) << allTests << " : Błędnych testów" << endl;
+}
+
+/**
+ * @brief uruchom program na grafach zapisanych w plikach
+ *
+ * @param filenameX plik z grafem 1
+ * @param filenameY plik z grafem 2
+ * @param options opcje programu
+ */
+void executeFromFiles(std::string filenameX, std::string filenameY,
+        const RunOptions &options)
+{
+    try {
+        FrozenGraph fX, fY;
+
+        readFrozenGraph(fX, filenameX, "Graf X", options.threads,
+                options.format);
+        readFrozenGraph(fY, filenameY, "Graf Y", options.threads,
+                options.format);
+
+        checkIsomorphism(fX, fY, options);
+    } catch (exception &e) {
+        cout << "BŁĄD: złe dane do wczytywania grafów" << endl;
+        cout << "   " << e.what() << endl;
+        cout << endl << helpMsg();
+    }
+}
+
+/**
+ * @brief przekonwertuj graf z formatu tekstowego na binarny lub, gdy
+ * rozszerzenie pliku wynikowego określa format (\ref formatFromExtension),
+ * na ten format
+ *
+ * @param input plik tekstowy z grafem
+ * @param output plik wynikowy
+ * @param options opcje programu
+ */
+void executeConvert(std::string input, std::string output,
+        const RunOptions &options)
+{
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
+    using std::chrono::duration_cast;
+
+    try {
+        high_resolution_clock::time_point start = high_resolution_clock::now();
+        Graph g;
+        readGraph(g, input, input, options.threads, options.format);
+        FrozenGraph frozen(g);
+        GraphFormat format;
+        if (formatFromExtension(output, format)) {
+            saveGraph(output, format, g);
+        }
+        else {
+            frozen.saveBinary(output);
+        }
+        high_resolution_clock::time_point end = high_resolution_clock::now();
+        duration<double> time_span = duration_cast<duration<double>>(end - start);
+
+        if (formatFromExtension(output, format)) {
+            cout << "Zapisano graf (" << formatName(format) << "): " << output << endl;
+        }
+        else {
+            cout << "Zapisano graf binarny: " << output << endl;
+        }
+        cout << "    Liczba wierzchołków: " << frozen.getVertexCount() << endl;
+        cout << "    Liczba krawędzi:     " << frozen.getEdgeCount() << endl;
+        cout << "Czas konwersji:" << endl;
+        cout << "   " << time_span.count() << " sekund" << endl;
+    } catch (exception &e) {
+        cout << "BŁĄD: nie udało się przekonwertować grafu" << endl;
+        cout << "   " << e.what() << endl;
+    }
+}
+
+/**
+ * @brief wypisz etykietowanie kanoniczne grafu z pliku
+ *
+ * @param filename plik z grafem
+ * @param options opcje programu
+ */
+void executeCanonical(std::string filename, const RunOptions &options)
+{
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
+    using std::chrono::duration_cast;
+
+    try {
+        Graph g;
+
+        readGraph(g, filename, "G", 1, options.format);
+
+        cout << "*** Etykietowanie kanoniczne grafu ***" << endl;
+        cout << string(100, '=') << endl;
+        cout << "    Liczba wierzchołków: " << g.getVertexCount() << endl;
+        cout << "    Liczba krawędzi:     " << g.getEdgeCount() << endl;
+        cout << string(100, '=') << endl;
+
+        CanonicalForm canon(g);
+        high_resolution_clock::time_point start = high_resolution_clock::now();
+        canon.canonize();
+        high_resolution_clock::time_point end = high_resolution_clock::now();
+
+        cout << canon.getInfo();
+        cout << "Skrót certyfikatu: " << hex << canon.getHash() << dec << endl;
+        cout << string(100, '=') << endl;
+        duration<double> time_span = duration_cast<duration<double>>(end - start);
+        cout << "Czas obliczeń:" << endl;
+        cout << "   " << time_span.count() << " sekund" << endl;
+    } catch (exception &e) {
+        cout << "BŁĄD: złe dane do wczytywania grafu" << endl;
+        cout << "   " << e.what() << endl;
+        cout << endl << helpMsg();
+    }
+}
+
+/**
+ * @brief wyznacz listę plików z grafami dla trybu wsadowego
+ *
+ * Dla katalogu są to wszystkie zwykłe pliki w nim (bez ukrytych),
+ * posortowane po nazwie; dla pliku - ścieżki w nim wymienione.
+ *
+ * @param path katalog lub plik z listą grafów
+ * @param files lista plików
+ *
+ * @return czy udało się odczytać katalog lub plik
+ */
+bool listGraphFiles(const std::string &path, std::vector<std::string> &files)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+
+    files.clear();
+    if (S_ISDIR(st.st_mode)) {
+        DIR *dir = opendir(path.c_str());
+        if (dir == NULL) {
+            return false;
+        }
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            string name(entry->d_name);
+            if (name.empty() || name[0] == '.') {
+                continue;
+            }
+            string full = path + "/" + name;
+            if (stat(full.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+                files.push_back(full);
+            }
+        }
+        closedir(dir);
+        sort(files.begin(), files.end());
+        return true;
+    }
+
+    ifstream manifest(path.c_str());
+    if (!manifest.is_open()) {
+        return false;
+    }
+    string base;
+    string::size_type slash = path.rfind('/');
+    if (slash != string::npos) {
+        base = path.substr(0, slash + 1);
+    }
+    string line;
+    while (getline(manifest, line)) {
+        string::size_type b = line.find_first_not_of(" \t\r");
+        if (b == string::npos || line[b] == '#') {
+            continue;
+        }
+        string::size_type e = line.find_last_not_of(" \t\r");
+        string file = line.substr(b, e - b + 1);
+        files.push_back(file[0] == '/' ? file : base + file);
+    }
+    return true;
+}
+
+/**
+ * @brief podziel grafy z katalogu lub listy na klasy izomorfizmu
+ *
+ * @param path katalog lub plik z listą grafów
+ * @param options opcje programu
+ */
+void executeBatch(std::string path, const RunOptions &options)
+{
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
     using std::chrono::duration_cast;
 
-    vector<unsigned int> versizes;
-    vector<double> times;
+    vector<string> files;
+    if (!listGraphFiles(path, files)) {
+        cout << "BŁĄD: nie udało się odczytać `" << path << "'" << endl << endl;
+        cout << helpMsg();
+        return;
+    }
+
+    high_resolution_clock::time_point start = high_resolution_clock::now();
 
-    for(unsigned v = start; v <= stop; v += step){
+    BatchClassifier classifier(options.engine);
+    for(vector<string>::const_iterator it = files.begin();
+            it != files.end(); ++it) {
         try {
-            Graph gX = Graph::generateRandom(v, density);
-            Graph gY; gY.randomIsomorphic(gX);
+            Graph g;
+            loadGraph(*it, options.format, g);
+            classifier.addGraph(*it, g);
+        } catch (exception &e) {
+            cout << "Nie udało się wczytać grafu " << *it << endl
+                << "   " << e.what() << endl;
+        }
+    }
+    classifier.classify();
+
+    high_resolution_clock::time_point end = high_resolution_clock::now();
 
-            IsomorphismAlgo isoalg(gX, gY);
+    const vector<BatchClassifier::iso_class_t> &classes = classifier.getClasses();
 
-            duration<double> time_span;
-            high_resolution_clock::time_point start = high_resolution_clock::now();
-            isoalg.isIsomorphism();
-            high_resolution_clock::time_point end = high_resolution_clock::now();
-            time_span = duration_cast<duration<double>>(end - start);
-            versizes.push_back(v);
-            times.push_back(time_span.count());
-        } catch (exception e) {
-            cout << "BŁĄD: złe dane do generowania grafu losowego" << endl;
-            cout << "TEST: FAIL" << cout;
+    cout << "*** Klasy izomorfizmu grafów ***" << endl;
+    cout << string(100, '=') << endl;
+    cout << "    Liczba grafów:    " << classifier.getGraphCount() << endl;
+    cout << "    Liczba kubełków:  " << classifier.getBucketCount() << endl;
+    cout << "    Liczba porównań:  " << classifier.getComparisonCount()
+        << " [silnik: " << engineName(options.engine) << "]" << endl;
+    cout << "    Liczba klas:      " << classes.size() << endl;
+    cout << string(100, '=') << endl;
+    for(size_t c = 0; c < classes.size(); ++c) {
+        cout << "Klasa " << (c + 1) << " [" << classes[c].size() << "]:";
+        for(size_t g = 0; g < classes[c].size(); ++g) {
+            cout << " " << classifier.getName(classes[c][g]);
+        }
+        cout << endl;
+    }
+    cout << string(100, '=') << endl;
+    duration<double> time_span = duration_cast<duration<double>>(end - start);
+    cout << "Czas obliczeń:" << endl;
+    cout << "   " << time_span.count() << " sekund" << endl;
+}
+
+/**
+ * @brief porównaj graf wzorca z każdym z grafów z katalogu lub listy
+ *
+ * @param pattern_file plik z grafem wzorca
+ * @param path katalog lub plik z listą grafów
+ * @param options opcje programu
+ */
+void executeMatch(std::string pattern_file, std::string path,
+        const RunOptions &options)
+{
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
+    using std::chrono::duration_cast;
+
+    vector<string> files;
+    if (!listGraphFiles(path, files)) {
+        cout << "BŁĄD: nie udało się odczytać `" << path << "'" << endl << endl;
+        cout << helpMsg();
+        return;
+    }
+
+    FrozenGraph pattern_graph;
+    try {
+        readFrozenGraph(pattern_graph, pattern_file, "wzorca", options.threads,
+                options.format);
+    } catch (exception &) {
+        // komunikat wypisał readFrozenGraph
+        return;
+    }
+
+    vector<FrozenGraph> graphs;
+    vector<string> names;
+    graphs.reserve(files.size());
+    for(vector<string>::const_iterator it = files.begin();
+            it != files.end(); ++it) {
+        try {
+            FrozenGraph g;
+            readFrozenGraph(g, *it, *it, 1, options.format);
+            graphs.push_back(std::move(g));
+            names.push_back(*it);
+        } catch (exception &) {
+            // graf pominięty, komunikat wypisał readFrozenGraph
+        }
+    }
+
+    high_resolution_clock::time_point start = high_resolution_clock::now();
+
+    CompiledPattern pattern(pattern_graph);
+
+    vector<const FrozenGraph *> targets(graphs.size());
+    for(size_t g = 0; g < graphs.size(); ++g) {
+        targets[g] = &graphs[g];
+    }
+
+    SearchLimits limits;
+    if (options.timeout > 0.0) {
+        limits.setTimeout(options.timeout);
+    }
+    limits.max_nodes = options.max_nodes;
+    limits.cancel = &interrupted;
+
+    vector<IsoResult> results;
+    pattern.matchAll(targets, results, options.threads, limits);
+
+    high_resolution_clock::time_point end = high_resolution_clock::now();
+
+    unsigned int counts[3] = {0, 0, 0};
+    cout << "*** Porównanie ze wzorcem " << pattern_file << " ***" << endl;
+    cout << string(100, '=') << endl;
+    for(size_t g = 0; g < results.size(); ++g) {
+        ++counts[results[g]];
+        cout << (results[g] == ISO_ISOMORPHIC ? "TAK " :
+                results[g] == ISO_NOT_ISOMORPHIC ? "NIE " : "?   ")
+            << names[g] << endl;
+    }
+    cout << string(100, '=') << endl;
+    cout << "    Liczba grafów:          " << results.size() << endl;
+    cout << "    Izomorficzne:           " << counts[ISO_ISOMORPHIC] << endl;
+    cout << "    Nieizomorficzne:        " << counts[ISO_NOT_ISOMORPHIC] << endl;
+    cout << "    Nierozstrzygnięte:      " << counts[ISO_UNKNOWN] << endl;
+    cout << string(100, '=') << endl;
+    duration<double> time_span = duration_cast<duration<double>>(end - start);
+    cout << "Czas obliczeń:" << endl;
+    cout << "   " << time_span.count() << " sekund" << endl;
+}
+
+/**
+ * @brief uruchom program na losowej parze grafów z rodziny
+ * \ref RunOptions::family (domyślnie izomorficznych grafach losowych)
+ *
+ * @param v ilosc wierzchołków w grafach losowych
+ * @param d gęstość krawędzi w grafach losowych
+ * @param options opcje programu
+ */
+void executeRandom(unsigned int v, double d, const RunOptions &options)
+{
+    try {
+        uint64_t seed = runSeed(options);
+        cout << "Ziarno: " << seed << " (powtórzenie: --seed=" << seed << ")"
+            << endl;
+
+        RandomEngine engine(seed);
+        Graph gX, gY;
+        if (!generateFamilyPair(options.family, v, d, !options.noniso, engine,
+                    gX, gY)) {
+            cout << "BŁĄD: nie udało się wygenerować pary nieizomorficznej "
+                "z rodziny `" << familyName(options.family) << "'" << endl;
+            return;
+        }
+
+        checkIsomorphism(FrozenGraph(gX), FrozenGraph(gY), options);
+    } catch (exception e) {
+        cout << "BŁĄD: złe dane do generowania grafu losowego" << endl;
+        cout << "   " << e.what() << endl;
+        cout << endl << helpMsg();
+    }
+}
+
+/**
+ * @brief tryb serwera: obsługuj żądania ze standardowego wejścia lub gniazda
+ *
+ * @param socket_path ścieżka gniazda domeny Unix (pusta - standardowe
+ * wejście i wyjście)
+ * @param options opcje programu
+ */
+void executeServer(std::string socket_path, const RunOptions &options)
+{
+    // serwer kończy się sygnałem, a nie przerwaniem pojedynczej weryfikacji
+    std::signal(SIGINT, SIG_DFL);
+
+    IsoServer server(options.engine, options.threads, options.timeout,
+            options.max_nodes, options.format);
+    if (socket_path.empty()) {
+        server.serve(STDIN_FILENO, STDOUT_FILENO);
+        return;
+    }
+
+    try {
+        server.serveSocket(socket_path);
+    } catch (exception &e) {
+        cerr << "BŁĄD: " << e.what() << endl;
+        exit(1);
+    }
+}
+
+/**
+ * @brief interpretuj flagę postaci `--nazwa=wartość'
+ *
+ * @param flag flaga z linii poleceń
+ * @param options opcje uzupełniane na podstawie flagi
+ */
+void parseFlag(const std::string &flag, RunOptions &options)
+{
+    string::size_type eq = flag.find('=');
+    string name = flag.substr(2, eq == string::npos ? string::npos : eq - 2);
+    string value = (eq == string::npos) ? string() : flag.substr(eq + 1);
+
+    if (name == "threads") {
+        istringstream iss(value);
+        if (!(iss >> options.threads) || !iss.eof()) {
+            cout << "BŁĄD: liczba wątków musi być liczbą naturalną <- FLAGA `--threads'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        return;
+    }
+
+    if (name == "timeout") {
+        istringstream iss(value);
+        if (!(iss >> options.timeout) || !iss.eof() || options.timeout < 0.0) {
+            cout << "BŁĄD: limit czasu musi być nieujemną liczbą <- FLAGA `--timeout'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
         }
+        return;
+    }
+
+    if (name == "max-nodes") {
+        istringstream iss(value);
+        if (value.empty() || value[0] == '-' ||
+                !(iss >> options.max_nodes) || !iss.eof()) {
+            cout << "BŁĄD: limit węzłów musi być liczbą naturalną <- FLAGA `--max-nodes'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        return;
+    }
+
+    if (name == "stats") {
+        if (eq != string::npos) {
+            cout << "BŁĄD: flaga `--stats' nie przyjmuje wartości" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        options.stats = true;
+        return;
+    }
+
+    if (name == "seed") {
+        istringstream iss(value);
+        if (value.empty() || value[0] == '-' ||
+                !(iss >> options.seed) || !iss.eof()) {
+            cout << "BŁĄD: ziarno musi być liczbą naturalną <- FLAGA `--seed'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        options.has_seed = true;
+        return;
+    }
+
+    if (name == "noniso") {
+        if (eq != string::npos) {
+            cout << "BŁĄD: flaga `--noniso' nie przyjmuje wartości" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        options.noniso = true;
+        return;
+    }
+
+    if (name == "format") {
+        if (!parseFormat(value, options.format)) {
+            cout << "BŁĄD: nieznany format `" << value << "' <- FLAGA `--format'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        return;
+    }
+
+    if (name == "family") {
+        if (!parseFamily(value, options.family)) {
+            cout << "BŁĄD: nieznana rodzina `" << value << "' <- FLAGA `--family'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        return;
+    }
+
+    if (name == "engine") {
+        if (!parseEngine(value, options.engine)) {
+            cout << "BŁĄD: nieznany silnik `" << value << "' <- FLAGA `--engine'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        return;
+    }
+
+    cout << "BŁĄD: nieznana flaga  `"<< flag <<"'" << endl << endl;
+    cout << helpMsg();
+    exit(1);
+}
+
+/**
+ * @brief interpretuj argumenty wywołania programu
+ *
+ * Argumenty zaczynające się od `--' są flagami i mogą wystąpić w dowolnym
+ * miejscu, pozostałe to opcja i jej wartości.
+ *
+ * @param argc liczba zmiennych
+ * @param argv[] tablica argumentów
+ */
+void parseInput(int argc, const char *argv[])
+{
+    RunOptions options;
+    vector<string> args;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        if (arg.compare(0, 2, "--") == 0) {
+            parseFlag(arg, options);
+        }
+        else {
+            args.push_back(arg);
+        }
+    }
+
+    if (args.size() < 1) {
+        cout << "BŁĄD: zbyt mała liczba argumentów" << endl << endl;
+        cout << helpMsg();
+        exit(1);
+    }
+
+    string option(args[0]);
+
+    if (option == "t") {
+        executeTests(options);
+        return;
+    }
+
+    if (option == "f") {
+        if (args.size() < 3) {
+            cout << "BŁĄD: zbyt mała liczba argumentów dla opcji `f'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        executeFromFiles(args[1], args[2], options);
+        return;
+    }
+
+    if (option == "convert") {
+        if (args.size() < 3) {
+            cout << "BŁĄD: zbyt mała liczba argumentów dla opcji `convert'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        executeConvert(args[1], args[2], options);
+        return;
+    }
+
+    if (option == "b") {
+        if (args.size() < 2) {
+            cout << "BŁĄD: zbyt mała liczba argumentów dla opcji `b'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        executeBatch(args[1], options);
+        return;
+    }
+
+    if (option == "m") {
+        if (args.size() < 3) {
+            cout << "BŁĄD: zbyt mała liczba argumentów dla opcji `m'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        executeMatch(args[1], args[2], options);
+        return;
+    }
+
+    if (option == "c") {
+        if (args.size() < 2) {
+            cout << "BŁĄD: zbyt mała liczba argumentów dla opcji `c'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        executeCanonical(args[1], options);
+        return;
     }
-    for(auto v : versizes) {
-        cout << v << "," << endl;
+
+    if (option == "s") {
+        executeServer(args.size() < 2 ? string() : args[1], options);
+        return;
     }
-    cout << endl << endl;
-    cout.precision(3);
-    for(auto t : times) {
-        cout << fixed << t << "," << endl;
+
+    if (option == "r") {
+        if (args.size() < 3) {
+            cout << "BŁĄD: zbyt mała liczba argumentów dla opcji `r'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        istringstream issv(args[1]);
+        unsigned int v;
+        if (!(issv >> v)) {
+            cout << "BŁĄD: liczba wierzchołków musi być liczbą naturalną <- OPCJA `r'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        istringstream issd(args[2]);
+        double d;
+        if (!(issd >> d)) {
+            cout << "BŁĄD: gęstość musi być dodatnią liczbą rzeczywistą z przedziału (0, 1] <- OPCJA `r'" << endl << endl;
+            cout << helpMsg();
+            exit(1);
+        }
+        executeRandom(v, d, options);
+        return;
     }
+
+    cout << "BŁĄD: nieznana opcja  `"<< option <<"'" << endl << endl;
+    cout << helpMsg();
+    exit(1);
 }
 
 /**
@@ -528,7 +2132,7 @@ void plotPoints(unsigned start, unsigned stop, unsigned step, double density)
  */
 int main(int argc, const char *argv[])
 {
+    std::signal(SIGINT, onInterrupt);
     parseInput(argc, argv);
-    //plotPoints(10, 1000, 10, 0.2);
     return 0;
 }
@@ -0,0 +1,53 @@
+/**
+ *      @file  mappedFile.cpp
+ *     @brief  implementacja metod klasy MappedFile
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mappedFile.hpp"
+
+MappedFile::MappedFile(const std::string &filename):
+    data(NULL), size(0)
+{
+    using std::runtime_error;
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Nie udało się otworzyć pliku do odczytu");
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw runtime_error("Nie udało się odczytać rozmiaru pliku");
+    }
+    this->size = info.st_size;
+
+    if (this->size > 0) {
+        void *addr = mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            close(fd);
+            throw runtime_error("Nie udało się odwzorować pliku w pamięć");
+        }
+        this->data = static_cast<const char *>(addr);
+    }
+    // odwzorowanie nie wymaga otwartego deskryptora
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (this->data != NULL) {
+        munmap(const_cast<char *>(this->data), this->size);
+    }
+}
@@ -0,0 +1,73 @@
+/**
+ *      @file  mappedFile.hpp
+ *     @brief  plik nagłówkowy klasy MappedFile
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy MappedFile - pliku odwzorowanego w pamięć (mmap) tylko
+ * do odczytu, z którego \ref FrozenGraph korzysta bez kopiowania
+ *
+ *=====================================================================================
+ */
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief klasa odwzorowuje cały plik w pamięć tylko do odczytu
+ *
+ * Odwzorowanie istnieje przez cały czas życia obiektu; obiektu nie można
+ * kopiować, współdzielony jest przez std::shared_ptr. Strony pliku są
+ * wczytywane przez system dopiero przy pierwszym dostępie.
+ */
+class MappedFile
+{
+    public:
+        /**
+         * @brief odwzoruj plik
+         *
+         * @param filename nazwa pliku
+         *
+         * @throw std::runtime_error gdy pliku nie da się otworzyć
+         * lub odwzorować
+         */
+        explicit MappedFile(const std::string &filename);
+
+        /**
+         * @brief usuń odwzorowanie
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /**
+         * @brief początek odwzorowanego pliku (wyrównany do strony)
+         *
+         * @return wskaźnik na pierwszy bajt, NULL dla pustego pliku
+         */
+        const char *getData() const {return this->data;};
+
+        /**
+         * @brief rozmiar pliku w bajtach
+         *
+         * @return rozmiar
+         */
+        size_t getSize() const {return this->size;};
+
+    private:
+        /**
+         * @brief początek odwzorowania
+         */
+        const char *data;
+
+        /**
+         * @brief rozmiar odwzorowania
+         */
+        size_t size;
+};
+
+#endif /* end of include guard: MAPPEDFILE_HPP */
@@ -0,0 +1,185 @@
+/**
+ *      @file  parallelSolver.cpp
+ *     @brief  implementacja metod klasy ParallelIsoSolver
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include "parallelSolver.hpp"
+
+ParallelIsoSolver::ParallelIsoSolver(
+        const FrozenGraph &_graphX,
+        const FrozenGraph &_graphY,
+        unsigned int _threads):
+    graphX(_graphX), graphY(_graphY), threads(_threads),
+    master(_graphX, _graphY), found(false), budget(NULL)
+{
+    if (this->threads == 0) {
+        this->threads = std::thread::hardware_concurrency();
+    }
+    if (this->threads == 0) {
+        this->threads = 1;
+    }
+}
+
+bool ParallelIsoSolver::isIsomorphism()
+{
+    return this->isIsomorphism(SearchLimits()) == ISO_ISOMORPHIC;
+}
+
+IsoResult ParallelIsoSolver::isIsomorphism(const SearchLimits &limits)
+{
+    using std::chrono::steady_clock;
+
+    steady_clock::time_point start = steady_clock::now();
+    this->stats = SearchStats();
+
+    SearchBudget limit(limits);
+    this->budget = &limit;
+    IsoResult result = this->solve();
+    this->budget = NULL;
+
+    this->stats.seconds = elapsedSeconds(start);
+    return result;
+}
+
+IsoResult ParallelIsoSolver::solve()
+{
+    using std::chrono::steady_clock;
+
+    this->label_map.clear();
+    this->tasks.clear();
+    this->found = false;
+
+    if (this->graphX.isEmpty() && this->graphY.isEmpty()) {
+        return ISO_ISOMORPHIC;
+    }
+
+    this->master.stats = SearchStats();
+    this->master.budget = this->budget;
+    bool prepared = this->master.prepare();
+    this->master.budget = NULL;
+    this->master.refinement.budget = NULL;
+    // czasy kroków przygotowawczych; liczniki dopisywane są później
+    this->stats = this->master.stats;
+    this->master.stats = SearchStats();
+    if (!prepared) {
+        return this->budget->isExhausted() ? ISO_UNKNOWN : ISO_NOT_ISOMORPHIC;
+    }
+
+    steady_clock::time_point search = steady_clock::now();
+    IsoResult result = this->search();
+    this->stats.match_seconds = elapsedSeconds(search);
+    return result;
+}
+
+IsoResult ParallelIsoSolver::search()
+{
+    using std::vector;
+    using std::thread;
+
+    // podział drzewa na zadania - przeszukiwanie wgłąb do zadanej liczby
+    // przyporządkowań; pusta lista zadań oznacza przeszukane całe drzewo
+    unsigned int wanted = this->threads * PARALLEL_TASKS_PER_THREAD;
+    for(unsigned int depth = 1; depth <= PARALLEL_MAX_SPLIT_DEPTH; ++depth) {
+        this->tasks.clear();
+        this->master.task_sink = &this->tasks;
+        this->master.split_depth = depth;
+        this->master.budget = this->budget;
+        bool solved = this->master.match(this->master.ordered_edges.begin(), -1);
+        this->master.flushBudget();
+        this->master.budget = NULL;
+        this->master.task_sink = NULL;
+        this->stats.merge(this->master.stats);
+        this->master.stats = SearchStats();
+
+        if (solved) {
+            // rozwiązanie znalezione przed osiągnięciem głębokości podziału
+            this->master.mapLabels();
+            this->label_map = this->master.getIsoMap();
+            return ISO_ISOMORPHIC;
+        }
+        if (this->budget->isExhausted()) {
+            return ISO_UNKNOWN;
+        }
+        if (this->tasks.empty()) {
+            return ISO_NOT_ISOMORPHIC;
+        }
+        if (this->tasks.size() >= wanted ||
+                depth >= this->graphX.getSize()) {
+            break;
+        }
+    }
+
+    vector<WorkQueue> fresh(this->threads);
+    this->queues.swap(fresh);
+    for(unsigned int t = 0; t < this->tasks.size(); ++t) {
+        this->queues[t % this->threads].items.push_back(t);
+    }
+
+    vector<thread> pool;
+    pool.reserve(this->threads);
+    for(unsigned int w = 0; w < this->threads; ++w) {
+        pool.push_back(thread(&ParallelIsoSolver::work, this, w));
+    }
+    for(unsigned int w = 0; w < this->threads; ++w) {
+        pool[w].join();
+    }
+
+    if (this->found) {
+        return ISO_ISOMORPHIC;
+    }
+    return this->budget->isExhausted() ? ISO_UNKNOWN : ISO_NOT_ISOMORPHIC;
+}
+
+bool ParallelIsoSolver::nextTask(unsigned int worker, unsigned int &task)
+{
+    using std::lock_guard;
+    using std::mutex;
+
+    {
+        WorkQueue &own = this->queues[worker];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.items.empty()) {
+            task = own.items.front();
+            own.items.pop_front();
+            return true;
+        }
+    }
+
+    for(unsigned int i = 1; i < this->threads; ++i) {
+        WorkQueue &victim = this->queues[(worker + i) % this->threads];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.items.empty()) {
+            task = victim.items.back();
+            victim.items.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ParallelIsoSolver::work(unsigned int worker)
+{
+    IsomorphismAlgo algo(this->graphX, this->graphY);
+    algo.adoptPrepared(this->master);
+    algo.cancel = &this->found;
+    algo.budget = this->budget;
+
+    unsigned int task;
+    bool success = false;
+    while (!success && !this->found.load(std::memory_order_relaxed) &&
+            !this->budget->isExhausted() && this->nextTask(worker, task)) {
+        success = algo.runTask(this->tasks[task]);
+    }
+    algo.flushBudget();
+
+    std::lock_guard<std::mutex> guard(this->result_lock);
+    this->stats.merge(algo.stats);
+    if (success && !this->found.load()) {
+        this->label_map = algo.getIsoMap();
+        this->found = true;
+    }
+}
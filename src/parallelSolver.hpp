@@ -0,0 +1,226 @@
+/**
+ *      @file  parallelSolver.hpp
+ *     @brief  plik nagłówkowy klasy ParallelIsoSolver
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy ParallelIsoSolver - wielowątkowej wersji algorytmu
+ * powrotów \ref IsomorphismAlgo
+ *
+ *=====================================================================================
+ */
+
+#ifndef PARALLELSOLVER_HPP
+#define PARALLELSOLVER_HPP
+
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "graph.hpp"
+#include "frozenGraph.hpp"
+#include "isomorphismAlgo.hpp"
+#include "searchLimits.hpp"
+
+/**
+ * @brief docelowa liczba zadań na wątek - drzewo przeszukiwania dzielone
+ * jest głębiej, dopóki zadań jest mniej
+ */
+#define PARALLEL_TASKS_PER_THREAD 8
+
+/**
+ * @brief maksymalna głębokość (liczba przyporządkowanych wierzchołków)
+ * podziału drzewa przeszukiwania na zadania
+ */
+#define PARALLEL_MAX_SPLIT_DEPTH 4
+
+/**
+ * @brief klasa weryfikuje izomorfizm algorytmem \ref IsomorphismAlgo na
+ * wielu wątkach
+ *
+ * Górne poziomy drzewa przeszukiwania (przyporządkowania pierwszych
+ * wierzchołków lasu DFS) są wyliczane w wątku głównym i zapisywane jako
+ * zadania \ref IsomorphismAlgo::SearchTask. Zadania rozdzielane są
+ * po równo do kolejek wątków; wątek bierze zadania z początku własnej
+ * kolejki, czyli w kolejności przeszukiwania jednowątkowego, a gdy ta jest
+ * pusta - podkrada z końca kolejek innych wątków.
+ *
+ * Każdy wątek ma własny obiekt \ref IsomorphismAlgo (własne f_map, zbiór S
+ * i liczniki), współdzielone są tylko zamrożone grafy i wyniki kroków
+ * przygotowawczych. Pierwszy wątek, który znajdzie izomorfizm, ustawia flagę
+ * przerwania sprawdzaną przez pozostałe przy każdym kroku przeszukiwania.
+ */
+class ParallelIsoSolver
+{
+    public:
+        /**
+         * @brief konstruktor biorący referencje na dwa zamrożone grafy
+         *
+         * Grafy nie są kopiowane, muszą istnieć przez cały czas życia
+         * obiektu.
+         *
+         * @param _graphX zamrożony graf X
+         * @param _graphY zamrożony graf Y
+         * @param _threads liczba wątków (0 - liczba rdzeni)
+         */
+        ParallelIsoSolver(const FrozenGraph &_graphX, const FrozenGraph &_graphY,
+                unsigned int _threads);
+
+        /**
+         * @brief funkcja weryfikująca izomorfizm grafów podanych w
+         * konstruktorze
+         *
+         * @return czy grafy są izomorficzne
+         */
+        bool isIsomorphism();
+
+        /**
+         * @brief funkcja weryfikująca izomorfizm z limitami przeszukiwania
+         *
+         * Budżet jest wspólny dla wszystkich wątków (także dla podziału
+         * na zadania).
+         *
+         * @param limits limity przeszukiwania
+         *
+         * @return wynik weryfikacji
+         */
+        IsoResult isIsomorphism(const SearchLimits &limits);
+
+        /**
+         * @brief statystyki ostatniej weryfikacji (suma po wątkach)
+         *
+         * @return referencja na statystyki
+         */
+        const SearchStats &getStats() const {return this->stats;};
+
+        /**
+         * @brief zwraca referencję na przekształcenie izomorficzne, otrzymane
+         * przy weryfikacji izomorfizmu.
+         *
+         * @return referencja na mapę znaczników grafu X na graf Y
+         */
+        const IsomorphismAlgo::iso_map &getIsoMap() const {return this->label_map;};
+
+        /**
+         * @brief liczba zadań, na które podzielono przeszukiwanie
+         *
+         * @return liczba zadań
+         */
+        unsigned int getTaskCount() const {return this->tasks.size();};
+
+        /**
+         * @brief liczba użytych wątków
+         *
+         * @return liczba wątków
+         */
+        unsigned int getThreadCount() const {return this->threads;};
+
+    private:
+        /**
+         * @brief kolejka zadań jednego wątku (numery zadań)
+         */
+        struct WorkQueue
+        {
+            /**
+             * @brief numery zadań
+             */
+            std::deque<unsigned int> items;
+
+            /**
+             * @brief ochrona kolejki przed podkradaniem
+             */
+            std::mutex lock;
+        };
+
+        /**
+         * @brief graf X
+         */
+        const FrozenGraph &graphX;
+
+        /**
+         * @brief graf Y
+         */
+        const FrozenGraph &graphY;
+
+        /**
+         * @brief liczba wątków
+         */
+        unsigned int threads;
+
+        /**
+         * @brief obiekt wykonujący kroki przygotowawcze i podział na zadania
+         */
+        IsomorphismAlgo master;
+
+        /**
+         * @brief zadania
+         */
+        std::vector<IsomorphismAlgo::SearchTask> tasks;
+
+        /**
+         * @brief kolejki zadań wątków
+         */
+        std::vector<WorkQueue> queues;
+
+        /**
+         * @brief flaga ustawiana przez pierwszy wątek, który znalazł
+         * izomorfizm
+         */
+        std::atomic<bool> found;
+
+        /**
+         * @brief przekształcenie izomorficzne w znacznikach
+         */
+        IsomorphismAlgo::iso_map label_map;
+
+        /**
+         * @brief ochrona \ref ParallelIsoSolver::label_map
+         * i \ref ParallelIsoSolver::stats
+         */
+        std::mutex result_lock;
+
+        /**
+         * @brief wspólny budżet przeszukiwania bieżącej weryfikacji
+         */
+        SearchBudget *budget;
+
+        /**
+         * @brief statystyki przeszukiwania
+         */
+        SearchStats stats;
+
+        /**
+         * @brief właściwa weryfikacja: kroki przygotowawcze i przeszukiwanie
+         *
+         * @return wynik weryfikacji
+         */
+        IsoResult solve();
+
+        /**
+         * @brief przeszukiwanie: podział na zadania i wątki
+         *
+         * @return wynik weryfikacji
+         */
+        IsoResult search();
+
+        /**
+         * @brief pobierz kolejne zadanie dla wątku
+         *
+         * @param worker numer wątku
+         * @param task numer pobranego zadania
+         *
+         * @return czy pobrano zadanie
+         */
+        bool nextTask(unsigned int worker, unsigned int &task);
+
+        /**
+         * @brief pętla wątku roboczego
+         *
+         * @param worker numer wątku
+         */
+        void work(unsigned int worker);
+};
+
+#endif /* end of include guard: PARALLELSOLVER_HPP */
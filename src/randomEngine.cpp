@@ -0,0 +1,35 @@
+/**
+ *      @file  randomEngine.cpp
+ *     @brief  implementacja metod klasy RandomEngine
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <chrono>
+
+#include "randomEngine.hpp"
+
+RandomEngine::RandomEngine(uint64_t _seed)
+{
+    this->seed(_seed);
+}
+
+void RandomEngine::seed(uint64_t _seed)
+{
+    // splitmix64 - stan xoshiro nie może być zerowy, a bliskie ziarna
+    // mają dawać niezależne ciągi
+    uint64_t x = _seed;
+    for(int i = 0; i < 4; ++i) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        this->state[i] = z ^ (z >> 31);
+    }
+}
+
+uint64_t RandomEngine::clockSeed()
+{
+    return std::chrono::high_resolution_clock::now().time_since_epoch().count();
+}
@@ -0,0 +1,105 @@
+/**
+ *      @file  randomEngine.hpp
+ *     @brief  plik nagłówkowy klasy RandomEngine
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy RandomEngine - szybkiego generatora liczb losowych
+ * z jawnym ziarnem, używanego przez generatory grafów
+ *
+ *=====================================================================================
+ */
+
+#ifndef RANDOMENGINE_HPP
+#define RANDOMENGINE_HPP
+
+#include <stdint.h>
+
+/**
+ * @brief generator xoshiro256** z ziarnem rozwijanym przez splitmix64
+ *
+ * Spełnia wymagania UniformRandomBitGenerator, więc może być użyty
+ * z rozkładami z nagłówka random i z std::shuffle. To samo ziarno daje
+ * ten sam ciąg liczb na każdej platformie (w przeciwieństwie do
+ * std::default_random_engine).
+ */
+class RandomEngine
+{
+    public:
+        /**
+         * @brief typ generowanych liczb
+         */
+        typedef uint64_t result_type;
+
+        /**
+         * @brief konstruktor
+         *
+         * @param _seed ziarno
+         */
+        explicit RandomEngine(uint64_t _seed = 0);
+
+        /**
+         * @brief ustaw ziarno, generator zaczyna ciąg od nowa
+         *
+         * @param _seed ziarno
+         */
+        void seed(uint64_t _seed);
+
+        /**
+         * @brief ziarno z zegara - dla wywołań bez jawnego ziarna
+         *
+         * @return ziarno
+         */
+        static uint64_t clockSeed();
+
+        /**
+         * @brief najmniejsza generowana liczba
+         */
+        static constexpr result_type min() {return 0;};
+
+        /**
+         * @brief największa generowana liczba
+         */
+        static constexpr result_type max() {return ~(result_type) 0;};
+
+        /**
+         * @brief kolejna liczba losowa
+         *
+         * @return liczba z przedziału [min(), max()]
+         */
+        result_type operator()()
+        {
+            const uint64_t result = rotl(this->state[1] * 5, 7) * 9;
+            const uint64_t t = this->state[1] << 17;
+
+            this->state[2] ^= this->state[0];
+            this->state[3] ^= this->state[1];
+            this->state[1] ^= this->state[2];
+            this->state[0] ^= this->state[3];
+            this->state[2] ^= t;
+            this->state[3] = rotl(this->state[3], 45);
+
+            return result;
+        };
+
+    private:
+        /**
+         * @brief stan generatora
+         */
+        uint64_t state[4];
+
+        /**
+         * @brief obrót bitowy w lewo
+         *
+         * @param x liczba
+         * @param k liczba bitów
+         *
+         * @return x obrócone o k bitów
+         */
+        static uint64_t rotl(uint64_t x, int k)
+        {
+            return (x << k) | (x >> (64 - k));
+        };
+};
+
+#endif /* end of include guard: RANDOMENGINE_HPP */
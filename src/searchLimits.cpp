@@ -0,0 +1,99 @@
+/**
+ *      @file  searchLimits.cpp
+ *     @brief  implementacja limitów przeszukiwania
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include <sstream>
+
+#include "searchLimits.hpp"
+
+void SearchLimits::setTimeout(double seconds)
+{
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+    using std::chrono::duration_cast;
+
+    this->has_deadline = true;
+    this->deadline = steady_clock::now() +
+        duration_cast<steady_clock::duration>(duration<double>(seconds));
+}
+
+SearchBudget::SearchBudget(const SearchLimits &_limits):
+    limits(_limits), nodes(0), exhausted(false), interval(BUDGET_CHECK_INTERVAL)
+{
+    // mały limit węzłów zmniejsza odstęp sprawdzeń w consume
+    this->consume(0);
+}
+
+bool SearchBudget::consume(unsigned long long count)
+{
+    unsigned long long total = this->nodes.fetch_add(count) + count;
+
+    if (this->limits.max_nodes > 0) {
+        if (total >= this->limits.max_nodes) {
+            this->exhausted = true;
+        } else if (this->limits.max_nodes - total < this->interval) {
+            // kolejne rozliczenie dokładnie na granicy limitu
+            this->interval = this->limits.max_nodes - total;
+        }
+    }
+    if (this->limits.cancel != NULL &&
+            this->limits.cancel->load(std::memory_order_relaxed)) {
+        this->exhausted = true;
+    }
+    if (this->limits.has_deadline &&
+            std::chrono::steady_clock::now() >= this->limits.deadline) {
+        this->exhausted = true;
+    }
+    return !this->isExhausted();
+}
+
+void SearchStats::merge(const SearchStats &other)
+{
+    this->nodes += other.nodes;
+    this->rejected_invariant += other.rejected_invariant;
+    this->rejected_edges_count += other.rejected_edges_count;
+    this->connection_calls += other.connection_calls;
+
+    if (other.backtracks.size() > this->backtracks.size()) {
+        this->backtracks.resize(other.backtracks.size(), 0);
+    }
+    for(size_t d = 0; d < other.backtracks.size(); ++d) {
+        this->backtracks[d] += other.backtracks[d];
+    }
+}
+
+std::string SearchStats::getInfo() const
+{
+    using std::endl;
+    using std::stringstream;
+
+    stringstream ss;
+    ss << "Statystyki przeszukiwania:" << endl;
+    ss << "   węzły:                           " << this->nodes << endl;
+    ss << "   czas [s]:" << endl;
+    ss << "      warunki wstępne:              " << this->requirements_seconds << endl;
+    ss << "      kolory stabilne:              " << this->refinement_seconds << endl;
+    ss << "      numeracja wierzchołków:       " << this->numbering_seconds << endl;
+    ss << "      porządek przeszukiwania:      " << this->ordering_seconds << endl;
+    ss << "      przeszukiwanie:               " << this->match_seconds << endl;
+#ifdef IZOMORF_STATS
+    ss << "   odrzuceni przez kolor:           " << this->rejected_invariant << endl;
+    ss << "   odrzuceni przez edges_count_k:   " << this->rejected_edges_count << endl;
+    ss << "   wywołania isConnection:          " << this->connection_calls << endl;
+    ss << "   nawroty (głębokość: liczba):" << endl;
+    for(size_t d = 0; d < this->backtracks.size(); ++d) {
+        if (this->backtracks[d] > 0) {
+            ss << "      " << d << ": " << this->backtracks[d] << endl;
+        }
+    }
+#else
+    ss << "   liczniki wyłączone (kompilacja bez IZOMORF_STATS, `make stats')"
+        << endl;
+#endif
+    return ss.str();
+}
@@ -0,0 +1,263 @@
+/**
+ *      @file  searchLimits.hpp
+ *     @brief  limity przeszukiwania, wynik trójwartościowy i statystyki
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracje \ref IsoResult, \ref SearchLimits, \ref SearchStats
+ * i \ref SearchBudget - wspólne dla wszystkich silników weryfikacji
+ * izomorfizmu
+ *
+ * Liczniki z gorącej ścieżki przeszukiwania (nawroty, odrzuceni kandydaci,
+ * wywołania isConnection) zbierane są tylko przy zdefiniowanym
+ * IZOMORF_STATS (`make stats'); bez niego \ref SEARCH_STAT nie generuje
+ * żadnego kodu
+ *
+ *=====================================================================================
+ */
+
+#ifndef SEARCHLIMITS_HPP
+#define SEARCHLIMITS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @brief co ile węzłów przeszukiwania silnik sprawdza limity
+ * (zegar, flagę przerwania)
+ */
+#define BUDGET_CHECK_INTERVAL 256
+
+#ifdef IZOMORF_STATS
+/**
+ * @brief wykonaj instrukcję zliczającą statystyki (tylko z IZOMORF_STATS)
+ */
+#define SEARCH_STAT(stmt) do { stmt; } while (0)
+#else
+#define SEARCH_STAT(stmt) do { } while (0)
+#endif
+
+/**
+ * @brief wynik weryfikacji izomorfizmu z limitami
+ */
+enum IsoResult
+{
+    ISO_NOT_ISOMORPHIC, /**< grafy nie są izomorficzne */
+    ISO_ISOMORPHIC,     /**< grafy są izomorficzne */
+    ISO_UNKNOWN         /**< przeszukiwanie przerwane przed rozstrzygnięciem */
+};
+
+/**
+ * @brief limity przeszukiwania; domyślnie brak limitów
+ */
+struct SearchLimits
+{
+    SearchLimits(): has_deadline(false), max_nodes(0), cancel(NULL) {};
+
+    /**
+     * @brief ustaw termin na \p seconds sekund od teraz
+     *
+     * @param seconds czas w sekundach
+     */
+    void setTimeout(double seconds);
+
+    /**
+     * @brief czy ustawiono termin \ref SearchLimits::deadline
+     */
+    bool has_deadline;
+
+    /**
+     * @brief termin zakończenia przeszukiwania
+     */
+    std::chrono::steady_clock::time_point deadline;
+
+    /**
+     * @brief maksymalna liczba węzłów przeszukiwania (0 - bez limitu)
+     */
+    unsigned long long max_nodes;
+
+    /**
+     * @brief flaga przerwania ustawiana z zewnątrz (NULL - brak)
+     */
+    const std::atomic<bool> *cancel;
+};
+
+/**
+ * @brief statystyki przeszukiwania
+ */
+struct SearchStats
+{
+    SearchStats(): nodes(0), seconds(0.0), requirements_seconds(0.0),
+        refinement_seconds(0.0), numbering_seconds(0.0),
+        ordering_seconds(0.0), match_seconds(0.0), rejected_invariant(0),
+        rejected_edges_count(0), connection_calls(0) {};
+
+    /**
+     * @brief dolicz liczniki innego przeszukiwania (bez czasów)
+     *
+     * @param other statystyki np. innego wątku
+     */
+    void merge(const SearchStats &other);
+
+    /**
+     * @brief policz nawrót z węzła na głębokości \p depth
+     *
+     * @param depth liczba przyporządkowanych wierzchołków w porzucanym węźle
+     */
+    void addBacktrack(unsigned int depth)
+    {
+        if (depth >= this->backtracks.size()) {
+            this->backtracks.resize(depth + 1, 0);
+        }
+        ++this->backtracks[depth];
+    };
+
+    /**
+     * @brief raport ze statystyk do wypisania
+     *
+     * @return string z raportem
+     */
+    std::string getInfo() const;
+
+    /**
+     * @brief liczba węzłów przeszukiwania (przyporządkowań wierzchołków)
+     */
+    unsigned long long nodes;
+
+    /**
+     * @brief czas weryfikacji w sekundach
+     */
+    double seconds;
+
+    /**
+     * @brief czas sprawdzania warunków wstępnych
+     */
+    double requirements_seconds;
+
+    /**
+     * @brief czas wyznaczania kolorów stabilnych
+     */
+    double refinement_seconds;
+
+    /**
+     * @brief czas numerowania wierzchołków (las DFS)
+     */
+    double numbering_seconds;
+
+    /**
+     * @brief czas porządkowania krawędzi lub wierzchołków
+     */
+    double ordering_seconds;
+
+    /**
+     * @brief czas właściwego przeszukiwania
+     */
+    double match_seconds;
+
+    /**
+     * @brief liczba nawrotów według głębokości (IZOMORF_STATS)
+     */
+    std::vector<unsigned long long> backtracks;
+
+    /**
+     * @brief kandydaci odrzuceni przez niezmiennik - kolor stabilny
+     * lub etykietę (IZOMORF_STATS)
+     */
+    unsigned long long rejected_invariant;
+
+    /**
+     * @brief odrzucenia przez niezgodną liczbę krawędzi edges_count_k
+     * (IZOMORF_STATS)
+     */
+    unsigned long long rejected_edges_count;
+
+    /**
+     * @brief liczba wywołań FrozenGraph::isConnection (IZOMORF_STATS)
+     */
+    unsigned long long connection_calls;
+};
+
+/**
+ * @brief czas od \p start w sekundach
+ *
+ * @param start punkt początkowy
+ *
+ * @return liczba sekund
+ */
+inline double elapsedSeconds(const std::chrono::steady_clock::time_point &start)
+{
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+    using std::chrono::duration_cast;
+
+    return duration_cast<duration<double> >(steady_clock::now() - start).count();
+}
+
+/**
+ * @brief klasa rozlicza węzły przeszukiwania względem limitów
+ *
+ * Silnik zlicza węzły lokalnie i co \ref SearchBudget::getCheckInterval
+ * węzłów przekazuje je do \ref SearchBudget::consume, które sprawdza limit
+ * węzłów, termin i flagę przerwania. Licznik i znacznik wyczerpania są
+ * atomowe, więc jeden budżet może być współdzielony przez wątki.
+ */
+class SearchBudget
+{
+    public:
+        /**
+         * @brief konstruktor
+         *
+         * @param _limits limity
+         */
+        explicit SearchBudget(const SearchLimits &_limits);
+
+        /**
+         * @brief dolicz węzły i sprawdź limity
+         *
+         * @param count liczba nowych węzłów
+         *
+         * @return czy można kontynuować przeszukiwanie
+         */
+        bool consume(unsigned long long count);
+
+        /**
+         * @brief czy budżet został wyczerpany
+         *
+         * @return czy przeszukiwanie należy przerwać
+         */
+        bool isExhausted() const {return this->exhausted.load(std::memory_order_relaxed);};
+
+        /**
+         * @brief co ile węzłów wywoływać \ref SearchBudget::consume
+         *
+         * @return liczba węzłów
+         */
+        unsigned int getCheckInterval() const
+        {return this->interval.load(std::memory_order_relaxed);};
+
+    private:
+        /**
+         * @brief limity
+         */
+        const SearchLimits limits;
+
+        /**
+         * @brief liczba rozliczonych węzłów
+         */
+        std::atomic<unsigned long long> nodes;
+
+        /**
+         * @brief czy budżet został wyczerpany
+         */
+        std::atomic<bool> exhausted;
+
+        /**
+         * @brief co ile węzłów sprawdzać limity - nie więcej niż węzłów
+         * pozostałych do limitu, więc jeden wątek go nie przekroczy
+         */
+        std::atomic<unsigned int> interval;
+};
+
+#endif /* end of include guard: SEARCHLIMITS_HPP */
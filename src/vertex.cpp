@@ -26,9 +26,13 @@ idx_t Vertex::getIndex() const
 bool Vertex::addAdjacent(Vertex &adj)
 {
     using std::set;
-    if (this->adjacent.insert(adj.getIndex()).second) {
+    // podpowiedź końca zbioru - sąsiedzi dodawani rosnąco
+    // (\ref GraphBuilder) wstawiani są bez wyszukiwania
+    size_t before = this->adjacent.size();
+    this->adjacent.insert(this->adjacent.end(), adj.getIndex());
+    if (this->adjacent.size() != before) {
         this->degree.first++;
-        adj.addNeighbour();
+        adj.addNeighbour(this->index);
         return true;
     }
     return false;
@@ -48,6 +52,16 @@ Vertex::iterator Vertex::end() const
     return this->adjacent.end();
 }
 
+Vertex::iterator Vertex::predBegin() const
+{
+    return this->predecessors.begin();
+}
+
+Vertex::iterator Vertex::predEnd() const
+{
+    return this->predecessors.end();
+}
+
 unsigned int Vertex::getIn() const
 {
     return this->degree.first;
@@ -77,7 +91,8 @@ std::string Vertex::getInfo() const
 
 /* PRIVATE */
 
-void Vertex::addNeighbour()
+void Vertex::addNeighbour(idx_t pred)
 {
+    this->predecessors.insert(this->predecessors.end(), pred);
     this->degree.second++;
 }
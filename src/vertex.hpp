@@ -110,6 +110,21 @@ class Vertex
          */
         iterator end() const;
 
+        /**
+         * @brief iterator po indeksach poprzedników (wierzchołków, których
+         * listy sąsiedztwa zawierają dany wierzchołek)
+         *
+         * @return iterator na początek listy poprzedników
+         */
+        iterator predBegin() const;
+
+        /**
+         * @brief iterator po indeksach poprzedników
+         *
+         * @return iterator na koniec listy poprzedników
+         */
+        iterator predEnd() const;
+
         /**
          * @brief informacje na temat wierzchołka
          *
@@ -134,11 +149,19 @@ class Vertex
          */
         std::set<idx_t> adjacent;
 
+        /**
+         * @brief odwrotna lista sąsiedztwa wierzchołka (poprzednicy)
+         */
+        std::set<idx_t> predecessors;
+
         /**
          * @brief procedura wywoływana gdy wierzchołek jest dodawany
          * do listy sąsiedztwa innego wierzchołka
+         *
+         * @param pred indeks wierzchołka, do którego listy sąsiedztwa dodano
+         * dany wierzchołek
          */
-        void addNeighbour();
+        void addNeighbour(idx_t pred);
 };
 
 #endif /* end of include guard: VERTEX_HPP */
@@ -0,0 +1,520 @@
+/**
+ *      @file  vf2ppAlgo.cpp
+ *     @brief  implementacja metod klasy Vf2ppAlgo
+ *
+ * Detailed description starts here.
+ *
+ *=====================================================================================
+ */
+
+#include "vf2ppAlgo.hpp"
+
+typedef FrozenGraph::idx_t idx_t;
+typedef FrozenGraph::adj_iterator adj_iterator;
+
+Vf2ppAlgo::Vf2ppAlgo(
+        const Graph &_graphX,
+        const Graph &_graphY):
+    frozenX(_graphX), frozenY(_graphY),
+    graphX(frozenX), graphY(frozenY), label_count(0), budget(NULL),
+    pending_nodes(0)
+{
+
+}
+
+Vf2ppAlgo::Vf2ppAlgo(
+        const FrozenGraph &_graphX,
+        const FrozenGraph &_graphY):
+    graphX(_graphX), graphY(_graphY), label_count(0), budget(NULL),
+    pending_nodes(0)
+{
+
+}
+
+bool Vf2ppAlgo::meetsRequirements()
+{
+    if (this->graphX.isEmpty() && this->graphY.isEmpty()) {
+        return true;
+    }
+
+    if (this->graphX.getSize() != this->graphY.getSize()) {
+        return false;
+    }
+
+    if (this->graphX.getEdgeCount() != this->graphY.getEdgeCount()) {
+        return false;
+    }
+
+    return this->assignLabels();
+}
+
+bool Vf2ppAlgo::isIsomorphism()
+{
+    return this->isIsomorphism(SearchLimits()) == ISO_ISOMORPHIC;
+}
+
+IsoResult Vf2ppAlgo::isIsomorphism(const SearchLimits &limits)
+{
+    using std::chrono::steady_clock;
+
+    steady_clock::time_point start = steady_clock::now();
+    this->stats = SearchStats();
+
+    SearchBudget limit(limits);
+    this->budget = &limit;
+    this->pending_nodes = 0;
+    IsoResult result = this->solve();
+    if (this->pending_nodes > 0) {
+        limit.consume(this->pending_nodes);
+        this->pending_nodes = 0;
+    }
+    this->budget = NULL;
+
+    this->stats.seconds = elapsedSeconds(start);
+    return result;
+}
+
+IsoResult Vf2ppAlgo::solve()
+{
+    using std::chrono::steady_clock;
+
+    this->label_map.clear();
+
+    if (this->graphX.isEmpty() && this->graphY.isEmpty()) {
+        return ISO_ISOMORPHIC;
+    }
+
+    steady_clock::time_point phase = steady_clock::now();
+    bool meets = this->meetsRequirements();
+    this->stats.requirements_seconds = elapsedSeconds(phase);
+    if (!meets) {
+        return ISO_NOT_ISOMORPHIC;
+    }
+    if (!this->budget->consume(0)) {
+        return ISO_UNKNOWN;
+    }
+
+    // etykiety 'stopni' rozdrabniamy do stabilnych kolorów; limity
+    // sprawdzane są także w trakcie uszczegóławiania
+    phase = steady_clock::now();
+    ColourRefinement::Workspace refinement;
+    refinement.budget = this->budget;
+    bool refined = ColourRefinement::refineJoint(this->graphX, this->graphY,
+            this->labelX, this->labelY, this->label_count, refinement);
+    this->stats.refinement_seconds = elapsedSeconds(phase);
+    if (!refined) {
+        return this->budget->isExhausted() ? ISO_UNKNOWN : ISO_NOT_ISOMORPHIC;
+    }
+
+    unsigned int n = this->graphX.getSize();
+
+    this->coreX.assign(n, NO_VERTEX);
+    this->coreY.assign(n, NO_VERTEX);
+    this->toutX.assign(n, 0);
+    this->tinX.assign(n, 0);
+    this->toutY.assign(n, 0);
+    this->tinY.assign(n, 0);
+    this->class_count.assign(this->label_count * 8, 0);
+    this->all_y.resize(n);
+    for(idx_t y = 0; y < n; ++y) {
+        this->all_y[y] = y;
+    }
+
+    phase = steady_clock::now();
+    this->computeOrder();
+    this->stats.ordering_seconds = elapsedSeconds(phase);
+
+    if (!this->budget->consume(0)) {
+        // termin upłynął już w czasie przygotowań
+        return ISO_UNKNOWN;
+    }
+
+    phase = steady_clock::now();
+    bool found = this->match();
+    this->stats.match_seconds = elapsedSeconds(phase);
+    if (!found) {
+        return this->budget->isExhausted() ? ISO_UNKNOWN : ISO_NOT_ISOMORPHIC;
+    }
+
+    for(idx_t x = 0; x < n; ++x) {
+        this->label_map[this->graphX.getLabel(x)] =
+            this->graphY.getLabel(this->coreX[x]);
+    }
+    return ISO_ISOMORPHIC;
+}
+
+bool Vf2ppAlgo::assignLabels()
+{
+    using std::vector;
+    using std::sort;
+    using std::unique;
+    using std::lower_bound;
+
+    unsigned int n = this->graphX.getSize();
+
+    vector<unsigned int> invs;
+    invs.reserve(2 * n);
+    for(idx_t v = 0; v < n; ++v) {
+        invs.push_back(this->graphX.getInvariant(v));
+        invs.push_back(this->graphY.getInvariant(v));
+    }
+    sort(invs.begin(), invs.end());
+    invs.erase(unique(invs.begin(), invs.end()), invs.end());
+    this->label_count = invs.size();
+
+    this->labelX.resize(n);
+    this->labelY.resize(n);
+    vector<int> hist(this->label_count, 0);
+    for(idx_t v = 0; v < n; ++v) {
+        this->labelX[v] = lower_bound(invs.begin(), invs.end(),
+                this->graphX.getInvariant(v)) - invs.begin();
+        this->labelY[v] = lower_bound(invs.begin(), invs.end(),
+                this->graphY.getInvariant(v)) - invs.begin();
+        ++hist[this->labelX[v]];
+        --hist[this->labelY[v]];
+    }
+
+    for(unsigned int l = 0; l < this->label_count; ++l) {
+        if (hist[l] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Vf2ppAlgo::computeOrder()
+{
+    using std::vector;
+    using std::sort;
+    using std::swap;
+    using std::make_pair;
+    using std::pair;
+
+    const FrozenGraph &g = this->graphX;
+    unsigned int n = g.getSize();
+
+    vector<unsigned int> remaining(this->label_count, 0);
+    for(idx_t y = 0; y < n; ++y) {
+        ++remaining[this->labelY[y]];
+    }
+
+    // kandydaci na korzenie: najrzadsza etykieta, potem największy stopień
+    vector<pair<pair<unsigned int, int>, idx_t> > roots;
+    roots.reserve(n);
+    for(idx_t x = 0; x < n; ++x) {
+        roots.push_back(make_pair(make_pair(remaining[this->labelX[x]],
+                        -(int) (g.getOut(x) + g.getIn(x))), x));
+    }
+    sort(roots.begin(), roots.end());
+
+    vector<bool> visited(n, false);
+    vector<unsigned int> conn(n, 0);
+    vector<idx_t> level;
+    vector<idx_t> next;
+
+    this->order.clear();
+    this->order.reserve(n);
+
+    for(size_t r = 0; r < roots.size(); ++r) {
+        idx_t root = roots[r].second;
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = true;
+        level.assign(1, root);
+
+        while (!level.empty()) {
+            size_t levelStart = this->order.size();
+
+            while (!level.empty()) {
+                size_t best = 0;
+                for(size_t i = 1; i < level.size(); ++i) {
+                    idx_t a = level[i];
+                    idx_t b = level[best];
+                    unsigned int da = g.getOut(a) + g.getIn(a);
+                    unsigned int db = g.getOut(b) + g.getIn(b);
+                    if (conn[a] != conn[b]) {
+                        if (conn[a] > conn[b]) best = i;
+                    } else if (da != db) {
+                        if (da > db) best = i;
+                    } else if (remaining[this->labelX[a]] <
+                            remaining[this->labelX[b]]) {
+                        best = i;
+                    }
+                }
+
+                idx_t u = level[best];
+                swap(level[best], level.back());
+                level.pop_back();
+
+                this->order.push_back(u);
+                --remaining[this->labelX[u]];
+                for(adj_iterator it = g.adjBegin(u); it != g.adjEnd(u); ++it) {
+                    ++conn[*it];
+                }
+                for(adj_iterator it = g.predBegin(u); it != g.predEnd(u); ++it) {
+                    ++conn[*it];
+                }
+            }
+
+            next.clear();
+            for(size_t i = levelStart; i < this->order.size(); ++i) {
+                idx_t u = this->order[i];
+                for(adj_iterator it = g.adjBegin(u); it != g.adjEnd(u); ++it) {
+                    if (!visited[*it]) {
+                        visited[*it] = true;
+                        next.push_back(*it);
+                    }
+                }
+                for(adj_iterator it = g.predBegin(u); it != g.predEnd(u); ++it) {
+                    if (!visited[*it]) {
+                        visited[*it] = true;
+                        next.push_back(*it);
+                    }
+                }
+            }
+            level.swap(next);
+        }
+    }
+}
+
+void Vf2ppAlgo::candidates(idx_t u, const idx_t *&begin, const idx_t *&end) const
+{
+    begin = this->all_y.data();
+    end = begin + this->all_y.size();
+
+    // najkrótsza lista sąsiedztwa obrazu dopasowanego sąsiada u
+    for(adj_iterator it = this->graphX.predBegin(u);
+            it != this->graphX.predEnd(u); ++it) {
+        idx_t fp = this->coreX[*it];
+        if (fp != NO_VERTEX &&
+                (this->graphY.adjEnd(fp) - this->graphY.adjBegin(fp)) < (end - begin)) {
+            begin = this->graphY.adjBegin(fp);
+            end = this->graphY.adjEnd(fp);
+        }
+    }
+    for(adj_iterator it = this->graphX.adjBegin(u);
+            it != this->graphX.adjEnd(u); ++it) {
+        idx_t fs = this->coreX[*it];
+        if (fs != NO_VERTEX &&
+                (this->graphY.predEnd(fs) - this->graphY.predBegin(fs)) < (end - begin)) {
+            begin = this->graphY.predBegin(fs);
+            end = this->graphY.predEnd(fs);
+        }
+    }
+}
+
+bool Vf2ppAlgo::feasible(idx_t u, idx_t v)
+{
+    if (this->labelX[u] != this->labelY[v]) {
+        SEARCH_STAT(++this->stats.rejected_invariant);
+        return false;
+    }
+
+    // klucz klasy: etykieta x kierunek x T_in x T_out
+#define VF2PP_CLASS(label, dir, tin, tout) \
+    ((label) * 8 + (dir) * 4 + ((tin) > 0) * 2 + ((tout) > 0))
+
+    unsigned int mappedOutX = 0, mappedInX = 0;
+    unsigned int mappedOutY = 0, mappedInY = 0;
+    bool ok = true;
+
+    for(adj_iterator it = this->graphX.adjBegin(u);
+            ok && it != this->graphX.adjEnd(u); ++it) {
+        idx_t w = *it;
+        if (this->coreX[w] != NO_VERTEX) {
+            ++mappedOutX;
+            SEARCH_STAT(++this->stats.connection_calls);
+            ok = this->graphY.isConnection(v, this->coreX[w]);
+        } else {
+            ++this->class_count[VF2PP_CLASS(this->labelX[w], 0,
+                    this->tinX[w], this->toutX[w])];
+        }
+    }
+    for(adj_iterator it = this->graphX.predBegin(u);
+            ok && it != this->graphX.predEnd(u); ++it) {
+        idx_t w = *it;
+        if (this->coreX[w] != NO_VERTEX) {
+            ++mappedInX;
+            SEARCH_STAT(++this->stats.connection_calls);
+            ok = this->graphY.isConnection(this->coreX[w], v);
+        } else {
+            ++this->class_count[VF2PP_CLASS(this->labelX[w], 1,
+                    this->tinX[w], this->toutX[w])];
+        }
+    }
+
+    if (ok) {
+        for(adj_iterator it = this->graphY.adjBegin(v);
+                it != this->graphY.adjEnd(v); ++it) {
+            idx_t w = *it;
+            if (this->coreY[w] != NO_VERTEX) {
+                ++mappedOutY;
+            } else {
+                --this->class_count[VF2PP_CLASS(this->labelY[w], 0,
+                        this->tinY[w], this->toutY[w])];
+            }
+        }
+        for(adj_iterator it = this->graphY.predBegin(v);
+                it != this->graphY.predEnd(v); ++it) {
+            idx_t w = *it;
+            if (this->coreY[w] != NO_VERTEX) {
+                ++mappedInY;
+            } else {
+                --this->class_count[VF2PP_CLASS(this->labelY[w], 1,
+                        this->tinY[w], this->toutY[w])];
+            }
+        }
+        ok = (mappedOutX == mappedOutY && mappedInX == mappedInY);
+    }
+
+    // sprawdzenie i wyzerowanie liczników klas
+    for(adj_iterator it = this->graphX.adjBegin(u);
+            it != this->graphX.adjEnd(u); ++it) {
+        idx_t w = *it;
+        if (this->coreX[w] == NO_VERTEX) {
+            int &c = this->class_count[VF2PP_CLASS(this->labelX[w], 0,
+                    this->tinX[w], this->toutX[w])];
+            ok = ok && (c == 0);
+            c = 0;
+        }
+    }
+    for(adj_iterator it = this->graphX.predBegin(u);
+            it != this->graphX.predEnd(u); ++it) {
+        idx_t w = *it;
+        if (this->coreX[w] == NO_VERTEX) {
+            int &c = this->class_count[VF2PP_CLASS(this->labelX[w], 1,
+                    this->tinX[w], this->toutX[w])];
+            ok = ok && (c == 0);
+            c = 0;
+        }
+    }
+    for(adj_iterator it = this->graphY.adjBegin(v);
+            it != this->graphY.adjEnd(v); ++it) {
+        idx_t w = *it;
+        if (this->coreY[w] == NO_VERTEX) {
+            this->class_count[VF2PP_CLASS(this->labelY[w], 0,
+                    this->tinY[w], this->toutY[w])] = 0;
+        }
+    }
+    for(adj_iterator it = this->graphY.predBegin(v);
+            it != this->graphY.predEnd(v); ++it) {
+        idx_t w = *it;
+        if (this->coreY[w] == NO_VERTEX) {
+            this->class_count[VF2PP_CLASS(this->labelY[w], 1,
+                    this->tinY[w], this->toutY[w])] = 0;
+        }
+    }
+#undef VF2PP_CLASS
+
+    return ok;
+}
+
+void Vf2ppAlgo::addPair(idx_t u, idx_t v)
+{
+    this->coreX[u] = v;
+    this->coreY[v] = u;
+
+    for(adj_iterator it = this->graphX.adjBegin(u); it != this->graphX.adjEnd(u); ++it) {
+        ++this->toutX[*it];
+    }
+    for(adj_iterator it = this->graphX.predBegin(u); it != this->graphX.predEnd(u); ++it) {
+        ++this->tinX[*it];
+    }
+    for(adj_iterator it = this->graphY.adjBegin(v); it != this->graphY.adjEnd(v); ++it) {
+        ++this->toutY[*it];
+    }
+    for(adj_iterator it = this->graphY.predBegin(v); it != this->graphY.predEnd(v); ++it) {
+        ++this->tinY[*it];
+    }
+}
+
+void Vf2ppAlgo::removePair(idx_t u)
+{
+    idx_t v = this->coreX[u];
+
+    this->coreX[u] = NO_VERTEX;
+    this->coreY[v] = NO_VERTEX;
+
+    for(adj_iterator it = this->graphX.adjBegin(u); it != this->graphX.adjEnd(u); ++it) {
+        --this->toutX[*it];
+    }
+    for(adj_iterator it = this->graphX.predBegin(u); it != this->graphX.predEnd(u); ++it) {
+        --this->tinX[*it];
+    }
+    for(adj_iterator it = this->graphY.adjBegin(v); it != this->graphY.adjEnd(v); ++it) {
+        --this->toutY[*it];
+    }
+    for(adj_iterator it = this->graphY.predBegin(v); it != this->graphY.predEnd(v); ++it) {
+        --this->tinY[*it];
+    }
+}
+
+bool Vf2ppAlgo::match()
+{
+    using std::vector;
+
+    unsigned int n = this->order.size();
+
+    vector<const idx_t *> cur(n);
+    vector<const idx_t *> end(n);
+
+    unsigned int d = 0;
+    this->candidates(this->order[0], cur[0], end[0]);
+
+    while (d < n) {
+        if (this->budget != NULL && this->budget->isExhausted()) {
+            return false;
+        }
+
+        idx_t u = this->order[d];
+
+        if (this->coreX[u] != NO_VERTEX) {
+            // powrót na ten poziom - cofamy poprzednie przyporządkowanie
+            SEARCH_STAT(this->stats.addBacktrack(d + 1));
+            this->removePair(u);
+        }
+
+        bool found = false;
+        while (cur[d] != end[d]) {
+            idx_t v = *(cur[d]++);
+            if (this->coreY[v] == NO_VERTEX && this->feasible(u, v)) {
+                this->addPair(u, v);
+                this->chargeNode();
+                found = true;
+                break;
+            }
+        }
+
+        if (found) {
+            ++d;
+            if (d < n) {
+                this->candidates(this->order[d], cur[d], end[d]);
+            }
+        } else if (d == 0) {
+            return false;
+        } else {
+            --d;
+        }
+    }
+    return true;
+}
+
+std::string Vf2ppAlgo::getInfo() const
+{
+    using std::endl;
+    using std::stringstream;
+
+    stringstream ss;
+    for(size_t i = 0; i < this->order.size(); ++i) {
+        idx_t x = this->order[i];
+        ss << i << " :: " << this->graphX.getLabel(x) << " [" <<
+            this->labelX[x] << "]";
+        if (x < this->coreX.size() && this->coreX[x] != NO_VERTEX) {
+            ss << " -->> " << this->graphY.getLabel(this->coreX[x]);
+        }
+        ss << endl;
+    }
+    ss << endl;
+    return ss.str();
+}
@@ -0,0 +1,306 @@
+/**
+ *      @file  vf2ppAlgo.hpp
+ *     @brief  plik nagłówkowy klasy Vf2ppAlgo
+ *
+ * Detailed description starts here.
+ *
+ * Deklaracja klasy Vf2ppAlgo - silnika weryfikacji izomorfizmu w stylu VF2++
+ *
+ *=====================================================================================
+ */
+
+#ifndef VF2PPALGO_HPP
+#define VF2PPALGO_HPP
+
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+
+#include "graph.hpp"
+#include "frozenGraph.hpp"
+#include "isomorphismAlgo.hpp"
+#include "colourRefinement.hpp"
+#include "searchLimits.hpp"
+
+/**
+ * @brief klasa reprezentuje algorytm VF2++ do weryfikacji izomorfizmu grafów
+ *
+ * Alternatywa dla \ref IsomorphismAlgo, przyjmująca te same grafy wejściowe
+ * i zwracająca to samo przekształcenie \ref IsomorphismAlgo::iso_map.
+ *
+ * Różnice względem algorytmu powrotów po krawędziach lasu DFS:
+ * * kolejność dopasowywania wierzchołków wyznaczana jest raz, przeszukiwaniem
+ *   wszerz od wierzchołka o najrzadszej etykiecie; w obrębie poziomu BFS
+ *   najpierw wierzchołki o największej liczbie połączeń z już uporządkowanymi,
+ *   potem o największym stopniu, potem o najrzadszej etykiecie,
+ * * kandydaci na obraz wierzchołka u to następniki (poprzedniki) obrazu
+ *   dopasowanego już poprzednika (następnika) u,
+ * * para (u, v) jest odrzucana gdy liczby niedopasowanych sąsiadów u i v
+ *   różnią się w którejkolwiek klasie: etykieta x kierunek krawędzi
+ *   x przynależność do zbiorów terminalnych T_in / T_out.
+ *
+ * Etykietą wierzchołka jest jego kolor stabilny wyznaczony przez
+ * \ref ColourRefinement::refineJoint, startując od 'stopni' (invariant)
+ * przypisanych w \ref Vf2ppAlgo::meetsRequirements.
+ * Przeszukiwanie jest iteracyjne, głębokość stosu to liczba wierzchołków.
+ */
+class Vf2ppAlgo
+{
+    public:
+        /**
+         * @brief konstruktor biorący referencje na dwa grafy
+         *
+         * @param _graphX graf X
+         * @param _graphY graf Y
+         */
+        Vf2ppAlgo(const Graph &_graphX, const Graph &_graphY);
+
+        /**
+         * @brief konstruktor biorący referencje na dwa zamrożone grafy
+         *
+         * Grafy nie są kopiowane, muszą istnieć przez cały czas życia
+         * obiektu.
+         *
+         * @param _graphX zamrożony graf X
+         * @param _graphY zamrożony graf Y
+         */
+        Vf2ppAlgo(const FrozenGraph &_graphX, const FrozenGraph &_graphY);
+
+        /**
+         * @brief sprawdź warunki podstawowe izomorfizmu grafów
+         *
+         * Takie same jak w \ref IsomorphismAlgo::meetsRequirements. Przy okazji
+         * przypisuje wierzchołkom obu grafów wspólne etykiety.
+         *
+         * @return czy grafy mają szansę być izomorficzne
+         */
+        bool meetsRequirements();
+
+        /**
+         * @brief funkcja weryfikująca izomorfizm grafów podanych w
+         * konstruktorze
+         *
+         * @return czy grafy są izomorficzne
+         */
+        bool isIsomorphism();
+
+        /**
+         * @brief funkcja weryfikująca izomorfizm z limitami przeszukiwania
+         *
+         * @param limits limity przeszukiwania
+         *
+         * @return \ref ISO_ISOMORPHIC, \ref ISO_NOT_ISOMORPHIC lub
+         * \ref ISO_UNKNOWN gdy przeszukiwanie przerwano
+         */
+        IsoResult isIsomorphism(const SearchLimits &limits);
+
+        /**
+         * @brief statystyki ostatniej weryfikacji (także przerwanej)
+         *
+         * @return referencja na statystyki
+         */
+        const SearchStats &getStats() const {return this->stats;};
+
+        /**
+         * @brief zwraca referencję na przekształcenie izomorficzne, otrzymane
+         * przy weryfikacji izomorfizmu.
+         *
+         * @return referencja na mapę znaczników grafu X na graf Y
+         */
+        const IsomorphismAlgo::iso_map &getIsoMap() const {return this->label_map;};
+
+        /**
+         * @brief informacje pomocnicze na temat obiektu klasy \ref Vf2ppAlgo
+         *
+         * @return string z informacjami pomocniczymi
+         */
+        std::string getInfo() const;
+
+    private:
+        /**
+         * @brief gęsty indeks wierzchołka zamrożonego grafu
+         */
+        typedef FrozenGraph::idx_t idx_t;
+
+        /**
+         * @brief zamrożona kopia grafu X, gdy obiekt stworzono z \ref Graph
+         */
+        const FrozenGraph frozenX;
+
+        /**
+         * @brief zamrożona kopia grafu Y, gdy obiekt stworzono z \ref Graph
+         */
+        const FrozenGraph frozenY;
+
+        /**
+         * @brief graf X (wzorzec)
+         */
+        const FrozenGraph &graphX;
+
+        /**
+         * @brief graf Y
+         */
+        const FrozenGraph &graphY;
+
+        /**
+         * @brief liczba różnych etykiet w obu grafach
+         */
+        unsigned int label_count;
+
+        /**
+         * @brief etykiety wierzchołków grafu X (0..label_count-1)
+         */
+        std::vector<unsigned int> labelX;
+
+        /**
+         * @brief etykiety wierzchołków grafu Y (0..label_count-1)
+         */
+        std::vector<unsigned int> labelY;
+
+        /**
+         * @brief kolejność dopasowywania wierzchołków grafu X
+         */
+        std::vector<idx_t> order;
+
+        /**
+         * @brief przekształcenie X -> Y (\ref NO_VERTEX gdy brak)
+         */
+        std::vector<idx_t> coreX;
+
+        /**
+         * @brief przekształcenie odwrotne Y -> X (\ref NO_VERTEX gdy brak)
+         */
+        std::vector<idx_t> coreY;
+
+        /**
+         * @brief dla wierzchołków X liczba dopasowanych poprzedników
+         * (wierzchołek należy do T_out gdy > 0)
+         */
+        std::vector<unsigned int> toutX;
+
+        /**
+         * @brief dla wierzchołków X liczba dopasowanych następników
+         * (wierzchołek należy do T_in gdy > 0)
+         */
+        std::vector<unsigned int> tinX;
+
+        /**
+         * \copydoc Vf2ppAlgo::toutX
+         */
+        std::vector<unsigned int> toutY;
+
+        /**
+         * \copydoc Vf2ppAlgo::tinX
+         */
+        std::vector<unsigned int> tinY;
+
+        /**
+         * @brief liczniki klas sąsiadów używane w regule wyprzedzającej,
+         * zerowe pomiędzy wywołaniami \ref Vf2ppAlgo::feasible
+         */
+        std::vector<int> class_count;
+
+        /**
+         * @brief wszystkie wierzchołki grafu Y - kandydaci dla wierzchołka
+         * bez dopasowanych sąsiadów
+         */
+        std::vector<idx_t> all_y;
+
+        /**
+         * @brief przekształcenie izomorficzne w znacznikach
+         */
+        IsomorphismAlgo::iso_map label_map;
+
+        /**
+         * @brief budżet przeszukiwania (NULL gdy brak limitów)
+         */
+        SearchBudget *budget;
+
+        /**
+         * @brief węzły nie przekazane jeszcze do \ref Vf2ppAlgo::budget
+         */
+        unsigned int pending_nodes;
+
+        /**
+         * @brief statystyki przeszukiwania
+         */
+        SearchStats stats;
+
+        /**
+         * @brief przypisz obu grafom wspólne etykiety 0..label_count-1
+         *
+         * @return czy histogramy etykiet obu grafów są równe
+         */
+        bool assignLabels();
+
+        /**
+         * @brief wyznacz kolejność dopasowywania \ref Vf2ppAlgo::order
+         */
+        void computeOrder();
+
+        /**
+         * @brief wyznacz przedział kandydatów dla wierzchołka u
+         *
+         * @param u wierzchołek grafu X
+         * @param begin początek przedziału
+         * @param end koniec przedziału
+         */
+        void candidates(idx_t u, const idx_t *&begin, const idx_t *&end) const;
+
+        /**
+         * @brief sprawdź czy parę (u, v) można dodać do dopasowania
+         *
+         * @param u wierzchołek grafu X
+         * @param v wierzchołek grafu Y
+         *
+         * @return czy para jest dopuszczalna
+         */
+        bool feasible(idx_t u, idx_t v);
+
+        /**
+         * @brief dodaj parę (u, v) do dopasowania
+         *
+         * @param u wierzchołek grafu X
+         * @param v wierzchołek grafu Y
+         */
+        void addPair(idx_t u, idx_t v);
+
+        /**
+         * @brief usuń parę (u, coreX[u]) z dopasowania
+         *
+         * @param u wierzchołek grafu X
+         */
+        void removePair(idx_t u);
+
+        /**
+         * @brief właściwe przeszukiwanie z powrotami
+         *
+         * @return czy znaleziono izomorfizm
+         */
+        bool match();
+
+        /**
+         * @brief właściwa weryfikacja, przy ustawionym
+         * \ref Vf2ppAlgo::budget
+         *
+         * @return wynik weryfikacji
+         */
+        IsoResult solve();
+
+        /**
+         * @brief policz węzeł przeszukiwania i co
+         * \ref SearchBudget::getCheckInterval węzłów rozlicz budżet
+         */
+        void chargeNode()
+        {
+            ++this->stats.nodes;
+            if (this->budget != NULL &&
+                    ++this->pending_nodes >= this->budget->getCheckInterval()) {
+                this->budget->consume(this->pending_nodes);
+                this->pending_nodes = 0;
+            }
+        };
+};
+
+#endif /* end of include guard: VF2PPALGO_HPP */